@@ -0,0 +1,98 @@
+/**
+ * @file arena_bench.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <memory>
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/arena_defaults.h"
+#include "src/trace.h"
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief Fold the bytes of a simulation scalar into an FNV-1a hash. In fixed
+ * mode that is the raw integer, so equal checksums mean bit-identical state.
+ */
+static uint64_t HashReal(uint64_t h, csci3081::real_t v) {
+  unsigned char bytes[sizeof(v)];
+  memcpy(bytes, &v, sizeof(v));
+  for (size_t i = 0; i < sizeof(v); ++i) {
+    h = (h ^ bytes[i]) * 1099511628211ULL;
+  } /* for(i..) */
+  return h;
+} /* HashReal() */
+
+static uint64_t HashArena(uint64_t h, csci3081::Arena * arena) {
+  const csci3081::Robot * robot = arena->robot();
+  const csci3081::HomeBase * home = arena->home_base();
+  h = HashReal(h, robot->get_pos().x);
+  h = HashReal(h, robot->get_pos().y);
+  h = HashReal(h, robot->get_direction().x);
+  h = HashReal(h, robot->get_direction().y);
+  h = HashReal(h, robot->get_battery_level());
+  h = HashReal(h, home->get_pos().x);
+  h = HashReal(h, home->get_pos().y);
+  return h;
+} /* HashArena() */
+
+/**
+ * @brief Step a seeded arena and report the cost per step together with a
+ * checksum of the entity state after every step. Built once per numeric mode
+ * (see bench/Makefile), so the two lines can be compared directly; the fixed
+ * point checksum is the one that must match across machines.
+ */
+int main(int argc, char **argv) {
+  unsigned long n_steps = 100000;
+  unsigned seed = 1;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc) {
+      n_steps = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      seed = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+    } else {
+      fprintf(stderr, "Usage: %s [--steps N] [--seed N]\n", argv[0]);
+      return 1;
+    }
+  } /* for(i..) */
+  // The arena narrates every step on stdout; only the report matters here.
+  if (!freopen("/dev/null", "w", stdout)) {
+    fprintf(stderr, "Unable to silence stdout\n");
+  }
+
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  aparams.home_base.seed = seed;
+  std::unique_ptr<csci3081::Arena> arena(new csci3081::Arena(&aparams));
+
+  uint64_t checksum = 14695981039346656037ULL;
+  uint64_t begin_ns = csci3081::Tracer::NowNs();
+  for (unsigned long step = 0; step < n_steps; ++step) {
+    if (arena->getGameStatus()) {
+      arena.reset(new csci3081::Arena(&aparams));
+    }
+    arena->AdvanceTime();
+    checksum = HashArena(checksum, arena.get());
+  } /* for(step..) */
+  uint64_t elapsed_ns = csci3081::Tracer::NowNs() - begin_ns;
+
+#ifdef ARENA_FIXED_POINT
+  const char * mode = "fixed";
+#else
+  const char * mode = "float";
+#endif
+  fprintf(stderr, "%-6s %lu steps %10.1f ns/step checksum %016llx\n", mode,
+          n_steps, n_steps ? static_cast<double>(elapsed_ns) / n_steps : 0.0,
+          static_cast<unsigned long long>(checksum));
+  return 0;
+}
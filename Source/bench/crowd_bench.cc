@@ -0,0 +1,109 @@
+/**
+ * @file crowd_bench.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cmath>
+#include <random>
+#include "src/arena.h"
+#include "src/arena_defaults.h"
+#include "src/arena_params.h"
+#include "src/trace.h"
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief Step an arena crowded with robots driving in random directions, with
+ * and then without avoidance, and report the cost per step and how many
+ * robots collided per step in each case.
+ */
+static void Run(unsigned long n_robots, unsigned long n_steps, unsigned seed,
+                bool avoid) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  aparams.obstacles.clear();
+  // One robot per 80x80 square, put down anywhere in its square
+  unsigned side = static_cast<unsigned>(std::ceil(std::sqrt(n_robots)));
+  aparams.x_dim = aparams.y_dim = side * 80 + 160;
+  std::minstd_rand0 generator(seed);
+  std::uniform_real_distribution<double> unit(0, 1);
+  for (unsigned long i = 0; i < n_robots; ++i) {
+    csci3081::robot_params r = aparams.robot;
+    r.pos = Position(160 + (i % side) * 80 + unit(generator) * 30,
+                     160 + (i / side) * 80 + unit(generator) * 30);
+    aparams.extra_robots.push_back(r);
+  } /* for(i..) */
+  // The game pieces out of the way, in opposite corners
+  aparams.robot.pos = Position(40, 40);
+  aparams.recharge_station.pos = Position(120, 40);
+  aparams.home_base.pos = Position(aparams.x_dim - 40, aparams.y_dim - 40);
+  aparams.home_base.seed = seed;
+  csci3081::Arena arena(&aparams);
+
+  const std::vector<csci3081::entity_id>& robots =
+      arena.registry().of_kind(csci3081::KIND_ROBOT);
+  for (size_t i = 1; i < robots.size(); ++i) {
+    csci3081::Robot robot(&arena.registry(), robots[i]);
+    robot.set_heading_angle(unit(generator) * 360);
+    robot.set_speed(5);
+    if (avoid) {
+      arena.EnableAvoidance(robots[i]);
+    }
+  } /* for(i..) */
+
+  unsigned long hits = 0;
+  arena.event_bus().collisions().Subscribe(
+      [&hits](const csci3081::collision_record * e, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+          if (e[i].event.collided() && !e[i].event.collided_with_wall()) {
+            ++hits;
+          }
+        } /* for(i..) */
+      });
+  uint64_t begin_ns = csci3081::Tracer::NowNs();
+  unsigned long step = 0;
+  for (; step < n_steps && !arena.getGameStatus(); ++step) {
+    arena.AdvanceTime();
+  } /* for(step..) */
+  uint64_t elapsed_ns = csci3081::Tracer::NowNs() - begin_ns;
+
+  double steps = step ? static_cast<double>(step) : 1.0;
+  fprintf(stderr, "%-8s %lu robots %lu steps %10.2f ms/step %10.1f "
+          "collisions/step\n", avoid ? "avoid" : "no-avoid", n_robots, step,
+          elapsed_ns / steps / 1e6, hits / steps);
+} /* Run() */
+
+int main(int argc, char **argv) {
+  unsigned long n_robots = 10000;
+  unsigned long n_steps = 200;
+  unsigned seed = 1;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--robots") == 0 && i + 1 < argc) {
+      n_robots = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc) {
+      n_steps = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      seed = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+    } else {
+      fprintf(stderr, "Usage: %s [--robots N] [--steps N] [--seed N]\n",
+              argv[0]);
+      return 1;
+    }
+  } /* for(i..) */
+  // The arena narrates every step on stdout; only the report matters here.
+  if (!freopen("/dev/null", "w", stdout)) {
+    fprintf(stderr, "Unable to silence stdout\n");
+  }
+  Run(n_robots, n_steps, seed, true);
+  Run(n_robots, n_steps, seed, false);
+  return 0;
+}
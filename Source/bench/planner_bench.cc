@@ -0,0 +1,172 @@
+/**
+ * @file planner_bench.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "src/arena_generator.h"
+#include "src/arena_params.h"
+#include "src/incremental_planner.h"
+#include "src/trace.h"
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief Chase a wandering target across a generated arena, planning every
+ * step both by repairing the last search and from scratch, and report what
+ * each costs. The two must find paths of the same length; any step where
+ * they do not is counted as a mismatch.
+ *
+ * The target moves like the HomeBase, at twice the hunter's speed, turning at
+ * random. Every 20 steps one obstacle is moved, which both planners are told
+ * about. A hunter that catches the target or loses it is put down elsewhere.
+ */
+int main(int argc, char **argv) {
+  unsigned long n_steps = 2000;
+  size_t n_obstacles = 2000;
+  unsigned seed = 1;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc) {
+      n_steps = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--obstacles") == 0 && i + 1 < argc) {
+      n_obstacles = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      seed = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+    } else {
+      fprintf(stderr, "Usage: %s [--steps N] [--obstacles N] [--seed N]\n",
+              argv[0]);
+      return 1;
+    }
+  } /* for(i..) */
+
+  csci3081::arena_generator_params gparams;
+  gparams.n_obstacles = n_obstacles;
+  gparams.seed = seed;
+  csci3081::arena_params aparams;
+  size_t placed = 0;
+  std::string error;
+  if (!csci3081::GenerateArenaParams(&gparams, &aparams, &placed, &error)) {
+    fprintf(stderr, "%s\n", error.c_str());
+    return 1;
+  }
+  csci3081::circle_batch obstacles;
+  for (const csci3081::arena_entity_params& o : aparams.obstacles) {
+    obstacles.Push(csci3081::RealToDouble(o.pos.x),
+                   csci3081::RealToDouble(o.pos.y), o.radius);
+  } /* for(o..) */
+  // As the Arena plans for its robot
+  csci3081::incremental_planner_params pparams;
+  pparams.clearance = aparams.robot.radius + aparams.robot.collision_delta + 1;
+  csci3081::IncrementalPlanner incremental(aparams.x_dim, aparams.y_dim,
+                                           obstacles, pparams);
+  csci3081::IncrementalPlanner full(aparams.x_dim, aparams.y_dim, obstacles,
+                                    pparams);
+
+  std::minstd_rand0 generator(seed);
+  std::uniform_real_distribution<double> unit(0, 1);
+  auto free_spot = [&](double * x, double * y) {
+    do {
+      *x = unit(generator) * aparams.x_dim;
+      *y = unit(generator) * aparams.y_dim;
+    } while (incremental.Blocked(*x, *y));
+  };
+  double hx = csci3081::RealToDouble(aparams.robot.pos.x);
+  double hy = csci3081::RealToDouble(aparams.robot.pos.y);
+  double tx = csci3081::RealToDouble(aparams.home_base.pos.x);
+  double ty = csci3081::RealToDouble(aparams.home_base.pos.y);
+  double heading = 0;
+  const double hunter_speed = 5;
+  const double target_speed = 10;
+
+  std::vector<Position> path;
+  std::vector<Position> full_path;
+  uint64_t incremental_ns = 0;
+  uint64_t full_ns = 0;
+  unsigned long mismatches = 0;
+  unsigned long restarts = 0;
+  for (unsigned long step = 0; step < n_steps; ++step) {
+    if (step % 20 == 19 && obstacles.size()) {
+      size_t i = generator() % obstacles.size();
+      incremental.RemoveObstacle(obstacles.x[i], obstacles.y[i],
+                                 obstacles.r[i]);
+      full.RemoveObstacle(obstacles.x[i], obstacles.y[i], obstacles.r[i]);
+      obstacles.x[i] = unit(generator) * aparams.x_dim;
+      obstacles.y[i] = unit(generator) * aparams.y_dim;
+      incremental.AddObstacle(obstacles.x[i], obstacles.y[i], obstacles.r[i]);
+      full.AddObstacle(obstacles.x[i], obstacles.y[i], obstacles.r[i]);
+    }
+
+    // The target wanders, turning back from walls and obstacles
+    if (generator() % 5 == 0) {
+      heading = unit(generator) * 2 * M_PI;
+    }
+    for (int tries = 0; tries < 8; ++tries) {
+      double nx = tx + target_speed * std::cos(heading);
+      double ny = ty + target_speed * std::sin(heading);
+      if (nx > 0 && nx < aparams.x_dim && ny > 0 && ny < aparams.y_dim &&
+          !incremental.Blocked(nx, ny)) {
+        tx = nx;
+        ty = ny;
+        break;
+      }
+      heading = unit(generator) * 2 * M_PI;
+    } /* for(tries..) */
+
+    Position start(hx, hy);
+    Position goal(tx, ty);
+    uint64_t t0 = csci3081::Tracer::NowNs();
+    bool found = incremental.FindPath(start, goal, &path);
+    uint64_t t1 = csci3081::Tracer::NowNs();
+    full.Reset();
+    bool full_found = full.FindPath(start, goal, &full_path);
+    uint64_t t2 = csci3081::Tracer::NowNs();
+    incremental_ns += t1 - t0;
+    full_ns += t2 - t1;
+    if (found != full_found ||
+        (found && std::fabs(incremental.path_cost() - full.path_cost()) >
+         1e-6)) {
+      ++mismatches;
+    }
+
+    // The hunter follows the path for a step's travel
+    double travel = hunter_speed;
+    for (size_t i = 0; found && i < path.size() && travel > 0; ++i) {
+      double dx = csci3081::RealToDouble(path[i].x) - hx;
+      double dy = csci3081::RealToDouble(path[i].y) - hy;
+      double d = std::hypot(dx, dy);
+      double m = std::min(d, travel);
+      if (d > 0) {
+        hx += dx / d * m;
+        hy += dy / d * m;
+      }
+      travel -= m;
+    } /* for(i..) */
+    if (!found || std::hypot(tx - hx, ty - hy) < 2 * aparams.robot.radius) {
+      free_spot(&hx, &hy);
+      ++restarts;
+    }
+  } /* for(step..) */
+
+  double steps = n_steps ? static_cast<double>(n_steps) : 1.0;
+  fprintf(stderr, "%ux%u arena, %zu obstacles, %lu steps, %lu restarts\n",
+          aparams.x_dim, aparams.y_dim, obstacles.size(), n_steps, restarts);
+  fprintf(stderr, "incremental %10.1f us/step %10.1f expansions/step\n",
+          incremental_ns / steps / 1000, incremental.expansions() / steps);
+  fprintf(stderr, "full        %10.1f us/step %10.1f expansions/step\n",
+          full_ns / steps / 1000, full.expansions() / steps);
+  fprintf(stderr, "speedup     %10.1fx, %lu mismatched paths\n",
+          incremental_ns ? static_cast<double>(full_ns) / incremental_ns : 0.0,
+          mismatches);
+  return mismatches ? 1 : 0;
+}
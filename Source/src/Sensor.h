@@ -40,13 +40,14 @@ NAMESPACE_BEGIN(csci3081);
 class Sensor {
  public:
     Sensor(): activated_(false) {}
+    virtual ~Sensor(void) {}
 
     bool activated(void) { return activated_; }
     void activated(bool value) { activated_ = value; }
     /** @brief Accepts an EventCollision object and does something
     * depending on the activated() status of the EventCollision object.
     */
-    virtual void Accept(EventCollision * e) = 0;
+    virtual void Accept(const EventCollision * e) = 0;
 
     /**
     * @brief Reset the sensor to a newly constructed state.
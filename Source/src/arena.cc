@@ -11,6 +11,7 @@
 
 #include <math.h>
 #include <algorithm>
+#include <limits>
 
 #include "src/robot.h"
 #include "src/obstacle.h"
@@ -20,12 +21,23 @@
 #include "src/home_base.h"
 #include "src/event_recharge.h"
 #include "src/common.h"
+#include "src/trace.h"
 
 /*******************************************************************************
  * Namespaces
  ******************************************************************************/
 NAMESPACE_BEGIN(csci3081);
 
+/*******************************************************************************
+ * Constant Definitions
+ ******************************************************************************/
+// Steps an autopilot follows a plan before making a new one
+static const unsigned kAutopilotReplanSteps = 10;
+// Side of the cells of the grid over every transform
+static const double kBodyCellSize = 64;
+// Above this many transforms, collisions are found through the grid
+static const size_t kGridCollisionBodies = 64;
+
 /*******************************************************************************
  * Constructors/Destructor
  ******************************************************************************/
@@ -33,104 +45,493 @@ NAMESPACE_BEGIN(csci3081);
  * @brief Constructor that initializes entities in the arena.
  *
  * Initializes the dimensions of the arena, the robot, the home base,
- * the recharge station, and five obstacles.
+ * the recharge station, and the obstacles.
  *
  * @param params const pointer to a const struct arena_params object.
  */
 Arena::Arena(const struct arena_params* const params) :
   x_dim_(params->x_dim), y_dim_(params->y_dim),
-  robot_(new Robot(&params->robot)),
-  n_robots_(1),
-  n_obstacles_(params->n_obstacles),
-  recharge_station_(new RechargeStation(params->recharge_station.radius,
+  registry_(params->obstacles.size() + params->extra_robots.size() +
+            params->extra_recharge_stations.size() + 3),
+  robot_(&registry_, &params->robot),
+  home_base_(&registry_, &params->home_base),
+  recharge_station_(&registry_, params->recharge_station.radius,
     params->recharge_station.pos,
-    params->recharge_station.color)),
-  home_base_(new HomeBase(&params->home_base)),
-  entities_(),
-  mobile_entities_() {
-  robot_->heading_angle(0);
-  entities_.push_back(robot_);
-  entities_.push_back(home_base_);
-  mobile_entities_.push_back(robot_);
-  mobile_entities_.push_back(home_base_);
-  entities_.push_back(recharge_station_);
-
-  for (size_t i = 0; i < n_obstacles_; ++i) {
-     entities_.push_back(new Obstacle(
-         params->obstacles[i].radius,
+    params->recharge_station.color),
+  events_(),
+  motion_behavior_(),
+  scratch_(),
+  static_map_(params->static_map),
+  lidar_targets_(),
+  distance_field_(),
+  shared_planner_(params->planner),
+  own_planner_(),
+  own_planner_stale_(true),
+  path_query_(),
+  shared_flow_field_(params->flow_field),
+  flow_fields_(),
+  body_shapes_(),
+  body_grid_(),
+  moving_bodies_(),
+  bodies_indexed_(false),
+  bodies_binned_(false),
+  query_order_(),
+  query_distances_(),
+  collision_candidates_(),
+  avoidance_params_(),
+  avoidance_bodies_(),
+  avoidance_agents_(),
+  avoidance_solver_() {
+  robot_.set_heading_angle(0);
+
+  for (size_t i = 0; i < params->obstacles.size(); ++i) {
+     SpawnObstacle(params->obstacles[i].radius,
          params->obstacles[i].pos,
-         params->obstacles[i].color));
+         params->obstacles[i].color);
        } /* for(i..) */
+  for (const arena_entity_params& station : params->extra_recharge_stations) {
+    SpawnRechargeStation(station.radius, station.pos, station.color);
+  } /* for(station..) */
+  for (const robot_params& robot : params->extra_robots) {
+    SpawnRobot(&robot);
+  } /* for(robot..) */
+
+  // One collision event per mobile entity is queued every step.
+  events_.collisions().Reserve(registry_.kinematics_pool().size());
+  events_.commands().Subscribe([this](const command_record * e, size_t n) {
+      DeliverCommands(e, n); });
+  events_.recharges().Subscribe([this](const recharge_record * e, size_t n) {
+      DeliverRecharges(e, n); });
+  events_.collisions().Subscribe([this](const collision_record * e,
+                                        size_t n) {
+      DeliverCollisions(e, n); });
+  events_.game_overs().Subscribe([this](const game_over_record * e,
+                                        size_t n) {
+      DeliverGameOvers(e, n); });
+
+  // Console log of what happened, as the events used to print themselves.
+  events_.recharges().Subscribe([](const recharge_record * e, size_t n) {
+      for (size_t i = 0; i < n; ++i) {
+        e[i].event.EmitMessage();
+      }
+    });
+  events_.collisions().Subscribe([](const collision_record * e, size_t n) {
+      for (size_t i = 0; i < n; ++i) {
+        if (e[i].event.collided() && !e[i].event.collided_with_wall()) {
+          e[i].event.EmitMessage();
+        }
+      }
+    });
 }
 
  /**
- * @brief Destructor that frees memory consumed by entities
- * in the arena.
+ * @brief Destructor. The entities are owned by the registry.
  */
 Arena::~Arena(void) {
-  for (auto ent : entities_) {
-    delete ent;
-  } /* for(ent..) */
 }
 /*******************************************************************************
  * Member Functions
  ******************************************************************************/
+entity_handle Arena::SpawnObstacle(real_t radius, const Position& pos,
+                                  const Color& color) {
+  Obstacle o(&registry_, radius, pos, color);
+  bodies_indexed_ = false;
+  bodies_binned_ = false;
+  if (distance_field_) {
+    distance_field_->AddCircle(RealToDouble(pos.x), RealToDouble(pos.y),
+                               RealToDouble(radius));
+  }
+  own_planner_stale_ = true;
+  flow_fields_[AUTOPILOT_HOME_BASE].reset();
+  flow_fields_[AUTOPILOT_RECHARGE_STATION].reset();
+  ComponentPool<autopilot>& pilots = registry_.autopilot_pool();
+  for (size_t i = 0; i < pilots.size(); ++i) {
+    if (pilots.data()[i].tracker) {
+      pilots.data()[i].tracker->AddObstacle(RealToDouble(pos.x),
+                                            RealToDouble(pos.y),
+                                            RealToDouble(radius));
+    }
+  } /* for(i..) */
+  return registry_.handle(o.id());
+} /* SpawnObstacle() */
+
+entity_handle Arena::SpawnRechargeStation(real_t radius, const Position& pos,
+                                         const Color& color) {
+  RechargeStation station(&registry_, radius, pos, color);
+  bodies_indexed_ = false;
+  bodies_binned_ = false;
+  return registry_.handle(station.id());
+} /* SpawnRechargeStation() */
+
+entity_handle Arena::SpawnRobot(const struct robot_params * params) {
+  Robot r(&registry_, params);
+  bodies_indexed_ = false;
+  bodies_binned_ = false;
+  return registry_.handle(r.id());
+} /* SpawnRobot() */
+
+bool Arena::Despawn(const entity_handle& h) {
+  if (!registry_.Valid(h) || h.index == robot_.id() ||
+      h.index == home_base_.id() || h.index == recharge_station_.id()) {
+    return false;
+  }
+  if (registry_.kind(h.index) == KIND_OBSTACLE) {
+    const transform& t = registry_.transform_pool().Get(h.index);
+    if (distance_field_) {
+      distance_field_->RemoveCircle(RealToDouble(t.pos.x),
+                                    RealToDouble(t.pos.y),
+                                    RealToDouble(t.radius));
+    }
+    own_planner_stale_ = true;
+    flow_fields_[AUTOPILOT_HOME_BASE].reset();
+    flow_fields_[AUTOPILOT_RECHARGE_STATION].reset();
+    ComponentPool<autopilot>& pilots = registry_.autopilot_pool();
+    for (size_t i = 0; i < pilots.size(); ++i) {
+      if (pilots.data()[i].tracker) {
+        pilots.data()[i].tracker->RemoveObstacle(RealToDouble(t.pos.x),
+                                                 RealToDouble(t.pos.y),
+                                                 RealToDouble(t.radius));
+      }
+    } /* for(i..) */
+  }
+  bodies_indexed_ = false;
+  bodies_binned_ = false;
+  return registry_.Destroy(h.index);
+} /* Despawn() */
+
+void Arena::EnableDistanceField(double cell_size, double max_distance) {
+  distance_field_.reset(new DistanceField(
+      static_cast<uint>(RealToDouble(x_dim_)),
+      static_cast<uint>(RealToDouble(y_dim_)), cell_size, max_distance));
+  circle_batch circles;
+  GatherObstacles(&circles);
+  for (size_t i = 0; i < circles.size(); ++i) {
+    distance_field_->AddCircle(circles.x[i], circles.y[i], circles.r[i]);
+  } /* for(i..) */
+  distance_field_->Build();
+} /* EnableDistanceField() */
+
+void Arena::GatherObstacles(circle_batch * out) const {
+  out->Clear();
+  for (entity_id e : obstacles()) {
+    const transform& t = registry_.transform_pool().Get(e);
+    out->Push(RealToDouble(t.pos.x), RealToDouble(t.pos.y),
+              RealToDouble(t.radius));
+  } /* for(e..) */
+  if (static_map_) {
+    static_map_->ForEachInBox(0, 0, static_map_->x_dim(),
+                              static_map_->y_dim(),
+                              [out](const static_obstacle& o) {
+        out->Push(o.x, o.y, o.radius); });
+  }
+} /* GatherObstacles() */
+
+void Arena::EnableAutopilot(entity_id robot, enum autopilot_goal goal,
+                            enum autopilot_mode mode) {
+  DisableAutopilot(robot);
+  std::shared_ptr<IncrementalPlanner> tracker;
+  if (mode == AUTOPILOT_TRACK) {
+    // Same clearance as the shared planner's
+    incremental_planner_params pparams;
+    pparams.clearance = RealToDouble(robot_.get_radius() +
+                                     robot_.get_collision_delta()) + 1;
+    circle_batch circles;
+    GatherObstacles(&circles);
+    tracker.reset(new IncrementalPlanner(
+        static_cast<uint>(RealToDouble(x_dim_)),
+        static_cast<uint>(RealToDouble(y_dim_)), circles, pparams));
+  }
+  registry_.autopilot_pool().Add(robot,
+                                 autopilot {goal, mode, {}, 0, 0, tracker});
+} /* EnableAutopilot() */
+
+void Arena::DisableAutopilot(entity_id robot) {
+  registry_.autopilot_pool().Remove(robot);
+} /* DisableAutopilot() */
+
+void Arena::EnableAvoidance(entity_id e) {
+  if (!registry_.avoidance_pool().Has(e)) {
+    const RobotMotionHandler& motion =
+        registry_.kinematics_pool().Get(e).motion;
+    registry_.avoidance_pool().Add(
+        e, avoidance {motion.direction() * motion.speed()});
+  }
+} /* EnableAvoidance() */
+
+void Arena::DisableAvoidance(entity_id e) {
+  registry_.avoidance_pool().Remove(e);
+} /* DisableAvoidance() */
+
+void Arena::EnableLidar(entity_id e, const SensorLidar& sensor) {
+  DisableLidar(e);
+  registry_.lidar_pool().Add(e, sensor);
+} /* EnableLidar() */
+
+void Arena::DisableLidar(entity_id e) {
+  registry_.lidar_pool().Remove(e);
+} /* DisableLidar() */
+
+void Arena::IndexBodies(void) const {
+  const ComponentPool<transform>& bodies = registry_.transform_pool();
+  if (bodies_binned_) {
+    for (uint32_t i : moving_bodies_) {
+      const transform& t = bodies.data()[i];
+      body_shapes_.x[i] = RealToDouble(t.pos.x);
+      body_shapes_.y[i] = RealToDouble(t.pos.y);
+    } /* for(i..) */
+    body_grid_.Rebin(body_shapes_);
+    bodies_indexed_ = true;
+    return;
+  }
+  const ComponentPool<kinematics>& movers = registry_.kinematics_pool();
+  const entity_id * ids = bodies.owners();
+  body_shapes_.Clear();
+  moving_bodies_.clear();
+  for (size_t i = 0; i < bodies.size(); ++i) {
+    const transform& t = bodies.data()[i];
+    body_shapes_.Push(RealToDouble(t.pos.x), RealToDouble(t.pos.y),
+                      RealToDouble(t.radius));
+    if (movers.Has(ids[i])) {
+      moving_bodies_.push_back(static_cast<uint32_t>(i));
+    }
+  } /* for(i..) */
+  body_grid_.Build(body_shapes_, RealToDouble(x_dim_), RealToDouble(y_dim_),
+                   kBodyCellSize, &moving_bodies_);
+  bodies_indexed_ = bodies_binned_ = true;
+} /* IndexBodies() */
+
+size_t Arena::NearestBodies(double x, double y, size_t k, uint32_t kinds,
+                            entity_id skip, entity_id * out,
+                            double * distances) const {
+  const entity_id * ids = registry_.transform_pool().owners();
+  if (!distances) {
+    query_distances_.resize(k);
+    distances = query_distances_.data();
+  }
+  // Found as pool indices, then turned into ids in place
+  size_t n = body_grid_.NearestWhere(
+      x, y, std::numeric_limits<double>::infinity(), k, out, distances,
+      [&](uint32_t i) {
+        return ids[i] != skip && (kinds & KindBit(registry_.kind(ids[i])));
+      });
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = ids[out[i]];
+  } /* for(i..) */
+  return n;
+} /* NearestBodies() */
+
+size_t Arena::BodiesInRadius(double x, double y, double radius,
+                             uint32_t kinds, entity_id * out,
+                             size_t capacity) const {
+  const entity_id * ids = registry_.transform_pool().owners();
+  size_t found = 0;
+  body_grid_.ForEachInBox(x - radius, y - radius, x + radius, y + radius,
+                          [&](uint32_t i) {
+      double dx = body_shapes_.x[i] - x;
+      double dy = body_shapes_.y[i] - y;
+      double reach = radius + body_shapes_.r[i];
+      if (dx * dx + dy * dy <= reach * reach &&
+          (kinds & KindBit(registry_.kind(ids[i])))) {
+        if (found < capacity) {
+          out[found] = ids[i];
+        }
+        ++found;
+      }
+    });
+  return found;
+} /* BodiesInRadius() */
+
+void Arena::OrderByCell(const Position * points, size_t n) const {
+  // Cell in the high half, so sorting groups the points by cell
+  query_order_.resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    query_order_[i] = static_cast<uint64_t>(body_grid_.CellOf(
+        RealToDouble(points[i].x), RealToDouble(points[i].y))) << 32 | i;
+  } /* for(i..) */
+  std::sort(query_order_.begin(), query_order_.end());
+} /* OrderByCell() */
+
+size_t Arena::QueryNearest(const Position& pos, size_t k, uint32_t kinds,
+                           entity_id * out, double * distances,
+                           entity_id skip) const {
+  EnsureBodiesIndexed();
+  return NearestBodies(RealToDouble(pos.x), RealToDouble(pos.y), k, kinds,
+                       skip, out, distances);
+} /* QueryNearest() */
+
+size_t Arena::QueryRadius(const Position& center, double radius,
+                          uint32_t kinds, entity_id * out,
+                          size_t capacity) const {
+  EnsureBodiesIndexed();
+  return BodiesInRadius(RealToDouble(center.x), RealToDouble(center.y),
+                        radius, kinds, out, capacity);
+} /* QueryRadius() */
+
+size_t Arena::QueryBox(double x0, double y0, double x1, double y1,
+                       uint32_t kinds, entity_id * out,
+                       size_t capacity) const {
+  EnsureBodiesIndexed();
+  const entity_id * ids = registry_.transform_pool().owners();
+  size_t found = 0;
+  body_grid_.ForEachInBox(x0, y0, x1, y1, [&](uint32_t i) {
+      // From the nearest point of the box
+      double dx = body_shapes_.x[i] - std::min(std::max(body_shapes_.x[i], x0),
+                                               x1);
+      double dy = body_shapes_.y[i] - std::min(std::max(body_shapes_.y[i], y0),
+                                               y1);
+      double r = body_shapes_.r[i];
+      if (dx * dx + dy * dy <= r * r &&
+          (kinds & KindBit(registry_.kind(ids[i])))) {
+        if (found < capacity) {
+          out[found] = ids[i];
+        }
+        ++found;
+      }
+    });
+  return found;
+} /* QueryBox() */
+
+void Arena::QueryNearestBatch(const Position * points, size_t n, size_t k,
+                              uint32_t kinds, const entity_id * skip,
+                              entity_id * out, size_t * counts) const {
+  EnsureBodiesIndexed();
+  OrderByCell(points, n);
+  for (uint64_t key : query_order_) {
+    size_t i = static_cast<uint32_t>(key);
+    counts[i] = NearestBodies(RealToDouble(points[i].x),
+                              RealToDouble(points[i].y), k, kinds,
+                              skip ? skip[i] : kNoEntity, out + i * k,
+                              nullptr);
+  } /* for(key..) */
+} /* QueryNearestBatch() */
+
+void Arena::QueryRadiusBatch(const Position * centers, size_t n,
+                             double radius, uint32_t kinds, entity_id * out,
+                             size_t capacity, size_t * counts) const {
+  EnsureBodiesIndexed();
+  OrderByCell(centers, n);
+  for (uint64_t key : query_order_) {
+    size_t i = static_cast<uint32_t>(key);
+    counts[i] = BodiesInRadius(RealToDouble(centers[i].x),
+                               RealToDouble(centers[i].y), radius, kinds,
+                               out + i * capacity, capacity);
+  } /* for(key..) */
+} /* QueryRadiusBatch() */
+
+const VisibilityGraph * Arena::planner(void) {
+  if (shared_planner_) {
+    return shared_planner_;
+  }
+  if (!own_planner_ || own_planner_stale_) {
+    // Keep the player's robot, with its collision buffer, a little clear
+    visibility_graph_params vparams;
+    vparams.clearance = RealToDouble(robot_.get_radius() +
+                                     robot_.get_collision_delta()) + 1;
+    circle_batch circles;
+    GatherObstacles(&circles);
+    own_planner_.reset(new VisibilityGraph());
+    own_planner_->Build(circles, static_cast<uint>(RealToDouble(x_dim_)),
+                        static_cast<uint>(RealToDouble(y_dim_)), vparams);
+    own_planner_stale_ = false;
+  }
+  return own_planner_.get();
+} /* planner() */
+
+FlowField * Arena::FlowFieldTo(enum autopilot_goal goal) {
+  if (goal == AUTOPILOT_HOME_BASE && shared_flow_field_) {
+    return shared_flow_field_;
+  }
+  if (!flow_fields_[goal]) {
+    flow_field_params fparams;
+    fparams.clearance = RealToDouble(robot_.get_radius() +
+                                     robot_.get_collision_delta()) + 1;
+    circle_batch circles;
+    GatherObstacles(&circles);
+    flow_fields_[goal].reset(new FlowField(
+        static_cast<uint>(RealToDouble(x_dim_)),
+        static_cast<uint>(RealToDouble(y_dim_)), circles, fparams));
+  }
+  return flow_fields_[goal].get();
+} /* FlowFieldTo() */
+
 /**
 * @brief Resets all entities in the arena to their newly constructed
 * states.
 */
 
 void Arena::Reset(void) {
-  for (auto ent : entities_) {
-    ent->Reset();
-  } /* for(ent..) */
+  const std::vector<entity_id>& robots = registry_.of_kind(KIND_ROBOT);
+  for (size_t i = 0; i < robots.size(); ++i) {
+    Robot(&registry_, robots[i]).Reset();
+  } /* for(i..) */
 } /* reset() */
 
-std::vector<Obstacle*> Arena::obstacles(void) {
-  std::vector<Obstacle*> res;
-  for (auto ent : entities_) {
-    Obstacle* o = dynamic_cast<Obstacle*>(ent);
-    if (o) {
-      res.push_back(o);
-    }
-  } /* for(ent..) */
-  return res;
-} /* robots() */
+void Arena::Snapshot(struct arena_snapshot * out) const {
+  out->registry = registry_;
+  out->game_over = GameOver;
+} /* Snapshot() */
+
+void Arena::Restore(const struct arena_snapshot& snapshot) {
+  registry_ = snapshot.registry;
+  GameOver = snapshot.game_over;
+  events_.commands().Clear();
+  bodies_indexed_ = false;
+  bodies_binned_ = false;
+} /* Restore() */
 /**
 * @brief Advances the state of the arena while the game is still
 * going. Calls UpdateEntitiesTimestep() to accomplish this.
 */
 void Arena::AdvanceTime(void) {
+  TRACE_SCOPE("Arena::AdvanceTime", "sim");
   if (!GameOver) {
   std::cout << "Advancing simulation time by 1 timestep\n";
   UpdateEntitiesTimestep();
   }
+  scratch_.Reset();
 } /* AdvanceTime() */
 /**
 * @brief Updates the state of all entities in the arena.
 *
-* Uses the fact that all ArenaEntity objects have a TimestepUpdate()
-* function to accomplish this. Also checks if the robot
-* has run out of battery, and if it has, then sets GameOver = true,
+* Runs the motion and wander systems over the component pools. Also checks if
+* the robot has run out of battery, and if it has, then sets GameOver = true,
 * ending the game.
 */
 void Arena::UpdateEntitiesTimestep(void) {
-  double old_robot_heading_angle = robot_->heading_angle();
+  if (profiler_) {
+    profiler_->BeginStep();
+  }
+  // Apply the commands that arrived since the last step.
+  if (input_) {
+    input_->Drain([this](const input_record& r) {
+        events_.commands().Push(command_record {
+            r.target == kNoEntity ? robot_.id() : r.target,
+            EventCommand(r.command)});
+      });
+  }
+  events_.commands().Dispatch();
+  AutopilotSystem();
+
   /*
    * First, update the position of all entities, according to their current
    * velocities.
    */
-  for (auto ent : entities_) {
-    ent->TimestepUpdate(1);
-  } /* for(ent..) */
+  TouchSystem();
+  AvoidanceSystem();
+  MotionSystem(1);
+  WanderSystem();
+  if (profiler_) {
+    profiler_->EndPhase(PHASE_ENTITY_UPDATE);
+  }
 
   /*
    * Next, check if the robot has run out of battery
    */
-  if (robot_->battery_level() <=0) {
-    std::cout << "You lose!" << std::endl;
-    std::cout << std::endl;
-    GameOver = true;
+  if (robot_.get_battery_level() <=0) {
+    events_.game_overs().Push(game_over_record {EventGameOver(false)});
+  }
+  if (profiler_) {
+    profiler_->EndPhase(PHASE_GAME_STATE);
   }
 
   /*
@@ -138,72 +539,432 @@ void Arena::UpdateEntitiesTimestep(void) {
    * base. These need to be before the general collisions, which can move the
    * robot away from these "obstacles" before the "collisions" have been
    * properly processed.
+   *
+   * Detection only queues events; they are delivered by type once every
+   * check has run, below.
    */
 
-  EventCollision ec;
+  EventCollision probe;
 
- /*  If the robot collides with the HomeBase, output "You win!"
-  *  to the terminal. Also resets the values of entities in the
-  *  arena, along with setting GameOver to true, causing Arena::AdvanceTime()
-  *  to stop.
+ /*  If the robot collides with the HomeBase, the player wins. The game over
+  *  event resets the entities in the arena and sets GameOver to true,
+  *  causing Arena::AdvanceTime() to stop.
   */
-  CheckForEntityCollision(robot_, home_base_, &ec, robot_->collision_delta());
-  if (ec.collided()) {
-    std::cout << "You win!" << std::endl;
-    std::cout << std::endl;
-    this->Reset();
-    GameOver = true;
+  CheckForEntityCollision(&robot_, &home_base_, &probe,
+    robot_.get_collision_delta());
+  if (probe.collided()) {
+    events_.game_overs().Push(game_over_record {EventGameOver(true)});
   }
 
-  /* If the robot collides with the recharge station, generate
-   * an EventRecharge object and pass it to robot_'s Accept() function.
-   * This causes the battery to recharge fully. Also sets the value of
-   * robot->hit_recharge_station_ to true. This prevents the Accept(ec)
-   * function from draining the battery when a collision with the
-   * recharge station occurs.
+  /* If the robot collides with the recharge station, queue an
+   * EventRecharge for it, which recharges the battery fully and marks
+   * the robot as having hit the recharge station so that the collision
+   * event does not drain the battery.
    */
-  CheckForEntityCollision(robot_, recharge_station_,
-    &ec, robot_->collision_delta());
-  if (ec.collided()) {
-    EventRecharge er;
-    robot_->Accept(&er);
-    robot_->hit_recharge_station(true);
-    er.EmitMessage();
+  const std::vector<entity_id>& stations = recharge_stations();
+  for (size_t i = 0; i < stations.size(); ++i) {
+    RechargeStation station(&registry_, stations[i]);
+    CheckForEntityCollision(&robot_, &station,
+      &probe, robot_.get_collision_delta());
+    if (probe.collided()) {
+      events_.recharges().Push(recharge_record {robot_.id(), EventRecharge()});
+      break;
+    }
+  } /* for(i..) */
+  if (profiler_) {
+    profiler_->EndPhase(PHASE_SPECIAL_COLLISIONS);
   }
 
   /*
    * Finally, some pairs of entities may now be close enough to be considered
    * colliding, send collision events as necessary.
-   *
-   * When something collides with an immobile entity, the immobile entity does
-   * not move (duh), so no need to send it a collision event.
    */
-  for (auto ent : mobile_entities_) {
+  CollisionSystem();
+
+  // Recharges go first so the robot knows not to drain its battery on the
+  // recharge station's collision event.
+  events_.recharges().Dispatch();
+  events_.collisions().Dispatch();
+  events_.game_overs().Dispatch();
+  if (profiler_) {
+    profiler_->EndPhase(PHASE_MOBILE_COLLISIONS);
+  }
+
+  // Range sensors read the arena as it stands at the end of the step
+  LidarSystem();
+  if (profiler_) {
+    profiler_->EndPhase(PHASE_SENSING);
+  }
+} /* UpdateEntities() */
+
+/**
+* @brief Turns every entity that moves away from what its touch sensor felt
+* last step.
+*/
+void Arena::TouchSystem(void) {
+  ComponentPool<kinematics>& movers = registry_.kinematics_pool();
+  ComponentPool<touch_sensor>& sensors = registry_.touch_sensor_pool();
+  const entity_id * owners = movers.owners();
+  for (size_t i = 0; i < movers.size(); ++i) {
+    // Update heading and speed as indicated by touch sensor
+    movers.data()[i].motion.UpdateVelocity(sensors.Get(owners[i]));
+  } /* for(i..) */
+} /* TouchSystem() */
+
+/**
+* @brief Chooses the velocity every avoiding entity moves by this step. Each
+* avoids its nearest neighbors as they were moving last step: avoiding ones
+* at the velocity they last chose, the rest along their heading, and
+* immobile ones not at all.
+*/
+void Arena::AvoidanceSystem(void) {
+  ComponentPool<avoidance>& avoiders = registry_.avoidance_pool();
+  if (avoiders.size() == 0) {
+    return;
+  }
+  TRACE_SCOPE("Arena::AvoidanceSystem", "sim");
+  IndexBodies();
+  const ComponentPool<transform>& bodies = registry_.transform_pool();
+  const ComponentPool<kinematics>& movers = registry_.kinematics_pool();
+  const entity_id * body_ids = bodies.owners();
+  avoidance_bodies_.Clear();
+  for (size_t i = 0; i < bodies.size(); ++i) {
+    const avoidance * a = avoiders.Find(body_ids[i]);
+    const kinematics * k = movers.Find(body_ids[i]);
+    Vector2 v;
+    if (a) {
+      v = a->velocity;
+    } else if (k) {
+      v = k->motion.direction() * k->motion.speed();
+    }
+    avoidance_bodies_.Push(RealToDouble(v.x), RealToDouble(v.y),
+                           a != nullptr);
+  } /* for(i..) */
+
+  const entity_id * owners = avoiders.owners();
+  avoidance_agents_.clear();
+  for (size_t i = 0; i < avoiders.size(); ++i) {
+    const kinematics& k = movers.Get(owners[i]);
+    Vector2 pref = k.motion.direction() * k.motion.speed();
+    // Clear of what would count as a collision
+    avoidance_agents_.push_back(orca_agent {
+        bodies.IndexOf(owners[i]), RealToDouble(pref.x), RealToDouble(pref.y),
+        RealToDouble(k.motion.max_speed()),
+        RealToDouble(k.collision_delta) + 1, 0, 0});
+  } /* for(i..) */
+  avoidance_solver_.Solve(avoidance_params_, body_shapes_, avoidance_bodies_,
+                          body_grid_, static_map_, &avoidance_agents_);
+  for (size_t i = 0; i < avoiders.size(); ++i) {
+    avoiders.data()[i].velocity = Vector2(avoidance_agents_[i].vx,
+                                          avoidance_agents_[i].vy);
+  } /* for(i..) */
+} /* AvoidanceSystem() */
+
+/**
+* @brief Moves every entity that has kinematics along its heading, or by the
+* velocity chosen for it if it avoids, and drains the battery of those that
+* have one by the distance moved.
+*/
+void Arena::MotionSystem(unsigned int dt) {
+  ComponentPool<kinematics>& movers = registry_.kinematics_pool();
+  ComponentPool<battery>& batteries = registry_.battery_pool();
+  const ComponentPool<avoidance>& avoiders = registry_.avoidance_pool();
+  const entity_id * owners = movers.owners();
+  for (size_t i = 0; i < movers.size(); ++i) {
+    entity_id e = owners[i];
+    ArenaMobileEntity ent(&registry_, e);
+    Position old_pos = ent.get_pos();
+    // Use velocity and position to update position
+    const avoidance * a = avoiders.Find(e);
+    if (a) {
+      motion_behavior_.UpdatePosition(&ent, a->velocity, dt, &scratch_);
+    } else {
+      motion_behavior_.UpdatePosition(&ent, dt, &scratch_);
+    }
+    // Deplete battery as appropriate given distance and speed of movement,
+    // and forget last step's contact with the recharge station
+    battery * b = batteries.Find(e);
+    if (b) {
+      b->cell.Deplete(old_pos, ent.get_pos(), dt);
+      b->on_charger = false;
+    }
+  } /* for(i..) */
+  bodies_indexed_ = false;
+} /* MotionSystem() */
+
+/**
+* @brief Turns each wandering entity (the HomeBase) to a random heading on
+* roughly one step in five.
+*/
+void Arena::WanderSystem(void) {
+  ComponentPool<wander>& wanderers = registry_.wander_pool();
+  const entity_id * owners = wanderers.owners();
+  for (size_t i = 0; i < wanderers.size(); ++i) {
+    int random_int = wanderers.data()[i].generator();
+
+    // Arbitrary integer used to determine random movement
+    // HomeBase turns a random angle.
+    if (random_int % 5 == 0) {
+      registry_.kinematics_pool().Get(owners[i]).motion.heading_angle(
+          (random_int/180) * M_PI);
+    }
+  } /* for(i..) */
+} /* WanderSystem() */
+
+/**
+* @brief Checks every mobile entity against the walls and then against every
+* other entity, and queues one collision event for each.
+*
+* When something collides with an immobile entity, the immobile entity does
+* not move (duh), so no need to send it a collision event.
+*
+* Every mobile entity gets an event, colliding or not, since a "no
+* collision" event is what deactivates its touch sensor.
+*/
+void Arena::CollisionSystem(void) {
+  const ComponentPool<kinematics>& movers = registry_.kinematics_pool();
+  const ComponentPool<transform>& bodies = registry_.transform_pool();
+  const entity_id * mover_ids = movers.owners();
+  const entity_id * body_ids = bodies.owners();
+  bool grid = bodies.size() > kGridCollisionBodies;
+  if (grid) {
+    EnsureBodiesIndexed();
+  }
+  for (size_t m = 0; m < movers.size(); ++m) {
+    ArenaMobileEntity ent(&registry_, mover_ids[m]);
+    collision_record rec = {ent.id(), EventCollision()};
     // Check if it is out of bounds. If so, use that as point of contact.
-    assert(ent->is_mobile());
-    CheckForEntityOutOfBounds(ent, &ec);
+    CheckForEntityOutOfBounds(&ent, &rec.event);
 
-    // If not at wall, check if colliding with any other entities (not itself)
-    if (!ec.collided()) {
-      for (size_t i = 0; i < entities_.size(); ++i) {
-        if (entities_[i] == ent) {
+    // If not at wall, check if colliding with any other entities (not
+    // itself). With many, only those the grid puts near it are checked, but
+    // still in pool order, so the one found is the one a full scan finds.
+    if (!rec.event.collided() && grid) {
+      double x = RealToDouble(ent.get_pos().x);
+      double y = RealToDouble(ent.get_pos().y);
+      double reach = RealToDouble(ent.get_radius() +
+                                  ent.get_collision_delta());
+      collision_candidates_.clear();
+      body_grid_.ForEachInBox(x - reach, y - reach, x + reach, y + reach,
+                              [&](uint32_t i) {
+          if (body_ids[i] != ent.id()) {
+            collision_candidates_.push_back(i);
+          }
+        });
+      std::sort(collision_candidates_.begin(), collision_candidates_.end());
+      for (uint32_t i : collision_candidates_) {
+        ArenaEntity other(&registry_, body_ids[i]);
+        CheckForEntityCollision(&ent, &other, &rec.event,
+          ent.get_collision_delta());
+        if (rec.event.collided()) {
+          break;
+        }
+      } /* for(i..) */
+      if (collision_candidates_.empty() && bodies.size() > 1) {
+        // As a scan that found nothing leaves it
+        rec.event.point_of_contact(ent.get_pos());
+      }
+    } else if (!rec.event.collided()) {
+      for (size_t i = 0; i < bodies.size(); ++i) {
+        if (body_ids[i] == ent.id()) {
           continue;
         }
-        CheckForEntityCollision(ent, entities_[i], &ec, ent->collision_delta());
-        if (ec.collided()) {
-          ec.EmitMessage();
-
+        ArenaEntity other(&registry_, body_ids[i]);
+        CheckForEntityCollision(&ent, &other, &rec.event,
+          ent.get_collision_delta());
+        if (rec.event.collided()) {
           break;
         }
       } /* for(i..) */
     } /* else */
-    ent->Accept(&ec);
-  } /* for(ent..) */
-} /* UpdateEntities() */
+
+    // Then against the precompiled obstacles near it
+    if (!rec.event.collided() && static_map_) {
+      double x = RealToDouble(ent.get_pos().x);
+      double y = RealToDouble(ent.get_pos().y);
+      double reach = RealToDouble(ent.get_radius() +
+                                  ent.get_collision_delta());
+      static_map_->ForEachInBox(x - reach, y - reach, x + reach, y + reach,
+                                [&](const static_obstacle& o) {
+          if (!rec.event.collided()) {
+            CheckForCircleCollision(&ent, Position(o.x, o.y), o.radius,
+              &rec.event, ent.get_collision_delta());
+          }
+        });
+    }
+    events_.collisions().Push(rec);
+  } /* for(m..) */
+} /* CollisionSystem() */
+
+/**
+* @brief Points every robot on autopilot at the next waypoint of its path,
+* planning a new path first when the old one is used up or stale; robots in
+* AUTOPILOT_TRACK mode repair theirs every step. Robots in AUTOPILOT_FLOW
+* mode look their direction up in the flow field toward their goal instead,
+* which is brought up to date once per step before the first lookup.
+*/
+void Arena::AutopilotSystem(void) {
+  ComponentPool<autopilot>& pilots = registry_.autopilot_pool();
+  if (pilots.size() == 0) {
+    return;
+  }
+  const VisibilityGraph * graph = nullptr;
+  FlowField * fields[2] = {nullptr, nullptr};
+  const entity_id * owners = pilots.owners();
+  for (size_t i = 0; i < pilots.size(); ++i) {
+    entity_id e = owners[i];
+    autopilot& ap = pilots.data()[i];
+    RobotMotionHandler& motion = registry_.kinematics_pool().Get(e).motion;
+    Position pos = registry_.transform_pool().Get(e).pos;
+    Position goal = ap.goal == AUTOPILOT_HOME_BASE ?
+        home_base_.get_pos() : recharge_station_.get_pos();
+    if (ap.mode == AUTOPILOT_FLOW) {
+      if (!fields[ap.goal]) {
+        fields[ap.goal] = FlowFieldTo(ap.goal);
+        fields[ap.goal]->Update(RealToDouble(goal.x), RealToDouble(goal.y));
+      }
+      Vector2 dir = fields[ap.goal]->Direction(RealToDouble(pos.x),
+                                               RealToDouble(pos.y));
+      if (dir.LengthSquared() > 0) {
+        motion.direction(dir);
+      }
+      motion.speed(motion.max_speed());
+      continue;
+    }
+    if (ap.mode == AUTOPILOT_TRACK) {
+      // With no way around, head straight for it
+      if (!ap.tracker->FindPath(pos, goal, &ap.path)) {
+        ap.path.assign(1, goal);
+      }
+      ap.next = 0;
+    } else if (ap.replan_in == 0 || ap.next >= ap.path.size()) {
+      if (!graph) {
+        graph = planner();
+      }
+      if (!graph->FindPath(pos, goal, &path_query_, &ap.path)) {
+        ap.path.clear();
+      }
+      ap.next = 0;
+      ap.replan_in = kAutopilotReplanSteps;
+    }
+    --ap.replan_in;
+
+    // Waypoints within a step's travel count as reached
+    real_t reach = motion.max_speed();
+    while (ap.next + 1 < ap.path.size() &&
+           Vector2(ap.path[ap.next].x - pos.x,
+                   ap.path[ap.next].y - pos.y).LengthSquared() <=
+           reach * reach) {
+      ++ap.next;
+    }
+    if (ap.next < ap.path.size()) {
+      Vector2 to(ap.path[ap.next].x - pos.x, ap.path[ap.next].y - pos.y);
+      if (to.LengthSquared() > 0) {
+        motion.direction(to.Normalized());
+      }
+      motion.speed(motion.max_speed());
+    }
+  } /* for(i..) */
+} /* AutopilotSystem() */
+
+/**
+* @brief Takes a reading with every range sensor. Each sensor casts at the
+* circles that can be within its range only, found through the body grid and
+* the static map's grid, so its cost grows with what is near it rather than
+* with the number of entities or the size of the static map.
+*/
+void Arena::LidarSystem(void) {
+  ComponentPool<lidar>& lidars = registry_.lidar_pool();
+  if (lidars.size() == 0) {
+    return;
+  }
+  const ComponentPool<transform>& bodies = registry_.transform_pool();
+  const entity_id * owners = lidars.owners();
+  const entity_id * body_ids = bodies.owners();
+  EnsureBodiesIndexed();
+  for (size_t i = 0; i < lidars.size(); ++i) {
+    entity_id e = owners[i];
+    lidar& sensor = lidars.data()[i];
+    const transform& self = bodies.Get(e);
+    const kinematics * k = registry_.kinematics_pool().Find(e);
+    double x = RealToDouble(self.pos.x);
+    double y = RealToDouble(self.pos.y);
+    double range = sensor.max_range();
+
+    lidar_targets_.Clear();
+    body_grid_.ForEachInBox(x - range, y - range, x + range, y + range,
+                            [&](uint32_t j) {
+        double dx = body_shapes_.x[j] - x;
+        double dy = body_shapes_.y[j] - y;
+        double reach = range + body_shapes_.r[j];
+        if (body_ids[j] != e && dx * dx + dy * dy <= reach * reach) {
+          lidar_targets_.Push(body_shapes_.x[j], body_shapes_.y[j],
+                              body_shapes_.r[j]);
+        }
+      });
+    if (static_map_) {
+      static_map_->ForEachInBox(x - range, y - range, x + range, y + range,
+                                [this](const static_obstacle& o) {
+          lidar_targets_.Push(o.x, o.y, o.radius); });
+    }
+    sensor.Scan(self.pos, k ? k->motion.direction() : Vector2(1, 0), x_dim_,
+                y_dim_, lidar_targets_);
+  } /* for(i..) */
+} /* LidarSystem() */
+
+void Arena::DeliverCommands(const command_record * events, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    Robot(&registry_, events[i].target).EventCmd(events[i].event.cmd());
+  } /* for(i..) */
+} /* DeliverCommands() */
+
+void Arena::DeliverRecharges(const recharge_record * events, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    Robot robot(&registry_, events[i].target);
+    robot.Accept(&events[i].event);
+    robot.hit_recharge_station(true);
+  } /* for(i..) */
+} /* DeliverRecharges() */
+
+/**
+* @brief Hands each collision event to the entity it was detected for,
+* chosen by the entity's kind rather than by a virtual Accept().
+*/
+void Arena::DeliverCollisions(const collision_record * events, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    entity_id e = events[i].target;
+    switch (registry_.kind(e)) {
+      case KIND_ROBOT:
+        Robot(&registry_, e).Accept(&events[i].event);
+        break;
+      case KIND_HOME_BASE:
+        HomeBase(&registry_, e).Accept(&events[i].event);
+        break;
+      default:
+        break;
+    } /* switch() */
+  } /* for(i..) */
+} /* DeliverCollisions() */
+
+/**
+* @brief Ends the game. On a win the entities are also reset, as when the
+* robot reaches the HomeBase.
+*/
+void Arena::DeliverGameOvers(const game_over_record * events, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    events[i].event.EmitMessage();
+    if (events[i].event.won()) {
+      this->Reset();
+    }
+    GameOver = true;
+  } /* for(i..) */
+} /* DeliverGameOvers() */
 
 /**
 * @brief Checks if ent has collided with a wall.
-* If it has, reflect it by calculating the angle of incidence.
+* If it has, the contact direction is the wall's outward normal, pointing
+* from ent toward the wall, which the entity's motion handler reflects its
+* heading about.
 *
 * @param ent Pointer to an ArenaMobileEntity object
 * @param event Pointer to a EventCollision object
@@ -211,118 +972,99 @@ void Arena::UpdateEntitiesTimestep(void) {
 
 void Arena::CheckForEntityOutOfBounds(const ArenaMobileEntity * const ent,
   EventCollision * event) {
-  if (ent->get_pos().x+ ent->radius() >= x_dim_) {
+  if (ent->get_pos().x+ ent->get_radius() >= x_dim_) {
     // Right Wall
     event->collided(true);
     event->collided_with_wall(true);
     event->point_of_contact(Position(x_dim_, ent->get_pos().y));
-    event->angle_of_contact(ent->heading_angle() - 180);
-  } else if (ent->get_pos().x- ent->radius() <= 0) {
+    event->contact_direction(Vector2(1, 0));
+  } else if (ent->get_pos().x- ent->get_radius() <= 0) {
     // Left Wall
     event->collided(true);
     event->collided_with_wall(true);
     event->point_of_contact(Position(0, ent->get_pos().y));
-    if (ent->get_pos().x <= x_dim_) {
-    event->angle_of_contact(ent->heading_angle() + 180);
-  }
-  } else if (ent->get_pos().y+ ent->radius() >= y_dim_) {
+    event->contact_direction(Vector2(-1, 0));
+  } else if (ent->get_pos().y+ ent->get_radius() >= y_dim_) {
     // Bottom Wall
     event->collided(true);
     event->collided_with_wall(true);
     event->point_of_contact(Position(ent->get_pos().x, y_dim_));
-    event->angle_of_contact(ent->heading_angle());
-  } else if (ent->get_pos().y - ent->radius() <= 0) {
+    event->contact_direction(Vector2(0, 1));
+  } else if (ent->get_pos().y - ent->get_radius() <= 0) {
     // Top Wall
     event->collided(true);
     event->collided_with_wall(true);
-    event->point_of_contact(Position(0, y_dim_));
-    event->angle_of_contact(ent->heading_angle());
+    event->point_of_contact(Position(ent->get_pos().x, 0));
+    event->contact_direction(Vector2(0, -1));
   } else {
     event->collided(false);
   }
 } /* entity_out_of_bounds() */
 /**
-* @brief Checks if ent1 has collided with ent2. If it has, then
-* bounce ent1 by calculating the angle of incidence.
+* @brief Checks if ent1 has collided with ent2. If it has, the contact
+* direction is the unit vector from ent1's center toward ent2's, which the
+* entity's motion handler reflects its heading about.
 *
 * @param ent1 Pointer to ArenaEntity object
 * @param ent2 Pointer to ArenaEntity object
 * @param event Pointer to EventCollision object
-* @param collision_delta Double used as a collision buffer
+* @param collision_delta Distance used as a collision buffer
 */
 void Arena::CheckForEntityCollision(const ArenaEntity* const ent1,
   const ArenaEntity* const ent2,
   EventCollision * event,
-  double collision_delta) {
+  real_t collision_delta) {
   /* Note: this assumes circular entities */
-  double ent1_x = ent1->get_pos().x;
-  double ent1_y = ent1->get_pos().y;
-  double ent2_x = ent2->get_pos().x;
-  double ent2_y = ent2->get_pos().y;
-  double dist = std::sqrt(
-    std::pow(ent2_x - ent1_x, 2) + std::pow(ent2_y - ent1_y, 2));
-  if (dist > ent1->radius() + ent2->radius() + collision_delta) {
+  CheckForCircleCollision(ent1, ent2->get_pos(), ent2->get_radius(), event,
+    collision_delta);
+} /* entities_have_collided() */
+
+void Arena::CheckForCircleCollision(const ArenaEntity* const ent1,
+  const Position& pos2, real_t r2,
+  EventCollision * event,
+  real_t collision_delta) {
+  real_t ent1_x = ent1->get_pos().x;
+  real_t ent1_y = ent1->get_pos().y;
+  real_t ent2_x = pos2.x;
+  real_t ent2_y = pos2.y;
+  real_t r1 = ent1->get_radius();
+  Vector2 delta(ent2_x - ent1_x, ent2_y - ent1_y);
+  real_t reach = r1 + r2 + collision_delta;
+  // Compare squared distances so the common no-collision case needs no sqrt.
+  if (delta.LengthSquared() > reach * reach) {
     event->collided(false);
     event->point_of_contact(ent1->get_pos());
   } else {
     // Populate the collision event.
     // Collided is true
     // Point of contact is point along perimeter of ent1
-    // Angle of contact is angle to that point of contact
+    // Contact direction points from ent1 toward that point of contact
     event->collided(true);
-    double angle_of_contact = 0.0;
-
-   /* Case 1: If the two entities are have same x-coordinate,
-    * this means that it collided  at a 90/270 degree angle; top/bottom.
-    * To determine angle_of_contact, PI is added to the change
-    * in y-coordinates * PI/2, essentially reflecting the angle.
-
-    * Case 2: If ent1_x > ent2_x, then this means the the collision
-    * occured on the right side of ent2, therefore the angle of contact
-    * is going to be equal to the tangent(dy, dx) where dy is the
-    * difference in y-coordinates and dx is the difference in
-    * x-coordinates.
-    *
-    * Case 3: Entities collide on left side of ent2, therefore the
-    * angle of contact is the tangent(dy, dx) and PI is added to
-    * the angle to reflect it 180 degrees.
-    */
-
-    if (ent2_x - ent1_x == 0) {
-      angle_of_contact = M_PI + (ent1_y - ent2_y) * M_PI/2;
-    } else {
-      if (ent1_x > ent2_x) {
-        angle_of_contact = atan((ent1_y - ent2_y) / (ent2_x - ent1_x));
-      } else {
-        angle_of_contact = atan((ent1_y - ent2_y) / (ent2_x - ent1_x)) + M_PI;
-      }
+
+    // Coincident centers give no direction; fall back to the entity's
+    // heading so it turns around rather than keeping straight on.
+    Vector2 contact = delta.Normalized();
+    if (contact.LengthSquared() == 0) {
+      const kinematics * k = registry_.kinematics_pool().Find(ent1->id());
+      contact = k ? k->motion.direction() : Vector2(1, 0);
     }
-    // Taihui helped me with this part, not fully knowledgeable of the logic.
     Position point_of_contact;
-    double total = ent1->radius() + ent2->radius();
-    point_of_contact.y = (ent2_y * (ent1->radius()) +
-    (ent1_y*ent2->radius())/(total));
-    point_of_contact.y = (ent1_y*ent2->radius() +
-     ent2_y*ent1->radius())/(ent1->radius() + ent2->radius());
-    point_of_contact.x = (ent1_x*ent2->radius() +
-    ent2_x*ent1->radius())/(ent1->radius() + ent2->radius());
-    event->angle_of_contact(angle_of_contact*180/M_PI);  // radians to degrees
+    point_of_contact.y = (ent1_y*r2 + ent2_y*r1)/(r1 + r2);
+    point_of_contact.x = (ent1_x*r2 + ent2_x*r1)/(r1 + r2);
+    event->contact_direction(contact);
     event->point_of_contact(point_of_contact);
-
-
-
-    /// >>>>>>> FILL THIS IN
   }
-} /* entities_have_collided() */
+} /* CheckForCircleCollision() */
 /**
-* @brief This function takes an EventKeypress and passes
-* it to robot_->EventCmd(). This allows the robot to be controlled
-* by keypresses.
+* @brief This function takes an EventKeypress and queues its command for
+* robot_.EventCmd() at the start of the next step. This allows the robot
+* to be controlled by keypresses.
 *
 * @param e Pointer to EventKeypress object used to send keypresses
 */
 void Arena::Accept(EventKeypress * e) {
-  robot_->EventCmd(e->get_key_cmd());
+  events_.commands().Push(command_record {robot_.id(),
+    EventCommand(e->get_key_cmd())});
 }
 
 NAMESPACE_END(csci3081);
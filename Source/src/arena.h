@@ -12,12 +12,27 @@
  ******************************************************************************/
 #include <cmath>
 #include <iostream>
+#include <memory>
 #include <vector>
 #include "src/event_keypress.h"
 #include "src/event_collision.h"
+#include "src/event_bus.h"
+#include "src/bump_allocator.h"
+#include "src/distance_field.h"
+#include "src/flow_field.h"
 #include "src/robot.h"
 #include "src/home_base.h"
+#include "src/input_queue.h"
 #include "src/recharge_station.h"
+#include "src/obstacle.h"
+#include "src/orca.h"
+#include "src/registry.h"
+#include "src/robot_motion_behavior.h"
+#include "src/perf_counters.h"
+#include "src/ray_cast.h"
+#include "src/spatial_grid.h"
+#include "src/static_map.h"
+#include "src/visibility_graph.h"
 
 /*******************************************************************************
  * Namespaces
@@ -29,6 +44,17 @@ NAMESPACE_BEGIN(csci3081);
  ******************************************************************************/
 struct arena_params;
 
+/**
+ * @brief An arena's entities and their components as they were at some
+ * point, and whether the game was over, for Arena::Restore().
+ */
+struct arena_snapshot {
+  arena_snapshot(void) : registry(), game_over(false) {}
+
+  Registry registry;
+  bool game_over;
+};
+
 /**
  * @brief The main class for the simulation of a 2D world with five
  * stationary objects, a moving HomeBase, and a player controlled Robot.
@@ -52,7 +78,9 @@ class Arena {
   void AdvanceTime(void);
 
   /**
-  * @brief Handle the key press passed along by the viewer.
+  * @brief Handle the key press passed along by the viewer. The command is
+  * queued and takes effect at the start of the next step. Only the thread
+  * stepping the arena may call this; others push to an input_queue().
   *
   * @param[in] e An event holding the key press.
   *
@@ -62,50 +90,305 @@ class Arena {
   // Reset all in the arena
   void Reset(void);
 
+  /**
+   * @brief Save the arena's state, to go back to with Restore(). Saving
+   * into the same snapshot again reuses its memory.
+   */
+  void Snapshot(struct arena_snapshot * out) const;
+
+  /**
+   * @brief Put the arena back as it was when snapshot was taken, e.g. to
+   * start an episode over. Once the arena has been as large as it was then,
+   * this allocates nothing.
+   *
+   * What is built from the obstacles (the distance field, the planners and
+   * flow fields) is kept as it is, so the obstacles should not have been
+   * spawned or despawned since.
+   */
+  void Restore(const struct arena_snapshot& snapshot);
+
+  /**
+   * @brief Get the size of the arena, within the walls.
+   */
+  real_t x_dim(void) const { return x_dim_; }
+  real_t y_dim(void) const { return y_dim_; }
+
   /**
    * @brief Get the # of robots in the arena.
    */
-  unsigned int n_robots(void) { return n_robots_; }
+  unsigned int n_robots(void) const {
+    return registry_.of_kind(KIND_ROBOT).size();
+  }
 
   /**
    * @brief Get # of obstacles in the arena.
    */
-  unsigned int n_obstacles(void) { return n_obstacles_; }
+  unsigned int n_obstacles(void) const {
+    return registry_.of_kind(KIND_OBSTACLE).size();
+  }
+
+  /**
+   * @brief Get the ids of all obstacles. View one with
+   * Obstacle(&registry(), id).
+   */
+  const std::vector<entity_id>& obstacles(void) const {
+    return registry_.of_kind(KIND_OBSTACLE);
+  }
 
   /**
-   * @brief Get a list of all obstacles (i.e. non-mobile entities in the arena).
+   * @brief Get the ids of all recharge stations.
    */
-  std::vector<class Obstacle*> obstacles(void);
+  const std::vector<entity_id>& recharge_stations(void) const {
+    return registry_.of_kind(KIND_RECHARGE_STATION);
+  }
 
   /**
-   * @brief Get the list of all mobile entities in the arena.
+   * @brief Get the precompiled obstacles the arena was made with, if any.
+   * They are not entities, so they are not among obstacles().
    */
-  std::vector<class ArenaMobileEntity*> mobile_entities(void)
-    { return mobile_entities_; }
+  const StaticMap * static_map(void) const { return static_map_; }
 
   /**
-  * @brief Returns a pointer to a Robot object.
+   * @brief Precompute the signed distance to the obstacles (those of the
+   * static map and obstacle entities) and the walls, for
+   * DistanceToObstacle() and AwayFromObstacles(). Once enabled, spawning
+   * and despawning obstacles updates it around them.
+   *
+   * @param[in] cell_size Grid spacing; the answers are good to about this.
+   * @param[in] max_distance How far out distances are kept. Further than
+   * this, DistanceToObstacle() returns max_distance.
+   */
+  void EnableDistanceField(double cell_size = 4, double max_distance = 64);
+  const DistanceField * distance_field(void) const {
+    return distance_field_.get();
+  }
+
+  /**
+   * @brief Signed distance from pos to the nearest obstacle or wall; negative
+   * inside one. Needs EnableDistanceField().
+   */
+  real_t DistanceToObstacle(const Position& pos) const {
+    return distance_field_->Distance(RealToDouble(pos.x),
+                                     RealToDouble(pos.y));
+  }
+
+  /**
+   * @brief Unit vector at pos pointing away from the nearest obstacle or
+   * wall; zero where none is within max_distance. Needs
+   * EnableDistanceField().
+   */
+  Vector2 AwayFromObstacles(const Position& pos) const {
+    return distance_field_->Gradient(RealToDouble(pos.x),
+                                     RealToDouble(pos.y));
+  }
+
+  /**
+   * @brief Let a robot steer itself to the goal around the obstacles, at
+   * full speed. Its arrow key commands no longer have any lasting effect.
+   *
+   * @param[in] mode AUTOPILOT_TRACK gives the robot a grid planner of its
+   * own that repairs its path every step. AUTOPILOT_FLOW suits many robots
+   * headed for one goal: they share one flow field, and each steers by a
+   * lookup in it.
+   */
+  void EnableAutopilot(entity_id robot, enum autopilot_goal goal,
+                       enum autopilot_mode mode = AUTOPILOT_PLAN);
+  void DisableAutopilot(entity_id robot);
+
+  /**
+   * @brief The visibility graph autopilots plan on: the one passed in the
+   * arena_params, or else one built from the obstacles when first needed and
+   * again after obstacles are spawned or despawned.
+   */
+  const VisibilityGraph * planner(void);
+
+  /**
+   * @brief The flow field toward a goal: the one passed in the
+   * arena_params for the HomeBase, else nullptr until a robot in
+   * AUTOPILOT_FLOW mode has headed for it. One of our own is dropped when
+   * obstacles are spawned or despawned, and built again when next needed.
+   */
+  const FlowField * flow_field(enum autopilot_goal goal) const {
+    if (goal == AUTOPILOT_HOME_BASE && shared_flow_field_) {
+      return shared_flow_field_;
+    }
+    return flow_fields_[goal].get();
+  }
+
+  /**
+   * @brief Let an entity that moves steer around the others and the static
+   * map obstacles by ORCA: each step it moves by the velocity nearest the one
+   * its heading and speed ask for that will not collide within the time
+   * horizon. Two such entities share the avoiding between them. Its heading
+   * and speed are not changed, so whatever steers it keeps control.
+   */
+  void EnableAvoidance(entity_id e);
+  void DisableAvoidance(entity_id e);
+
+  /**
+   * @brief Give an entity a range sensor, a copy of sensor, read at the end
+   * of every step from the entity's position along its heading (along +x
+   * if it does not move). Replaces any sensor it had.
+   */
+  void EnableLidar(entity_id e, const SensorLidar& sensor = SensorLidar());
+  void DisableLidar(entity_id e);
+
+  /**
+   * @brief Tuning for avoidance, read every step.
+   */
+  struct orca_params& avoidance_params(void) { return avoidance_params_; }
+
+  /*
+   * Queries for what is near a point, over every entity with a
+   * transform, filtered by kinds (a mask of KindBit()s).
+   *
+   * They go through a grid over the entities that is rebuilt at most once
+   * per step, when first needed, so each costs about what it finds rather
+   * than the number of entities. Results go into the caller's buffers.
+   * Positions are as of the end of the last step (or the last spawn or
+   * despawn), so an entity moved by hand in between is found where it was.
+   * Being const does not make them safe to run from two threads at once,
+   * since the first may rebuild the grid.
+   */
+
+  /**
+   * @brief The (up to) k entities whose centers are nearest pos, nearest
+   * first, leaving out skip (e.g. the one asking).
+   *
+   * @param[out] out Room for k ids.
+   * @param[out] distances If not nullptr, room for k center distances.
+   *
+   * @return How many were found.
+   */
+  size_t QueryNearest(const Position& pos, size_t k, uint32_t kinds,
+                      entity_id * out, double * distances = nullptr,
+                      entity_id skip = kNoEntity) const;
+
+  /**
+   * @brief The entities that overlap the circle of the given radius around
+   * center, in no particular order.
+   *
+   * @param[out] out Room for capacity ids.
+   *
+   * @return How many overlap it, which may be more than capacity.
+   */
+  size_t QueryRadius(const Position& center, double radius, uint32_t kinds,
+                     entity_id * out, size_t capacity) const;
+
+  /**
+   * @brief As QueryRadius(), for the box [x0, x1] x [y0, y1].
+   */
+  size_t QueryBox(double x0, double y0, double x1, double y1, uint32_t kinds,
+                  entity_id * out, size_t capacity) const;
+
+  /**
+   * @brief QueryNearest() for n points at once. The points are visited in
+   * grid order, so that queries close together run one after another on
+   * the same cells.
+   *
+   * @param[in] skip If not nullptr, one id per point to leave out.
+   * @param[out] out Room for n * k ids; point i's start at out + i * k.
+   * @param[out] counts Room for n; how many point i found.
+   */
+  void QueryNearestBatch(const Position * points, size_t n, size_t k,
+                         uint32_t kinds, const entity_id * skip,
+                         entity_id * out, size_t * counts) const;
+
+  /**
+   * @brief QueryRadius() for n circles of the same radius at once, visited
+   * in grid order.
+   *
+   * @param[out] out Room for n * capacity ids; circle i's start at
+   * out + i * capacity.
+   * @param[out] counts Room for n; how many overlap circle i, which may be
+   * more than capacity.
+   */
+  void QueryRadiusBatch(const Position * centers, size_t n, double radius,
+                        uint32_t kinds, entity_id * out, size_t capacity,
+                        size_t * counts) const;
+
+  /**
+   * @brief Add an entity while the simulation runs, e.g. to build a level
+   * procedurally or respawn a robot. Call between steps, not from an event
+   * subscriber.
+   *
+   * @return A handle that can be checked with registry().Valid() after the
+   * entity is gone.
+   */
+  entity_handle SpawnObstacle(real_t radius, const Position& pos,
+                              const Color& color);
+  entity_handle SpawnRechargeStation(real_t radius, const Position& pos,
+                                     const Color& color);
+  entity_handle SpawnRobot(const struct robot_params * params);
+
+  /**
+   * @brief Remove an entity added by the constructor or a Spawn call. The
+   * player's robot, the HomeBase and the first recharge station make up the
+   * game and cannot be removed.
+   *
+   * @return false if the handle is stale or names one of those.
+   */
+  bool Despawn(const entity_handle& h);
+
+  /**
+  * @brief Memory for temporaries that only live for one step, e.g. log
+  * strings. It is rewound at the end of every AdvanceTime().
+  */
+  BumpAllocator& scratch(void) { return scratch_; }
+
+  /**
+  * @brief The entities of the arena and their components.
+  */
+  Registry& registry(void) { return registry_; }
+  const Registry& registry(void) const { return registry_; }
+
+  /**
+  * @brief Returns a pointer to the player's Robot.
   */
-  Robot* robot(void) const { return robot_; }
+  Robot* robot(void) { return &robot_; }
+  const Robot* robot(void) const { return &robot_; }
 
   /**
   * @brief Returns a pointer to a HomeBase object.
   */
-  HomeBase* home_base(void) const { return home_base_; }
+  HomeBase* home_base(void) { return &home_base_; }
+  const HomeBase* home_base(void) const { return &home_base_; }
 
   /**
   * @brief Returns a pointer to a RechargeStation object.
   */
-  RechargeStation* recharge_station(void) const { return recharge_station_; }
+  RechargeStation* recharge_station(void) { return &recharge_station_; }
 
   /**
   * @brief Returns a bool object GameOver, which represents the state
   * of the game.
   */
-  bool getGameStatus() {
+  bool getGameStatus() const {
     return GameOver;
   }
 
+  /**
+  * @brief Attach a hardware counter profiler that is charged with each phase
+  * of UpdateEntitiesTimestep(). Pass nullptr to detach. The arena does not
+  * take ownership.
+  */
+  void perf_profiler(PerfPhaseProfiler * profiler) { profiler_ = profiler; }
+  PerfPhaseProfiler * perf_profiler(void) const { return profiler_; }
+
+  /**
+  * @brief Attach a queue of user input, which the arena drains at the start
+  * of each step, queuing each input's command for that step as Accept()
+  * would. Pass nullptr to detach. The arena does not take ownership.
+  */
+  void input_queue(InputQueue * queue) { input_ = queue; }
+  InputQueue * input_queue(void) const { return input_; }
+
+  /**
+  * @brief The queues events are delivered through. Subscribe to a queue to
+  * observe every event of that type, once per step, as one batch.
+  */
+  EventBus& event_bus(void) { return events_; }
+
  private:
   /**
    * @brief Determine if two entities have collided in the arena. Collision is
@@ -121,7 +404,16 @@ class Arena {
   void CheckForEntityCollision(const class ArenaEntity* const ent1,
     const class ArenaEntity* const ent2,
     EventCollision * ec,
-    double collision_delta);
+    real_t collision_delta);
+
+  /**
+   * @brief As CheckForEntityCollision(), against a circle that is not an
+   * entity.
+   */
+  void CheckForCircleCollision(const class ArenaEntity* const ent1,
+    const Position& pos2, real_t r2,
+    EventCollision * ec,
+    real_t collision_delta);
 
   /**
    * @brief Determine if a particular entity is gone out of the boundaries of
@@ -140,29 +432,144 @@ class Arena {
    */
   void UpdateEntitiesTimestep(void);
 
+  /**
+   * @brief The systems run by UpdateEntitiesTimestep(). Each walks the
+   * component pool it is named for and touches only entities in it.
+   *
+   * TouchSystem: kinematics + touch sensor; turns entities away from what
+   * they touched.
+   * AvoidanceSystem: avoidance + kinematics; picks each avoiding entity's
+   * velocity for the step among its nearest neighbors, found through the
+   * body grid.
+   * MotionSystem: kinematics + transform; moves entities and drains the
+   * batteries of those that have one.
+   * WanderSystem: wander + kinematics; turns the HomeBase at random.
+   * CollisionSystem: kinematics against every transform (a linear scan, or
+   * through the body grid when there are many), then against the static
+   * map; queues collision events.
+   * AutopilotSystem: autopilot + kinematics; plans or repairs paths and
+   * points each robot at its next waypoint, or along the flow field toward
+   * its goal.
+   * LidarSystem: lidar + transform; casts each range sensor's beams at the
+   * walls, the other transforms within range (through the body grid) and
+   * the static map obstacles within range (through its grid).
+   */
+  void TouchSystem(void);
+  void AvoidanceSystem(void);
+  void MotionSystem(unsigned int dt);
+  void WanderSystem(void);
+  void CollisionSystem(void);
+  void LidarSystem(void);
+  void AutopilotSystem(void);
+
+  /**
+   * @brief Sort every transform into body_grid_ as it stands, the items
+   * being their indices in the transform pool. EnsureBodiesIndexed() does so
+   * only if anything has moved, spawned or despawned since.
+   *
+   * Entities with no kinematics are binned once, and again only after a
+   * spawn, despawn or restore; the rest are binned again every time.
+   */
+  void IndexBodies(void) const;
+  void EnsureBodiesIndexed(void) const {
+    if (!bodies_indexed_) {
+      IndexBodies();
+    }
+  }
+
+  /**
+   * @brief The queries once the grid is up to date.
+   */
+  size_t NearestBodies(double x, double y, size_t k, uint32_t kinds,
+                       entity_id skip, entity_id * out,
+                       double * distances) const;
+  size_t BodiesInRadius(double x, double y, double radius, uint32_t kinds,
+                        entity_id * out, size_t capacity) const;
+
+  /**
+   * @brief Fill query_order_ with [0, n) sorted by the cell of points[i].
+   */
+  void OrderByCell(const Position * points, size_t n) const;
+
+  /**
+   * @brief The obstacle entities and the static map obstacles.
+   */
+  void GatherObstacles(struct circle_batch * out) const;
+
+  /**
+   * @brief The flow field toward goal, built if there is none.
+   */
+  FlowField * FlowFieldTo(enum autopilot_goal goal);
+
+  /**
+   * @brief The Arena's own subscribers, which hand each queued event to the
+   * entity it is addressed to.
+   */
+  void DeliverCommands(const command_record * events, size_t n);
+  void DeliverRecharges(const recharge_record * events, size_t n);
+  void DeliverCollisions(const collision_record * events, size_t n);
+  void DeliverGameOvers(const game_over_record * events, size_t n);
+
   // Under certain circumstance, the compiler requires that the copy
   // constructor is not defined. This is deleting the default copy const.
   Arena& operator=(const Arena& other) = delete;
   Arena(const Arena& other) = delete;
 
   // Dimensions of graphics window inside which robots must operate
-  double x_dim_;
-  double y_dim_;
-  unsigned int n_robots_;
-  unsigned int n_obstacles_;
-
-  // Entities populating the arena
-  Robot* robot_;
-  RechargeStation * recharge_station_;
-  HomeBase * home_base_;
-  std::vector<class ArenaEntity*> entities_;
-  std::vector<class ArenaMobileEntity*> mobile_entities_;
+  real_t x_dim_;
+  real_t y_dim_;
+
+  // Entities populating the arena, and views of the special ones
+  Registry registry_;
+  Robot robot_;
+  HomeBase home_base_;
+  RechargeStation recharge_station_;
+  EventBus events_;
+  RobotMotionBehavior motion_behavior_;
+  BumpAllocator scratch_;
+  const StaticMap * static_map_;
+  // What LidarSystem() casts at, refilled for each sensor
+  circle_batch lidar_targets_;
+  std::unique_ptr<DistanceField> distance_field_;
+  // Shared graph from the arena_params, else one of our own
+  const VisibilityGraph * shared_planner_;
+  std::unique_ptr<VisibilityGraph> own_planner_;
+  bool own_planner_stale_;
+  struct path_query path_query_;
+  // Shared field to the HomeBase from the arena_params, if any; else ours,
+  // indexed by autopilot_goal
+  FlowField * shared_flow_field_;
+  std::unique_ptr<FlowField> flow_fields_[2];
+  // Every transform, in pool order, and a grid over them for neighbor
+  // queries; rebuilt by IndexBodies() when a system or query needs it
+  mutable circle_batch body_shapes_;
+  mutable SpatialGrid body_grid_;
+  // Which of body_shapes_ have kinematics, and so are binned every time
+  mutable std::vector<uint32_t> moving_bodies_;
+  // Nothing has moved since body_grid_ was built, and nothing has spawned
+  // or despawned (so only the moving bodies need binning again)
+  mutable bool bodies_indexed_;
+  mutable bool bodies_binned_;
+  // Scratch for the queries
+  mutable std::vector<uint64_t> query_order_;
+  mutable std::vector<double> query_distances_;
+  std::vector<uint32_t> collision_candidates_;
+  struct orca_params avoidance_params_;
+  orca_bodies avoidance_bodies_;
+  std::vector<orca_agent> avoidance_agents_;
+  OrcaSolver avoidance_solver_;
 
   /* Variable used to determine the status of game, set to true when
   * the robot collides with the Home base, causing Arena::AdvanceTime()
   * to stop.
   */
   bool GameOver = false;
+
+  // Optional per-phase hardware counter profiler (not owned).
+  PerfPhaseProfiler * profiler_ = nullptr;
+
+  // Optional queue of user input drained each step (not owned).
+  InputQueue * input_ = nullptr;
 };
 
 NAMESPACE_END(csci3081);
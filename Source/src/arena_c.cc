@@ -0,0 +1,303 @@
+/**
+ * @file arena_c.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/arena_c.h"
+#include <stdio.h>
+#include <exception>
+#include <memory>
+#include <new>
+#include <string>
+#include "src/arena.h"
+#include "src/arena_defaults.h"
+#include "src/arena_params.h"
+#include "src/scenario.h"
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+struct arena_sim {
+  arena_sim(void) : params(), arena(), error() {}
+
+  csci3081::arena_params params;
+  std::unique_ptr<csci3081::Arena> arena;
+  // arena_last_error(); set by calls that take a const sim too
+  mutable char error[256];
+};
+
+struct arena_sim_snapshot {
+  arena_sim_snapshot(void) : snapshot() {}
+
+  csci3081::arena_snapshot snapshot;
+};
+
+/*******************************************************************************
+ * Constant Definitions
+ ******************************************************************************/
+// The C names are promises about the C++ ones
+static_assert(ARENA_KIND_ROBOT == csci3081::KIND_ROBOT &&
+              ARENA_KIND_HOME_BASE == csci3081::KIND_HOME_BASE &&
+              ARENA_KIND_RECHARGE_STATION ==
+                  csci3081::KIND_RECHARGE_STATION &&
+              ARENA_KIND_OBSTACLE == csci3081::KIND_OBSTACLE &&
+              ARENA_ALL_KINDS == csci3081::kAllKinds,
+              "arena_c.h entity kinds are out of date");
+static_assert(ARENA_COM_TURN_LEFT == csci3081::COM_TURN_LEFT &&
+              ARENA_COM_TURN_RIGHT == csci3081::COM_TURN_RIGHT &&
+              ARENA_COM_SPEED_UP == csci3081::COM_SPEED_UP &&
+              ARENA_COM_SLOW_DOWN == csci3081::COM_SLOW_DOWN,
+              "arena_c.h commands are out of date");
+static_assert(ARENA_NO_ENTITY == csci3081::kNoEntity,
+              "arena_c.h ARENA_NO_ENTITY is out of date");
+static_assert(sizeof(csci3081::real_t) == 8, "views expect 8 byte scalars");
+
+#ifdef ARENA_FIXED_POINT
+static const int32_t kRealDtype = ARENA_DTYPE_FIXED16;
+static_assert(csci3081::Fixed::kFractionBits == 16,
+              "ARENA_DTYPE_FIXED16 expects 16 fraction bits");
+#else
+static const int32_t kRealDtype = ARENA_DTYPE_F64;
+#endif
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief A view of one member of each element of a pool's storage, given a
+ * pointer to that member of the first element (nullptr if there is none).
+ */
+template <typename T, typename M>
+static void PointAt(const csci3081::ComponentPool<T>& pool, const M * first,
+                    int32_t dtype, struct arena_view * out) {
+  out->data = first;
+  out->count = pool.size();
+  out->stride = sizeof(T);
+  out->dtype = dtype;
+} /* PointAt() */
+
+template <typename T>
+static void PointAtOwners(const csci3081::ComponentPool<T>& pool,
+                          struct arena_view * out) {
+  out->data = pool.size() ? pool.owners() : nullptr;
+  out->count = pool.size();
+  out->stride = sizeof(csci3081::entity_id);
+  out->dtype = ARENA_DTYPE_U32;
+} /* PointAtOwners() */
+
+/**
+ * @brief Put why the exception being handled was thrown into error, which
+ * holds error_size characters. Call only from a catch block.
+ */
+static void DescribeException(char * error, size_t error_size) {
+  if (!error || !error_size) {
+    return;
+  }
+  try {
+    throw;
+  } catch (const std::bad_alloc&) {
+    snprintf(error, error_size, "out of memory");
+  } catch (const std::exception& e) {
+    snprintf(error, error_size, "%s", e.what());
+  } catch (...) {
+    snprintf(error, error_size, "unknown error");
+  }
+} /* DescribeException() */
+
+static void Caught(const arena_sim * sim) {
+  DescribeException(sim->error, sizeof(sim->error));
+} /* Caught() */
+
+uint32_t arena_api_version(void) { return ARENA_API_VERSION; }
+
+arena_sim * arena_create(const char * scenario_path, char * error,
+                         size_t error_size) {
+  try {
+    std::unique_ptr<arena_sim> sim(new arena_sim);
+    csci3081::DefaultArenaParams(&sim->params);
+    std::string why;
+    if (scenario_path &&
+        !csci3081::LoadScenario(scenario_path, &sim->params, &why)) {
+      if (error && error_size) {
+        snprintf(error, error_size, "%s", why.c_str());
+      }
+      return nullptr;
+    }
+    sim->arena.reset(new csci3081::Arena(&sim->params));
+    return sim.release();
+  } catch (...) {
+    DescribeException(error, error_size);
+    return nullptr;
+  }
+} /* arena_create() */
+
+void arena_destroy(arena_sim * sim) { delete sim; }
+
+int arena_step(arena_sim * sim, uint32_t n_steps) {
+  try {
+    for (uint32_t i = 0; i < n_steps; ++i) {
+      sim->arena->AdvanceTime();
+    } /* for(i..) */
+  } catch (...) {
+    Caught(sim);
+    return -1;
+  }
+  return 0;
+} /* arena_step() */
+
+int arena_command(arena_sim * sim, int32_t command) {
+  if (command < ARENA_COM_TURN_LEFT || command > ARENA_COM_SLOW_DOWN) {
+    snprintf(sim->error, sizeof(sim->error), "no command %d", command);
+    return -1;
+  }
+  try {
+    sim->arena->event_bus().commands().Push(csci3081::command_record {
+        sim->arena->robot()->id(),
+        csci3081::EventCommand(static_cast<enum csci3081::event_commands>(
+            command))});
+  } catch (...) {
+    Caught(sim);
+    return -1;
+  }
+  return 0;
+} /* arena_command() */
+
+int arena_game_over(const arena_sim * sim) {
+  return sim->arena->getGameStatus() ? 1 : 0;
+} /* arena_game_over() */
+
+uint32_t arena_player(const arena_sim * sim) {
+  return sim->arena->robot()->id();
+} /* arena_player() */
+
+uint32_t arena_kind(const arena_sim * sim, uint32_t id) {
+  const csci3081::Registry& registry = sim->arena->registry();
+  if (!registry.alive(id)) {
+    return ARENA_KIND_NONE;
+  }
+  return registry.kind(id);
+} /* arena_kind() */
+
+const char * arena_last_error(const arena_sim * sim) {
+  return sim->error[0] ? sim->error : nullptr;
+} /* arena_last_error() */
+
+arena_sim_snapshot * arena_snapshot(const arena_sim * sim) {
+  try {
+    std::unique_ptr<arena_sim_snapshot> snapshot(new arena_sim_snapshot);
+    sim->arena->Snapshot(&snapshot->snapshot);
+    return snapshot.release();
+  } catch (...) {
+    Caught(sim);
+    return nullptr;
+  }
+} /* arena_snapshot() */
+
+int arena_restore(arena_sim * sim, const arena_sim_snapshot * snapshot) {
+  try {
+    sim->arena->Restore(snapshot->snapshot);
+  } catch (...) {
+    Caught(sim);
+    return -1;
+  }
+  return 0;
+} /* arena_restore() */
+
+void arena_snapshot_destroy(arena_sim_snapshot * snapshot) {
+  delete snapshot;
+} /* arena_snapshot_destroy() */
+
+size_t arena_query_nearest(const arena_sim * sim, double x, double y,
+                           size_t k, uint32_t kinds, uint32_t skip,
+                           uint32_t * out, double * distances) {
+  try {
+    return sim->arena->QueryNearest(Position(x, y), k, kinds, out,
+                                    distances, skip);
+  } catch (...) {
+    Caught(sim);
+    return 0;
+  }
+} /* arena_query_nearest() */
+
+size_t arena_query_radius(const arena_sim * sim, double x, double y,
+                          double radius, uint32_t kinds, uint32_t * out,
+                          size_t capacity) {
+  try {
+    return sim->arena->QueryRadius(Position(x, y), radius, kinds, out,
+                                   capacity);
+  } catch (...) {
+    Caught(sim);
+    return 0;
+  }
+} /* arena_query_radius() */
+
+size_t arena_query_box(const arena_sim * sim, double x0, double y0,
+                       double x1, double y1, uint32_t kinds, uint32_t * out,
+                       size_t capacity) {
+  try {
+    return sim->arena->QueryBox(x0, y0, x1, y1, kinds, out, capacity);
+  } catch (...) {
+    Caught(sim);
+    return 0;
+  }
+} /* arena_query_box() */
+
+int arena_get_view(const arena_sim * sim, int32_t field,
+                   struct arena_view * out) {
+  const csci3081::Registry& registry = sim->arena->registry();
+  const csci3081::ComponentPool<csci3081::transform>& bodies =
+      registry.transform_pool();
+  const csci3081::ComponentPool<csci3081::kinematics>& movers =
+      registry.kinematics_pool();
+  const csci3081::ComponentPool<csci3081::battery>& batteries =
+      registry.battery_pool();
+  const csci3081::transform * body = bodies.data();
+  const csci3081::kinematics * mover = movers.data();
+  const csci3081::battery * cell = batteries.data();
+  switch (field) {
+  case ARENA_BODY_ID:
+    PointAtOwners(bodies, out);
+    break;
+  case ARENA_BODY_X:
+    PointAt(bodies, bodies.size() ? &body->pos.x : nullptr, kRealDtype,
+            out);
+    break;
+  case ARENA_BODY_Y:
+    PointAt(bodies, bodies.size() ? &body->pos.y : nullptr, kRealDtype,
+            out);
+    break;
+  case ARENA_BODY_RADIUS:
+    PointAt(bodies, bodies.size() ? &body->radius : nullptr, kRealDtype,
+            out);
+    break;
+  case ARENA_MOVER_ID:
+    PointAtOwners(movers, out);
+    break;
+  case ARENA_MOVER_HEADING_X:
+    PointAt(movers, movers.size() ? &mover->motion.direction().x : nullptr,
+            kRealDtype, out);
+    break;
+  case ARENA_MOVER_HEADING_Y:
+    PointAt(movers, movers.size() ? &mover->motion.direction().y : nullptr,
+            kRealDtype, out);
+    break;
+  case ARENA_MOVER_SPEED:
+    PointAt(movers, movers.size() ? &mover->motion.speed() : nullptr,
+            kRealDtype, out);
+    break;
+  case ARENA_BATTERY_ID:
+    PointAtOwners(batteries, out);
+    break;
+  case ARENA_BATTERY_LEVEL:
+    PointAt(batteries, batteries.size() ? &cell->cell.level() : nullptr,
+            kRealDtype, out);
+    break;
+  default:
+    return -1;
+  } /* switch() */
+  return 0;
+} /* arena_get_view() */
@@ -0,0 +1,197 @@
+/**
+ * @file arena_c.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ *
+ * The C interface of libarena.so, for embedding the simulation in programs
+ * not written in C++. Only this header is needed to use the library.
+ *
+ * The interface is kept stable: handles are opaque, functions are only ever
+ * added, and the structures here do not change. arena_api_version() says
+ * which functions a given library has.
+ *
+ * No function lets a C++ exception out. Those that can fail say so in what
+ * they return, and arena_last_error() says why (arena_create() says why in
+ * the buffer it is given).
+ *
+ * State is read through views straight into the simulation's storage, not
+ * copied out. A view is good until the next call that changes the arena
+ * (stepping, commands, restoring); take it again after each of those.
+ *
+ * A sim is for one thread at a time. That goes for the functions that take
+ * it const too: the queries rebuild its neighbor grid when it is out of
+ * date, and any call can set its last error. Different sims can be used
+ * from different threads at once.
+ */
+
+#ifndef SRC_ARENA_C_H_
+#define SRC_ARENA_C_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Constant Definitions
+ ******************************************************************************/
+#define ARENA_API_VERSION 1
+
+#define ARENA_API __attribute__((visibility("default")))
+
+/* An id that names no entity */
+#define ARENA_NO_ENTITY 0xFFFFFFFFu
+
+/* What arena_kind() gives for an id that names no live entity */
+#define ARENA_KIND_NONE 0xFFFFFFFFu
+
+/* Entity kinds, and bits for them in kind masks */
+#define ARENA_KIND_ROBOT 0
+#define ARENA_KIND_HOME_BASE 1
+#define ARENA_KIND_RECHARGE_STATION 2
+#define ARENA_KIND_OBSTACLE 3
+#define ARENA_KIND_BIT(kind) (1u << (kind))
+#define ARENA_ALL_KINDS 0xFu
+
+/* Commands for the player's robot, as the arrow keys give */
+#define ARENA_COM_TURN_LEFT 0
+#define ARENA_COM_TURN_RIGHT 1
+#define ARENA_COM_SPEED_UP 2
+#define ARENA_COM_SLOW_DOWN 3
+
+/*******************************************************************************
+ * Type Definitions
+ ******************************************************************************/
+typedef struct arena_sim arena_sim;
+typedef struct arena_sim_snapshot arena_sim_snapshot;
+
+/* How the elements of a view are stored */
+enum arena_dtype {
+  ARENA_DTYPE_F64 = 0,
+  /* int64_t, the value times 65536 (a library built with FIXED_POINT=1) */
+  ARENA_DTYPE_FIXED16 = 1,
+  ARENA_DTYPE_U32 = 2
+};
+
+/*
+ * What a view can show. Each group is one table, in one order: element i of
+ * ARENA_BODY_X and of ARENA_BODY_ID are about the same entity, but element
+ * i of ARENA_BODY_X and of ARENA_MOVER_SPEED may not be.
+ */
+enum arena_field {
+  /* Every entity */
+  ARENA_BODY_ID = 0,
+  ARENA_BODY_X = 1,
+  ARENA_BODY_Y = 2,
+  ARENA_BODY_RADIUS = 3,
+  /* Entities that move */
+  ARENA_MOVER_ID = 4,
+  ARENA_MOVER_HEADING_X = 5,
+  ARENA_MOVER_HEADING_Y = 6,
+  ARENA_MOVER_SPEED = 7,
+  /* Robots' batteries */
+  ARENA_BATTERY_ID = 8,
+  ARENA_BATTERY_LEVEL = 9
+};
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/*
+ * A column of a table: element i is at (const char *)data + i * stride.
+ */
+struct arena_view {
+  const void * data;
+  size_t count;
+  size_t stride;
+  int32_t dtype;
+};
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+ARENA_API uint32_t arena_api_version(void);
+
+/*
+ * Make an arena from a text or compiled scenario file, or the default arena
+ * if scenario_path is NULL. On failure, returns NULL and writes why into
+ * error (if not NULL), cut to error_size bytes.
+ */
+ARENA_API arena_sim * arena_create(const char * scenario_path, char * error,
+                                   size_t error_size);
+ARENA_API void arena_destroy(arena_sim * sim);
+
+/*
+ * Advance n_steps steps; none once the game is over. Returns 0, or -1 if a
+ * step failed (see arena_last_error()), which leaves the arena in an
+ * unknown state; destroy it or restore a snapshot.
+ */
+ARENA_API int arena_step(arena_sim * sim, uint32_t n_steps);
+
+/*
+ * Queue a command for the player's robot for the next step. Returns 0, or
+ * -1 if command is not one of ARENA_COM_*.
+ */
+ARENA_API int arena_command(arena_sim * sim, int32_t command);
+
+/*
+ * 1 once the player has won or lost, else 0.
+ */
+ARENA_API int arena_game_over(const arena_sim * sim);
+
+ARENA_API uint32_t arena_player(const arena_sim * sim);
+
+/*
+ * One of ARENA_KIND_*, or ARENA_KIND_NONE if id names no live entity.
+ */
+ARENA_API uint32_t arena_kind(const arena_sim * sim, uint32_t id);
+
+/*
+ * Why the last call on sim that failed did, or NULL if none has.
+ */
+ARENA_API const char * arena_last_error(const arena_sim * sim);
+
+/*
+ * Save the arena's entities, and put them back later. Restoring needs the
+ * arena the snapshot was taken of, with the same obstacles. Returns NULL,
+ * or -1, if out of memory.
+ */
+ARENA_API arena_sim_snapshot * arena_snapshot(const arena_sim * sim);
+ARENA_API int arena_restore(arena_sim * sim,
+                            const arena_sim_snapshot * snapshot);
+ARENA_API void arena_snapshot_destroy(arena_sim_snapshot * snapshot);
+
+/*
+ * The neighbor queries of the arena, over the kinds in the mask kinds. See
+ * Arena::QueryNearest(), QueryRadius() and QueryBox(). A query that fails
+ * finds nothing and sets arena_last_error().
+ */
+ARENA_API size_t arena_query_nearest(const arena_sim * sim, double x,
+                                     double y, size_t k, uint32_t kinds,
+                                     uint32_t skip, uint32_t * out,
+                                     double * distances);
+ARENA_API size_t arena_query_radius(const arena_sim * sim, double x,
+                                    double y, double radius, uint32_t kinds,
+                                    uint32_t * out, size_t capacity);
+ARENA_API size_t arena_query_box(const arena_sim * sim, double x0,
+                                 double y0, double x1, double y1,
+                                 uint32_t kinds, uint32_t * out,
+                                 size_t capacity);
+
+/*
+ * Point out at one of the arena_field columns. Returns 0, or -1 if field is
+ * not one of them.
+ */
+ARENA_API int arena_get_view(const arena_sim * sim, int32_t field,
+                             struct arena_view * out);
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif  /* SRC_ARENA_C_H_ */
@@ -0,0 +1,59 @@
+/**
+ * @file arena_defaults.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/arena_defaults.h"
+#include "src/color.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+void DefaultArenaParams(struct arena_params * aparams) {
+  robot_params rparams;
+
+  rparams.battery_max_charge = 100.0;
+  rparams.angle_delta = 10;
+  rparams.collision_delta = 2;
+  rparams.radius = 20.0;
+  rparams.pos = Position(500, 500);
+  rparams.color = Color(0, 0, 255, 255); /* blue */
+
+  aparams->robot = rparams;
+
+  aparams->recharge_station.radius = 20.0;
+  aparams->recharge_station.pos = {500, 300};
+  aparams->recharge_station.color = Color(0, 128, 128, 255);
+  /* green */
+
+  aparams->home_base.radius = 20.0;
+  aparams->home_base.pos = {400, 400};
+  aparams->home_base.color = Color(255, 0, 0, 255); /* red */
+  // Arbitrary positions used to instantiate the obstacles, all white.
+  const Position obstacle_pos[] = {
+    {200, 200}, {400, 600}, {200, 350}, {700, 300}, {400, 100}
+  };
+  aparams->obstacles.clear();
+  for (const Position& pos : obstacle_pos) {
+    arena_entity_params o;
+    o.radius = 30.0;
+    o.pos = pos;
+    o.color = Color(255, 255, 255, 255); /* white */
+    aparams->obstacles.push_back(o);
+  } /* for(pos..) */
+  aparams->extra_robots.clear();
+  aparams->extra_recharge_stations.clear();
+  aparams->x_dim = 1024;
+  aparams->y_dim = 768;
+} /* DefaultArenaParams() */
+
+NAMESPACE_END(csci3081);
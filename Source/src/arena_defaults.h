@@ -1,14 +1,16 @@
 /**
- * @file obstacle.cc
+ * @file arena_defaults.h
  *
  * @copyright 2017 3081 Staff, All rights reserved.
  */
 
+#ifndef SRC_ARENA_DEFAULTS_H_
+#define SRC_ARENA_DEFAULTS_H_
+
 /*******************************************************************************
  * Includes
  ******************************************************************************/
-#include "src/obstacle.h"
-#include "src/color.h"
+#include "src/arena_params.h"
 
 /*******************************************************************************
  * Namespaces
@@ -16,18 +18,19 @@
 NAMESPACE_BEGIN(csci3081);
 
 /*******************************************************************************
- * Static Variables
+ * Non-Member Functions
  ******************************************************************************/
-uint Obstacle::next_id_ = 0;
-
-/*******************************************************************************
- * Constructors/Destructor
- ******************************************************************************/
-Obstacle::Obstacle(double radius, const Position& pos,
-                                   const Color& color) :
-    ArenaImmobileEntity(radius, pos, color),
-    id_(-1) {
-  id_ = next_id_++;
-}
+/**
+ * @brief Fill in the standard arena: one robot, a recharge station, a home
+ * base and five obstacles in a 1024x768 window.
+ *
+ * Shared by arenaviewer and the headless runner so both simulate the same
+ * layout.
+ *
+ * @param[out] aparams The parameters to fill in.
+ */
+void DefaultArenaParams(struct arena_params * aparams);
 
 NAMESPACE_END(csci3081);
+
+#endif /* SRC_ARENA_DEFAULTS_H_ */
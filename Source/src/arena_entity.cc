@@ -0,0 +1,49 @@
+/**
+ * @file arena_entity.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/arena_entity.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+/**
+* @brief Robots and obstacles are numbered by entity id; the HomeBase and
+* RechargeStation are named by kind alone.
+*/
+std::string ArenaEntity::name(void) const {
+  enum entity_kind k = kind();
+  if (k == KIND_ROBOT || k == KIND_OBSTACLE) {
+    return Registry::kind_name(k) + std::to_string(id_);
+  }
+  return Registry::kind_name(k);
+} /* name() */
+
+const char * ArenaEntity::name(BumpAllocator * scratch) const {
+  enum entity_kind k = kind();
+  if (k == KIND_ROBOT || k == KIND_OBSTACLE) {
+    return scratch->Format("%s%u", Registry::kind_name(k), id_);
+  }
+  return Registry::kind_name(k);
+} /* name() */
+
+entity_id ArenaEntity::Spawn(Registry * registry, enum entity_kind kind,
+                             real_t radius, const Position& pos,
+                             const Color& color) {
+  entity_id e = registry->Create(kind);
+  registry->transform_pool().Add(e, transform {pos, radius});
+  registry->renderable_pool().Add(e, renderable {color});
+  return e;
+} /* Spawn() */
+
+NAMESPACE_END(csci3081);
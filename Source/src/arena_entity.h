@@ -10,10 +10,11 @@
 /*******************************************************************************
  * Includes
  ******************************************************************************/
-#include <nanogui/nanogui.h>
 #include <string>
 #include "src/common.h"
+#include "src/bump_allocator.h"
 #include "src/color.h"
+#include "src/registry.h"
 
 /*******************************************************************************
  * Namespaces
@@ -24,48 +25,58 @@ NAMESPACE_BEGIN(csci3081);
  * Class Definitions
  ******************************************************************************/
 /**
- * @brief A base class representing an entity within the arena. All entities
- * within the arena know how to :
+ * @brief A view of one entity in an Arena's Registry.
  *
- * 1. Update themselves each timestep (i.e. in accordance with current velocity
- *    and position).
- * 2. Reset themselves to a newly constructed state. This is so the user can
- *    click the reset button after completing a game and have things work as
- *    expected.
+ * The entity's state lives in the registry's component pools; this class and
+ * its subclasses are lightweight handles (a registry pointer and an id) that
+ * give named access to it. They hold no state of their own, so one can be
+ * made on the stack whenever it is convenient, and copying one copies the
+ * handle, not the entity.
  *
- * Note that not all classes need to be able to do these two things.
+ * Per-step behavior (motion, battery drain, collision response) is done by
+ * the Arena's systems over the component arrays rather than by virtual
+ * methods on each entity.
  */
 class ArenaEntity {
  public:
-  ArenaEntity(double radius, const Position& pos,
-              const Color& color) :
-      radius_(radius), pos_(pos), color_(color) {}
-  virtual ~ArenaEntity(void) {}
+  ArenaEntity(Registry * registry, entity_id id) :
+      registry_(registry), id_(id) {}
 
+  entity_id id(void) const { return id_; }
+  enum entity_kind kind(void) const { return registry_->kind(id_); }
+  std::string name(void) const;
   /**
-   * @brief Perform whatever updates are needed for a particular entity after 1
-   * timestep (updating position, changing color, etc.).
+   * @brief The same name, formatted into scratch memory rather than the heap.
    */
-  virtual void TimestepUpdate(__unused uint dt) {}
+  const char * name(BumpAllocator * scratch) const;
 
+  void set_pos(const Position& pos) { xf().pos = pos; }
+  const Position& get_pos(void) const { return xf().pos; }
+  const Color& get_color(void) const {
+    return registry_->renderable_pool().Get(id_).color;
+  }
+  void set_color(const Color& color) {
+    registry_->renderable_pool().Get(id_).color = color;
+  }
+  bool is_mobile(void) const { return registry_->kinematics_pool().Has(id_); }
+  real_t get_radius(void) const { return xf().radius; }
+
+ protected:
   /**
-   * @brief Reset the entity to its newly constructed state.
+   * @brief Create a new entity of the given kind with a transform and a
+   * renderable, for the constructors of subclasses.
    */
-  virtual void Reset(void) {}
-
-  virtual std::string name(void) const = 0;
+  static entity_id Spawn(Registry * registry, enum entity_kind kind,
+                         real_t radius, const Position& pos,
+                         const Color& color);
 
-  void set_pos(const Position& pos) { pos_ = pos; }
-  const Position& get_pos(void) const { return pos_; }
-  const Color& get_color(void) const { return color_; }
-  void set_color(const Color& color) { color_ = color; }
-  virtual bool is_mobile(void) = 0;
-  double get_radius(void) const { return radius_; }
+  transform& xf(void) { return registry_->transform_pool().Get(id_); }
+  const transform& xf(void) const {
+    return registry_->transform_pool().Get(id_);
+  }
 
- private:
-  double radius_;
-  Position pos_;
-  Color color_;
+  Registry * registry_;
+  entity_id id_;
 };
 
 NAMESPACE_END(csci3081);
@@ -0,0 +1,349 @@
+/**
+ * @file arena_generator.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/arena_generator.h"
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "src/arena_defaults.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constant Definitions
+ ******************************************************************************/
+// Candidates tried around an active sample before it is retired. Bridson
+// suggests 30; fewer leaves the layout a little sparser but is much faster,
+// since most of the work is spent retiring samples.
+static const int kCandidates = 10;
+
+// Random seeds thrown into a tile after growth from the previous one stops,
+// to start filling any pocket it could not reach.
+static const int kDarts = 8;
+
+// Grid cells per side of a tile (see PoissonDisk::Fill()).
+static const int kTileCells = 32;
+
+// Directions a candidate is placed in around its parent sample.
+static const int kDirections = 1024;
+
+// Random positions tried for each of the robot, home base and recharge
+// station before the arena is taken to be too small for them.
+static const int kPlacementTries = 1000;
+
+// Arena area per obstacle, in units of the squared minimum spacing, when the
+// arena is sized to fit. The sampler packs about 0.58 samples per spacing^2,
+// so this leaves a few percent to spare.
+static const double kAreaPerObstacle = 1.8;
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+namespace {
+
+/**
+ * @brief SplitMix64. The generator is part of what a seed means, so it is
+ * spelled out here rather than left to the standard library; it is also a
+ * good deal cheaper than std::mt19937 when drawing tens of millions of
+ * candidates.
+ */
+class SplitMix64 {
+ public:
+  explicit SplitMix64(uint64_t seed) : state_(seed) {}
+
+  uint64_t Next(void) {
+    uint64_t z = (state_ += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  }
+
+  /**
+   * @brief Uniform in [0, 1), from the top 53 bits of a draw.
+   */
+  static double ToUnit(uint64_t bits) {
+    return (bits >> 11) * (1.0 / 9007199254740992.0);
+  }
+  double Unit(void) { return ToUnit(Next()); }
+
+ private:
+  uint64_t state_;
+};
+
+/**
+ * @brief Bridson's Poisson-disk sampler over a grid of cells small enough to
+ * hold at most one sample each.
+ */
+class PoissonDisk {
+ public:
+  PoissonDisk(double min_dist, double x_lo, double y_lo, double x_hi,
+              double y_hi, SplitMix64 * rng) :
+      min_dist_(min_dist), min_dist2_(min_dist * min_dist),
+      cell_(min_dist / std::sqrt(2.0)), x_lo_(x_lo), y_lo_(y_lo),
+      x_hi_(x_hi), y_hi_(y_hi),
+      cols_(std::max(1, static_cast<int>(std::ceil((x_hi - x_lo) / cell_)))),
+      rows_(std::max(1, static_cast<int>(std::ceil((y_hi - y_lo) / cell_)))),
+      stride_(cols_ + 4),
+      grid_(static_cast<size_t>(stride_) * (rows_ + 4), cell {kEmpty, kEmpty}),
+      neighbours_(), dir_x_(), dir_y_(), xs_(), ys_(), keep_out_(),
+      active_(), rng_(rng) {
+    for (int i = 0; i < kDirections; ++i) {
+      dir_x_[i] = std::cos(2 * M_PI * i / kDirections);
+      dir_y_[i] = std::sin(2 * M_PI * i / kDirections);
+    } /* for(i..) */
+    // The cells that can hold a sample within min_dist_: the 5x5 block
+    // without its corners, nearest first so that a conflict is found early
+    int n = 0;
+    for (int ring = 0; ring <= 8; ++ring) {
+      for (int dy = -2; dy <= 2; ++dy) {
+        for (int dx = -2; dx <= 2; ++dx) {
+          if (dx * dx + dy * dy == ring && ring != 8) {
+            neighbours_[n++] = dy * stride_ + dx;
+          }
+        } /* for(dx..) */
+      } /* for(dy..) */
+    } /* for(ring..) */
+  }
+
+  /**
+   * @brief No sample may fall within radius of (x, y).
+   */
+  void KeepOut(double x, double y, double radius) {
+    keep_out_.push_back({x, y, radius * radius});
+  }
+
+  /**
+   * @brief Cover the whole area with samples, until no more fit.
+   *
+   * The area is filled one square tile of grid cells at a time, in row
+   * order. Growth is confined to the current tile, whose cells, and those of
+   * its already filled neighbours, stay in cache; letting one front wander
+   * over a million-sample grid is several times slower.
+   */
+  size_t Fill(void);
+
+  const std::vector<double>& xs(void) const { return xs_; }
+  const std::vector<double>& ys(void) const { return ys_; }
+
+ private:
+  PoissonDisk(const PoissonDisk& other) = delete;
+  PoissonDisk& operator=(const PoissonDisk& other) = delete;
+
+  struct disk {
+    double x, y, r2;
+  };
+  // The sample in a grid cell is kept in the cell itself rather than as an
+  // index, so a neighbourhood check reads five short runs of memory only.
+  // Single precision is plenty to tell whether two samples are too close.
+  struct cell {
+    float x, y;
+  };
+  static constexpr float kEmpty = -1e30f;
+
+  void FillTile(double x0, double y0, double x1, double y1);
+  bool Fits(double x, double y) const;
+  // The grid has a border of two empty cells, so neighbours need no clamping
+  size_t CellOf(double x, double y) const {
+    int cx = static_cast<int>((x - x_lo_) / cell_);
+    int cy = static_cast<int>((y - y_lo_) / cell_);
+    return static_cast<size_t>(cy + 2) * stride_ + cx + 2;
+  }
+  void Add(double x, double y) {
+    grid_[CellOf(x, y)] =
+        cell {static_cast<float>(x), static_cast<float>(y)};
+    xs_.push_back(x);
+    ys_.push_back(y);
+  }
+
+  double min_dist_;
+  double min_dist2_;
+  double cell_;
+  double x_lo_, y_lo_, x_hi_, y_hi_;
+  int cols_;
+  int rows_;
+  int stride_;
+  std::vector<cell> grid_;
+  int neighbours_[21];
+  double dir_x_[kDirections];
+  double dir_y_[kDirections];
+  std::vector<double> xs_;
+  std::vector<double> ys_;
+  std::vector<disk> keep_out_;
+  std::vector<uint32_t> active_;
+  SplitMix64 * rng_;
+};
+
+bool PoissonDisk::Fits(double x, double y) const {
+  for (const disk& k : keep_out_) {
+    double dx = x - k.x, dy = y - k.y;
+    if (dx * dx + dy * dy < k.r2) {
+      return false;
+    }
+  } /* for(k..) */
+  const cell * c = &grid_[CellOf(x, y)];
+  for (int i = 0; i < 21; ++i) {
+    // Empty cells are far enough away to pass without a special case
+    const cell& other = c[neighbours_[i]];
+    double dx = x - other.x, dy = y - other.y;
+    if (dx * dx + dy * dy < min_dist2_) {
+      return false;
+    }
+  } /* for(i..) */
+  return true;
+} /* Fits() */
+
+void PoissonDisk::FillTile(double x0, double y0, double x1, double y1) {
+  for (int dart = 0; dart < kDarts; ++dart) {
+    double sx = x0 + rng_->Unit() * (x1 - x0);
+    double sy = y0 + rng_->Unit() * (y1 - y0);
+    if (!Fits(sx, sy)) {
+      continue;
+    }
+    active_.push_back(static_cast<uint32_t>(xs_.size()));
+    Add(sx, sy);
+
+    while (!active_.empty()) {
+      // Grow from the newest sample; its neighbourhood is the one in cache
+      uint32_t a = active_.back();
+      double px = xs_[a], py = ys_[a];
+      bool found = false;
+      for (int k = 0; k < kCandidates && !found; ++k) {
+        // At a distance in [min_dist_, 2 min_dist_), as in Bridson's paper,
+        // from one draw: the low bits pick the direction, the high ones the
+        // distance
+        uint64_t bits = rng_->Next();
+        double dist = min_dist_ * (1 + SplitMix64::ToUnit(bits));
+        int dir = bits & (kDirections - 1);
+        double qx = px + dir_x_[dir] * dist, qy = py + dir_y_[dir] * dist;
+        if (qx >= x0 && qx < x1 && qy >= y0 && qy < y1 && Fits(qx, qy)) {
+          active_.push_back(static_cast<uint32_t>(xs_.size()));
+          Add(qx, qy);
+          found = true;
+        }
+      } /* for(k..) */
+      if (!found) {
+        active_.pop_back();
+      }
+    } /* while(active_..) */
+  } /* for(dart..) */
+} /* FillTile() */
+
+size_t PoissonDisk::Fill(void) {
+  double tile = kTileCells * cell_;
+  for (double ty = y_lo_; ty < y_hi_; ty += tile) {
+    for (double tx = x_lo_; tx < x_hi_; tx += tile) {
+      FillTile(tx, ty, std::min(tx + tile, x_hi_), std::min(ty + tile, y_hi_));
+    } /* for(tx..) */
+  } /* for(ty..) */
+  return xs_.size();
+} /* Fill() */
+
+}  // namespace
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+bool GenerateArenaParams(const struct arena_generator_params * gparams,
+                         struct arena_params * aparams, size_t * placed,
+                         std::string * error) {
+  *placed = 0;
+  DefaultArenaParams(aparams);
+  aparams->obstacles.clear();
+  aparams->home_base.seed = gparams->seed;
+  SplitMix64 rng(gparams->seed);
+
+  // The gap between obstacles, and between an obstacle and anything else,
+  // is wide enough for the robot to pass through
+  const robot_params& robot = aparams->robot;
+  double r = gparams->obstacle_radius;
+  double gap = 2 * (robot.radius + robot.collision_delta) + 1;
+  double spacing = 2 * r + gap;
+
+  if (gparams->x_dim && gparams->y_dim) {
+    aparams->x_dim = gparams->x_dim;
+    aparams->y_dim = gparams->y_dim;
+  } else {
+    double area = gparams->n_obstacles * spacing * spacing * kAreaPerObstacle;
+    double width = std::sqrt(area * 4 / 3) + 2 * (r + gap);
+    aparams->x_dim = std::max(aparams->x_dim,
+                              static_cast<uint>(std::ceil(width)));
+    aparams->y_dim = std::max(aparams->y_dim,
+                              static_cast<uint>(std::ceil(width * 3 / 4)));
+  }
+  double w = aparams->x_dim, h = aparams->y_dim;
+
+  // Scatter the robot, home base and recharge station, apart from each other
+  arena_entity_params * special[] = {
+    &aparams->robot, &aparams->home_base, &aparams->recharge_station
+  };
+  const char * names[] = {"robot", "home base", "recharge station"};
+  for (int i = 0; i < 3; ++i) {
+    double sr = special[i]->radius;
+    if (w <= 2 * (sr + gap) || h <= 2 * (sr + gap)) {
+      if (error) {
+        *error = std::string("arena too small for the ") + names[i];
+      }
+      return false;
+    }
+    double x = 0, y = 0;
+    bool clear = false;
+    for (int tries = 0; tries < kPlacementTries && !clear; ++tries) {
+      x = sr + gap + rng.Unit() * (w - 2 * (sr + gap));
+      y = sr + gap + rng.Unit() * (h - 2 * (sr + gap));
+      clear = true;
+      for (int j = 0; j < i; ++j) {
+        double dx = x - RealToDouble(special[j]->pos.x);
+        double dy = y - RealToDouble(special[j]->pos.y);
+        double apart = sr + special[j]->radius + 2 * gap;
+        clear = clear && dx * dx + dy * dy >= apart * apart;
+      } /* for(j..) */
+    } /* for(tries..) */
+    if (!clear) {
+      if (error) {
+        *error = std::string("no room for the ") + names[i] +
+            " apart from the others";
+      }
+      return false;
+    }
+    special[i]->pos = Position(x, y);
+  } /* for(i..) */
+
+  PoissonDisk sampler(spacing, r + gap, r + gap, w - r - gap, h - r - gap,
+                      &rng);
+  for (int i = 0; i < 3; ++i) {
+    sampler.KeepOut(RealToDouble(special[i]->pos.x),
+                    RealToDouble(special[i]->pos.y),
+                    special[i]->radius + r + gap);
+  } /* for(i..) */
+  size_t total = sampler.Fill();
+
+  // Keep a random n of the samples, in the order they were made, so that a
+  // partly filled arena is still evenly covered
+  size_t n = std::min(gparams->n_obstacles, total);
+
+  arena_entity_params o;
+  o.radius = r;
+  o.color = Color(255, 255, 255, 255); /* white */
+  aparams->obstacles.resize(n, o);
+  // Selection sampling (Knuth's Algorithm S): one pass, order kept
+  for (size_t i = 0, kept = 0; kept < n; ++i) {
+    if ((total - i) * rng.Unit() < n - kept) {
+      aparams->obstacles[kept++].pos = Position(sampler.xs()[i],
+                                                sampler.ys()[i]);
+    }
+  } /* for(i..) */
+  *placed = n;
+  return true;
+} /* GenerateArenaParams() */
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,69 @@
+/**
+ * @file arena_generator.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_ARENA_GENERATOR_H_
+#define SRC_ARENA_GENERATOR_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stddef.h>
+#include <string>
+#include "src/common.h"
+#include "src/arena_params.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief What to generate. x_dim/y_dim of 0 size the arena (4:3) so that
+ * n_obstacles fit.
+ */
+struct arena_generator_params {
+  arena_generator_params(void) :
+      n_obstacles(), obstacle_radius(5.0), seed(1), x_dim(), y_dim() {}
+
+  size_t n_obstacles;
+  double obstacle_radius;
+  unsigned seed;
+  uint x_dim;
+  uint y_dim;
+};
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief Fill in a random arena with up to gparams->n_obstacles obstacles.
+ *
+ * The robot, home base and recharge station are those of
+ * DefaultArenaParams(), placed at random. Obstacles are scattered with a
+ * Poisson-disk sampler (Bridson's algorithm over a background grid), so no
+ * two are closer than the robot can pass between, and none is closer to a
+ * wall or to the robot, home base or recharge station than that. The free
+ * space is therefore connected: everything is reachable, and the robot
+ * starts clear.
+ *
+ * The same seed gives the same arena, and also seeds the home base. If the
+ * arena is too small for n_obstacles, it is filled and fewer are placed.
+ *
+ * @param[out] placed The number of obstacles placed.
+ *
+ * @return false, with *error set, if the arena given is too small to place
+ * the robot, home base and recharge station apart from each other.
+ */
+bool GenerateArenaParams(const struct arena_generator_params * gparams,
+                         struct arena_params * aparams, size_t * placed,
+                         std::string * error);
+
+NAMESPACE_END(csci3081);
+
+#endif /* SRC_ARENA_GENERATOR_H_ */
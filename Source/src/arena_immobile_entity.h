@@ -22,19 +22,13 @@ NAMESPACE_BEGIN(csci3081);
  * Class Definitions
  ******************************************************************************/
  /**
- * @brief Base-class representing an ArenaEntity that can't move.
- *
- * Same members as ArenaEntity with the addition of a
- * function is_mobile(). This allows us to define which entities in
- * the arena can move. 
+ * @brief A view of an entity that can't move: it has a transform and a
+ * renderable, but no kinematics.
  */
 class ArenaImmobileEntity : public ArenaEntity {
  public:
-  ArenaImmobileEntity(double radius, const Position& pos,
-                    const Color& color) :
-      ArenaEntity(radius, pos, color) {}
-
-  bool is_mobile(void) { return false; }
+  ArenaImmobileEntity(Registry * registry, entity_id id) :
+      ArenaEntity(registry, id) {}
 };
 
 NAMESPACE_END(csci3081);
@@ -8,7 +8,6 @@
  * Includes
  ******************************************************************************/
 #include "src/arena_mobile_entity.h"
-#include "src/robot_motion_behavior.h"
 
 /*******************************************************************************
  * Namespaces
@@ -18,16 +17,17 @@ NAMESPACE_BEGIN(csci3081);
 /*******************************************************************************
  * Member Functions
  ******************************************************************************/
-/**
-* @brief Update position of this class by instantiating a
-* RobotMotionBehavior object and calling UpdatePosition() on that
-* object, passing in a pointer to this class and dt to UpdatePosition().
-*
-* @param[in] dt uint representing change in time
-*/
-void ArenaMobileEntity::TimestepUpdate(uint dt) {
-  RobotMotionBehavior h;
-  h.UpdatePosition(this, dt);
-} /* TimestepUpdate() */
+entity_id ArenaMobileEntity::SpawnMobile(Registry * registry,
+                                         enum entity_kind kind,
+                                         real_t radius,
+                                         real_t collision_delta,
+                                         const Position& pos,
+                                         const Color& color) {
+  entity_id e = Spawn(registry, kind, radius, pos, color);
+  registry->kinematics_pool().Add(e, kinematics {RobotMotionHandler(),
+                                                 collision_delta});
+  registry->touch_sensor_pool().Add(e, SensorTouch());
+  return e;
+} /* SpawnMobile() */
 
 NAMESPACE_END(csci3081);
@@ -10,12 +10,10 @@
 /*******************************************************************************
  * Includes
  ******************************************************************************/
-#include <algorithm>
 #include "src/arena_entity.h"
-#include "src/event_base_class.h"
-#include "src/event_recharge.h"
 #include "src/event_collision.h"
 #include "src/color.h"
+#include "src/vector2.h"
 
 /*******************************************************************************
  * Namespaces
@@ -26,31 +24,43 @@ NAMESPACE_BEGIN(csci3081);
  * Class Definitions
  ******************************************************************************/
  /**
- * @brief Base class representing an ArenaEntity that can move.
+ * @brief A view of an entity that can move, i.e. one with kinematics and a
+ * touch sensor.
  *
- * This class contains members that are integral to motion in the
- * arena, such as heading angle, and speed. It also introduces
- * the Accept() functions, which are overloaded to do different things
- * depending on the type of parameter passed.
+ * Motion code uses get_direction(), a unit vector; the heading angle
+ * accessors are kept for the UI and for callers that think in degrees.
  */
 class ArenaMobileEntity : public ArenaEntity {
  public:
-  ArenaMobileEntity(double radius, double collision_delta,
-                    const Position& pos, const Color& color) :
-      ArenaEntity(radius, pos, color),
-      collision_delta_(collision_delta) {}
-  bool is_mobile(void) { return true; }
-  virtual double get_heading_angle(void) const = 0;
-  virtual void set_heading_angle(double heading_angle) = 0;
-  virtual double get_speed(void) = 0;
-  virtual void set_speed(double sp) = 0;
-  double get_collision_delta(void) const { return collision_delta_; }
-  void TimestepUpdate(uint dt);
-  virtual void Accept(EventCollision * e) = 0;
-  virtual void Accept(EventRecharge * e) = 0;
-
- private:
-  double collision_delta_;
+  ArenaMobileEntity(Registry * registry, entity_id id) :
+      ArenaEntity(registry, id) {}
+
+  double get_heading_angle(void) const { return motion().heading_angle(); }
+  void set_heading_angle(double ha) { motion().heading_angle(ha); }
+  const Vector2& get_direction(void) const { return motion().direction(); }
+  real_t get_speed(void) const { return motion().speed(); }
+  void set_speed(real_t sp) { motion().speed(sp); }
+  real_t get_collision_delta(void) const {
+    return registry_->kinematics_pool().Get(id_).collision_delta;
+  }
+
+ protected:
+  /**
+   * @brief Create a new entity that also has kinematics and a touch sensor.
+   */
+  static entity_id SpawnMobile(Registry * registry, enum entity_kind kind,
+                               real_t radius, real_t collision_delta,
+                               const Position& pos, const Color& color);
+
+  RobotMotionHandler& motion(void) {
+    return registry_->kinematics_pool().Get(id_).motion;
+  }
+  const RobotMotionHandler& motion(void) const {
+    return registry_->kinematics_pool().Get(id_).motion;
+  }
+  SensorTouch& sensor_touch(void) {
+    return registry_->touch_sensor_pool().Get(id_);
+  }
 };
 
 NAMESPACE_END(csci3081);
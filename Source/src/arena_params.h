@@ -11,6 +11,7 @@
 /*******************************************************************************
  * Includes
  ******************************************************************************/
+#include <vector>
 #include "src/robot_params.h"
 #include "src/home_base_params.h"
 
@@ -19,10 +20,9 @@
  ******************************************************************************/
 NAMESPACE_BEGIN(csci3081);
 
-/*******************************************************************************
- * Constant Definitions
- ******************************************************************************/
-#define MAX_OBSTACLES 8
+class FlowField;
+class StaticMap;
+class VisibilityGraph;
 
 /*******************************************************************************
  * Structure Definitions
@@ -35,13 +35,48 @@ NAMESPACE_BEGIN(csci3081);
  * parameters of different types of objects in one place.
  */
 struct arena_params {
+  arena_params(void) :
+      robot(),
+      recharge_station(),
+      home_base(),
+      obstacles(),
+      extra_robots(),
+      extra_recharge_stations(),
+      x_dim(),
+      y_dim(),
+      static_map(nullptr),
+      planner(nullptr),
+      flow_field(nullptr) {}
+  // Copies share what the pointers below point to; none of it is owned.
+  // Declaring the copies hides the implicit moves, so they are declared too.
+  arena_params(const arena_params& other) = default;
+  arena_params(arena_params&& other) = default;
+  arena_params& operator=(const arena_params& other) = default;
+  arena_params& operator=(arena_params&& other) = default;
+
   struct robot_params robot;
   struct arena_entity_params recharge_station;
   struct home_base_params home_base;
-  struct arena_entity_params obstacles[MAX_OBSTACLES];
-  size_t n_obstacles;
+  std::vector<struct arena_entity_params> obstacles;
+  // Further robots and recharge stations, spawned after the obstacles. The
+  // robot and recharge_station above are the player's.
+  std::vector<struct robot_params> extra_robots;
+  std::vector<struct arena_entity_params> extra_recharge_stations;
   uint x_dim;
   uint y_dim;
+  // Obstacles compiled ahead of time, checked alongside the ones above. Not
+  // owned; it must outlive the Arena.
+  const StaticMap * static_map;
+  // Autopilot paths are planned on this graph, if given, instead of one the
+  // Arena builds itself. It should have been built from the same obstacles.
+  // Not owned; it can be shared by many Arenas, on any threads.
+  const VisibilityGraph * planner;
+  // Robots in AUTOPILOT_FLOW mode head for the HomeBase by this field, if
+  // given, instead of one the Arena builds itself. It should have been
+  // built from the same obstacles. Not owned; each step brings it up to
+  // date, so Arenas sharing it must be stepped one at a time (e.g. the
+  // games of a run, one after another).
+  FlowField * flow_field;
 };
 
 NAMESPACE_END(csci3081);
@@ -0,0 +1,92 @@
+/**
+ * @file bump_allocator.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/bump_allocator.h"
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <new>
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+BumpAllocator::BumpAllocator(size_t block_size) :
+  block_size_(block_size), blocks_(), current_(0), offset_(0), retired_(0) {}
+
+BumpAllocator::~BumpAllocator(void) {
+  for (auto& b : blocks_) {
+    ::operator delete(b.data);
+  } /* for(b..) */
+}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void * BumpAllocator::Allocate(size_t size, size_t align) {
+  for (;;) {
+    if (current_ == blocks_.size()) {
+      size_t n = std::max(block_size_, size + align);
+      blocks_.push_back(block {static_cast<char*>(::operator new(n)), n});
+    }
+    block& b = blocks_[current_];
+    uintptr_t base = reinterpret_cast<uintptr_t>(b.data);
+    uintptr_t start = ((base + offset_ + align - 1) & ~(align - 1)) - base;
+    if (start + size <= b.size) {
+      offset_ = start + size;
+      return b.data + start;
+    }
+    // Does not fit; continue in the next block, or a new one
+    retired_ += offset_;
+    offset_ = 0;
+    ++current_;
+  } /* for(;;) */
+} /* Allocate() */
+
+const char * BumpAllocator::Format(const char * fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  va_list measure;
+  va_copy(measure, args);
+  int len = vsnprintf(nullptr, 0, fmt, measure);
+  va_end(measure);
+  if (len < 0) {
+    va_end(args);
+    return "";
+  }
+  char * buf = AllocateArray<char>(len + 1);
+  vsnprintf(buf, len + 1, fmt, args);
+  va_end(args);
+  return buf;
+} /* Format() */
+
+void BumpAllocator::Reset(void) {
+  current_ = 0;
+  offset_ = 0;
+  retired_ = 0;
+} /* Reset() */
+
+size_t BumpAllocator::used(void) const {
+  return retired_ + offset_;
+} /* used() */
+
+size_t BumpAllocator::capacity(void) const {
+  size_t total = 0;
+  for (auto& b : blocks_) {
+    total += b.size;
+  } /* for(b..) */
+  return total;
+} /* capacity() */
+
+NAMESPACE_END(csci3081);
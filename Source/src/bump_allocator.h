@@ -0,0 +1,82 @@
+/**
+ * @file bump_allocator.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_BUMP_ALLOCATOR_H_
+#define SRC_BUMP_ALLOCATOR_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstddef>
+#include <vector>
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Monotonic memory for short-lived temporaries.
+ *
+ * Allocate() hands out memory by bumping an offset into a block; nothing is
+ * freed individually. Reset() rewinds to the first block but keeps every
+ * block, so a workload that needs the same amount of memory each round
+ * allocates from the system only while warming up.
+ *
+ * Only trivially destructible objects belong here, since no destructors are
+ * run.
+ */
+class BumpAllocator {
+ public:
+  static const size_t kDefaultBlockSize = 16 * 1024;
+
+  explicit BumpAllocator(size_t block_size = kDefaultBlockSize);
+  ~BumpAllocator(void);
+
+  void * Allocate(size_t size, size_t align = alignof(std::max_align_t));
+
+  template <typename T>
+  T * AllocateArray(size_t n) {
+    return static_cast<T*>(Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  /**
+   * @brief printf into memory from this allocator.
+   */
+  const char * Format(const char * fmt, ...)
+      __attribute__((format(printf, 2, 3)));
+
+  /**
+   * @brief Forget everything allocated. The blocks are kept for reuse.
+   */
+  void Reset(void);
+
+  size_t used(void) const;
+  size_t capacity(void) const;
+
+ private:
+  struct block {
+    char * data;
+    size_t size;
+  };
+
+  BumpAllocator(const BumpAllocator& other) = delete;
+  BumpAllocator& operator=(const BumpAllocator& other) = delete;
+
+  size_t block_size_;
+  std::vector<block> blocks_;
+  size_t current_;  // index into blocks_ being bumped
+  size_t offset_;   // bytes used in blocks_[current_]
+  size_t retired_;  // bytes used in the blocks before current_
+};
+
+NAMESPACE_END(csci3081);
+
+#endif /* SRC_BUMP_ALLOCATOR_H_ */
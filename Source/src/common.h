@@ -16,14 +16,32 @@
 // This should be placed in front of any variable defined but not used to
 // satisfy the compiler - otherwise a warning is given.
 #define __unused __attribute__((unused))
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+// Included after the macros above, which numeric.h relies on.
+#include "src/numeric.h"
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
 /**
 * @brief Position structure containing two values, x and y.
+*
+* Coordinates use the simulation scalar (double, or Fixed when built with
+* ARENA_FIXED_POINT), so motion updates are no longer truncated to whole
+* pixels.
 */
 struct Position {
 Position(void) : x(0), y(0) { }
-Position(int in_x, int in_y) : x(in_x), y(in_y) { }
-  int x;
-  int y;
+Position(csci3081::real_t in_x, csci3081::real_t in_y) : x(in_x), y(in_y) { }
+  csci3081::real_t x;
+  csci3081::real_t y;
 };
 
+inline bool operator==(const Position& a, const Position& b) {
+  return a.x == b.x && a.y == b.y;
+}
+
 #endif  // SRC_COMMON_H_
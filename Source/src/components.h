@@ -0,0 +1,130 @@
+/**
+ * @file components.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_COMPONENTS_H_
+#define SRC_COMPONENTS_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <memory>
+#include <random>
+#include <vector>
+#include "src/common.h"
+#include "src/color.h"
+#include "src/incremental_planner.h"
+#include "src/robot_battery.h"
+#include "src/robot_motion_handler.h"
+#include "src/sensor_lidar.h"
+#include "src/sensor_touch.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief Where an entity is and how big it is. Every entity has one.
+ */
+struct transform {
+  Position pos;
+  real_t radius;
+};
+
+/**
+ * @brief Heading and speed of an entity that moves, plus the buffer used
+ * when testing it for collisions.
+ */
+struct kinematics {
+  RobotMotionHandler motion;
+  real_t collision_delta;
+};
+
+/**
+ * @brief A robot's battery. on_charger is set while the robot touches a
+ * RechargeStation, so that touching it does not also drain the battery.
+ */
+struct battery {
+  RobotBattery cell;
+  bool on_charger;
+};
+
+/**
+ * @brief The touch sensor that collision events are delivered to.
+ */
+typedef SensorTouch touch_sensor;
+
+/**
+ * @brief A range sensor, read every step by Arena::LidarSystem().
+ */
+typedef SensorLidar lidar;
+
+/**
+ * @brief Where an autopilot steers its robot.
+ */
+enum autopilot_goal {
+  AUTOPILOT_HOME_BASE,
+  AUTOPILOT_RECHARGE_STATION
+};
+
+/**
+ * @brief How an autopilot finds its way: along a path planned for it alone
+ * now and then, along one repaired for it every step, or by the flow field
+ * toward its goal that all such robots share.
+ */
+enum autopilot_mode {
+  AUTOPILOT_PLAN,
+  AUTOPILOT_TRACK,
+  AUTOPILOT_FLOW
+};
+
+/**
+ * @brief Steering along a planned path instead of by arrow keys. path is
+ * what is left of the last plan and next the waypoint being steered for; the
+ * plan is redone when replan_in runs out, since the HomeBase moves. In
+ * AUTOPILOT_TRACK mode the path is found again every step by the robot's own
+ * tracker, which keeps its search from one step to the next. A robot in
+ * AUTOPILOT_FLOW mode has no path of its own.
+ */
+struct autopilot {
+  enum autopilot_goal goal;
+  enum autopilot_mode mode;
+  std::vector<Position> path;
+  size_t next;
+  unsigned replan_in;
+  std::shared_ptr<IncrementalPlanner> tracker;
+};
+
+/**
+ * @brief Steering around other entities before moving, by
+ * Arena::AvoidanceSystem(). velocity is what the entity moves by this step
+ * instead of along its heading at its speed, which are left as its
+ * controller set them.
+ */
+struct avoidance {
+  Vector2 velocity;
+};
+
+/**
+ * @brief How the viewer draws an entity.
+ */
+struct renderable {
+  Color color;
+};
+
+/**
+ * @brief Random turning, as done by the HomeBase.
+ */
+struct wander {
+  std::minstd_rand0 generator;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif /* SRC_COMPONENTS_H_ */
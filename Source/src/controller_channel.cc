@@ -0,0 +1,231 @@
+/**
+ * @file controller_channel.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/controller_channel.h"
+#include <string.h>
+#include <sys/mman.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include <algorithm>
+#include <thread>
+#include "src/arena.h"
+#include "src/shared_memory.h"
+#include "src/trace.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constant Definitions
+ ******************************************************************************/
+// Polls of the command rings before Collect() starts giving up the CPU
+static const int kSpinsBeforeYield = 2000;
+
+static_assert((kControllerRingSize & (kControllerRingSize - 1)) == 0,
+              "kControllerRingSize must be a power of two");
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2,
+              "the ring counts must be lock-free to be shared");
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief Let the other hyperthread of the core run while spinning.
+ */
+static inline void CpuRelax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  _mm_pause();
+#endif
+} /* CpuRelax() */
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+ControllerHost::ControllerHost(void) : channels_() {}
+
+ControllerHost::~ControllerHost(void) {
+  for (std::unique_ptr<channel>& c : channels_) {
+    munmap(c->mapping, sizeof(controller_channel));
+    shm_unlink(c->name.c_str());
+  } /* for(c..) */
+}
+
+ControllerClient::ControllerClient(void) : mapping_(nullptr),
+                                           mapping_size_(0) {}
+
+ControllerClient::~ControllerClient(void) { Detach(); }
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+bool ControllerHost::Add(const char * name, entity_id robot,
+                         std::string * error) {
+  // A fresh object, so a controller still attached to an old one notices
+  // nothing ever arrives rather than reading half of a new one
+  void * p = CreateShared(name, sizeof(controller_channel), 0600, error);
+  if (!p) {
+    return false;
+  }
+  // The new memory is zero, so both rings start empty
+  controller_channel * mapping = static_cast<controller_channel *>(p);
+  memcpy(mapping->magic, CONTROLLER_CHANNEL_MAGIC, sizeof(mapping->magic));
+  mapping->version = CONTROLLER_CHANNEL_VERSION;
+  mapping->obs_size = OBS_SIZE;
+  mapping->ring_size = kControllerRingSize;
+  std::atomic_thread_fence(std::memory_order_release);
+
+  std::unique_ptr<channel> c(new channel);
+  c->name = name;
+  c->mapping = mapping;
+  c->robot = robot;
+  channels_.push_back(std::move(c));
+  return true;
+} /* Add() */
+
+void ControllerHost::Send(const Arena& arena, uint64_t step,
+                          uint64_t budget_ns) {
+  uint64_t now = Tracer::NowNs();
+  controller_observation obs;
+  memset(&obs, 0, sizeof(obs));
+  obs.step = step;
+  obs.sent_ns = now;
+  obs.deadline_ns = now + budget_ns;
+  obs.game_over = arena.getGameStatus() ? 1 : 0;
+  for (std::unique_ptr<channel>& c : channels_) {
+    c->due = true;
+    c->answered = false;
+    c->step = step;
+    c->sent_ns = now;
+    c->deadline_ns = obs.deadline_ns;
+    c->sent = false;
+    if (!arena.registry().kinematics_pool().Has(c->robot)) {
+      continue;
+    }
+    obs.robot = c->robot;
+    ObserveRobot(arena, c->robot, obs.observation);
+    c->sent = c->mapping->observations.Push(obs);
+    if (!c->sent) {
+      ++c->stats.dropped;
+    }
+  } /* for(c..) */
+} /* Send() */
+
+bool ControllerHost::Drain(channel * c, uint64_t now_ns) {
+  controller_command cmd;
+  while (c->mapping->commands.Pop(&cmd)) {
+    // Whatever the other process wrote, only real commands are applied
+    c->last = (cmd.command >= COM_TURN_LEFT && cmd.command <= COM_NONE) ?
+        static_cast<enum event_commands>(cmd.command) : COM_NONE;
+    if (c->sent && !c->answered && cmd.step == c->step &&
+        cmd.sent_ns == c->sent_ns) {
+      uint64_t round_trip = now_ns - c->sent_ns;
+      c->answered = true;
+      ++c->stats.answered;
+      c->stats.round_trip_ns += round_trip;
+      c->stats.max_round_trip_ns =
+          std::max(c->stats.max_round_trip_ns, round_trip);
+    } else {
+      ++c->stats.late;
+    }
+  } /* while() */
+  return c->answered;
+} /* Drain() */
+
+void ControllerHost::Collect(Arena * arena) {
+  // Spin rather than sleep: the budget is usually microseconds, far less
+  // than the scheduler would take to wake the thread again. Past a few
+  // microseconds, yield too, in case a controller shares this core.
+  for (int spins = 0; ; ++spins) {
+    uint64_t now = Tracer::NowNs();
+    bool waiting = false;
+    for (std::unique_ptr<channel>& c : channels_) {
+      if (!Drain(c.get(), now) && c->sent && now < c->deadline_ns) {
+        waiting = true;
+      }
+    } /* for(c..) */
+    if (!waiting) {
+      break;
+    }
+    CpuRelax();
+    if (spins >= kSpinsBeforeYield) {
+      std::this_thread::yield();
+    }
+  } /* for(spins..) */
+
+  for (std::unique_ptr<channel>& c : channels_) {
+    if (c->due && !c->answered) {
+      ++c->stats.missed;
+    }
+    c->due = false;
+    if (c->last != COM_NONE &&
+        arena->registry().kinematics_pool().Has(c->robot)) {
+      arena->event_bus().commands().Push(
+          command_record {c->robot, EventCommand(c->last)});
+    }
+  } /* for(c..) */
+} /* Collect() */
+
+bool ControllerClient::Attach(const char * name, std::string * error) {
+  Detach();
+  size_t size = 0;
+  void * p = AttachShared(name, true, sizeof(controller_channel),
+                          "truncated controller channel", &size, error);
+  if (!p) {
+    return false;
+  }
+  const controller_channel * mapping =
+      static_cast<const controller_channel *>(p);
+  const char * reason = nullptr;
+  if (memcmp(mapping->magic, CONTROLLER_CHANNEL_MAGIC,
+             sizeof(mapping->magic)) != 0) {
+    reason = "not a controller channel";
+  } else if (mapping->version != CONTROLLER_CHANNEL_VERSION ||
+             mapping->obs_size != OBS_SIZE ||
+             mapping->ring_size != kControllerRingSize) {
+    reason = "unsupported controller channel version";
+  }
+  if (reason) {
+    munmap(p, size);
+    return ShmFail(error, name, reason);
+  }
+  mapping_ = static_cast<controller_channel *>(p);
+  mapping_size_ = size;
+  return true;
+} /* Attach() */
+
+void ControllerClient::Detach(void) {
+  if (mapping_) {
+    munmap(mapping_, mapping_size_);
+  }
+  mapping_ = nullptr;
+  mapping_size_ = 0;
+} /* Detach() */
+
+bool ControllerClient::Receive(struct controller_observation * out) {
+  bool any = false;
+  while (mapping_->observations.Pop(out)) {
+    any = true;
+  } /* while() */
+  return any;
+} /* Receive() */
+
+bool ControllerClient::Reply(const struct controller_observation& observation,
+                             enum event_commands command) {
+  controller_command cmd;
+  cmd.step = observation.step;
+  cmd.sent_ns = observation.sent_ns;
+  cmd.command = command;
+  cmd.reserved = 0;
+  return mapping_->commands.Push(cmd);
+} /* Reply() */
+
+NAMESPACE_END(csci3081);
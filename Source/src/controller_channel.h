@@ -0,0 +1,264 @@
+/**
+ * @file controller_channel.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_CONTROLLER_CHANNEL_H_
+#define SRC_CONTROLLER_CHANNEL_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include "src/common.h"
+#include "src/event_commands.h"
+#include "src/registry.h"
+#include "src/vec_arena.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constant Definitions
+ ******************************************************************************/
+#define CONTROLLER_CHANNEL_MAGIC "ARCC"
+#define CONTROLLER_CHANNEL_VERSION 1
+
+// Messages each direction of a channel holds; a power of two
+static const uint32_t kControllerRingSize = 64;
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief What the simulation sends a controller before each step. Times are
+ * Tracer::NowNs(), which every process on the machine shares.
+ */
+struct controller_observation {
+  uint64_t step;
+  uint64_t sent_ns;
+  // The step runs without an answer that arrives after this
+  uint64_t deadline_ns;
+  uint32_t robot;
+  uint32_t game_over;
+  // As VecArena gives them, at the vec_arena_observation offsets
+  float observation[OBS_SIZE];
+};
+
+/**
+ * @brief A controller's answer to one observation.
+ */
+struct controller_command {
+  // The step and sent_ns of the observation answered
+  uint64_t step;
+  uint64_t sent_ns;
+  // One of event_commands; COM_NONE to do nothing
+  int32_t command;
+  uint32_t reserved;
+};
+
+/**
+ * @brief A single producer, single consumer queue of fixed size messages
+ * that lives in shared memory. Each side only writes its own count, and the
+ * two counts are on their own cache lines, so neither side ever waits on or
+ * interferes with the other beyond the lines a message touches.
+ */
+template <typename T>
+struct spsc_ring {
+  // Messages pushed so far; written only by the producer
+  alignas(64) std::atomic<uint64_t> head;
+  // Messages popped so far; written only by the consumer
+  alignas(64) std::atomic<uint64_t> tail;
+  alignas(64) T slots[kControllerRingSize];
+
+  /**
+   * @return false, leaving the ring as it was, if it is full.
+   */
+  bool Push(const T& item) {
+    uint64_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) >= kControllerRingSize) {
+      return false;
+    }
+    slots[h % kControllerRingSize] = item;
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @return false if the ring is empty.
+   */
+  bool Pop(T * out) {
+    uint64_t t = tail.load(std::memory_order_relaxed);
+    if (t == head.load(std::memory_order_acquire)) {
+      return false;
+    }
+    *out = slots[t % kControllerRingSize];
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+};
+
+/**
+ * @brief The shared memory of one controller: observations from the
+ * simulation and commands back.
+ */
+struct controller_channel {
+  char magic[4];
+  uint32_t version;
+  uint32_t obs_size;
+  uint32_t ring_size;
+  spsc_ring<controller_observation> observations;
+  spsc_ring<controller_command> commands;
+};
+
+/**
+ * @brief How one controller has kept up.
+ */
+struct controller_stats {
+  controller_stats(void) : answered(0), late(0), missed(0), dropped(0),
+                           round_trip_ns(0), max_round_trip_ns(0) {}
+
+  // Steps whose observation was answered before the deadline
+  uint64_t answered;
+  // Answers to anything but the step about to run, e.g. ones that came in
+  // after their step had run
+  uint64_t late;
+  // Steps run on the last command for want of an answer
+  uint64_t missed;
+  // Observations not sent because the controller had not read the ring
+  uint64_t dropped;
+  // Summed over the answered steps, from sending to receiving the answer
+  uint64_t round_trip_ns;
+  uint64_t max_round_trip_ns;
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+class Arena;
+
+/**
+ * @brief The simulation's end of the channels to controllers running in
+ * other processes, each steering one robot.
+ *
+ * Before each step, Send() gives every controller its robot's observation
+ * and a deadline, and Collect() queues their commands for the step. A
+ * controller that has not answered by the deadline gets its last command
+ * applied again, so a slow or dead controller costs the simulation at most
+ * the wait until the deadline, never more.
+ *
+ * Channels are bound to entity ids rather than to an arena, so they carry
+ * over to an arena built again from the same parameters.
+ */
+class ControllerHost {
+ public:
+  ControllerHost(void);
+  ~ControllerHost(void);
+
+  /**
+   * @brief Create the shared memory for a controller of robot, e.g.
+   * "/arena-ctl-0", for the controller's process to attach to.
+   */
+  bool Add(const char * name, entity_id robot, std::string * error);
+  size_t n_controllers(void) const { return channels_.size(); }
+  const std::string& name(size_t i) const { return channels_[i]->name; }
+  const controller_stats& stats(size_t i) const {
+    return channels_[i]->stats;
+  }
+
+  /**
+   * @brief Send each controller its robot's observation of the arena as it
+   * is now, due back within budget_ns.
+   */
+  void Send(const Arena& arena, uint64_t step, uint64_t budget_ns);
+
+  /**
+   * @brief Wait until every controller has answered the last Send() or its
+   * deadline has passed, whichever is sooner, and queue each one's command
+   * for arena's next step.
+   */
+  void Collect(Arena * arena);
+
+ private:
+  struct channel {
+    channel(void) : name(), mapping(nullptr), robot(kNoEntity), step(0),
+                    sent_ns(0), deadline_ns(0), due(false), sent(false),
+                    answered(false), last(COM_NONE), stats() {}
+    channel(const channel& other) = delete;
+    channel& operator=(const channel& other) = delete;
+
+    std::string name;
+    controller_channel * mapping;
+    entity_id robot;
+    // The observation last sent
+    uint64_t step;
+    uint64_t sent_ns;
+    uint64_t deadline_ns;
+    // Send() has run since the last Collect()
+    bool due;
+    // The observation made it into the ring
+    bool sent;
+    bool answered;
+    // Applied again each step the controller does not answer
+    enum event_commands last;
+    controller_stats stats;
+  };
+
+  /**
+   * @brief Take every command waiting from c; true once one answers the
+   * observation last sent.
+   */
+  bool Drain(channel * c, uint64_t now_ns);
+
+  ControllerHost& operator=(const ControllerHost& other) = delete;
+  ControllerHost(const ControllerHost& other) = delete;
+
+  std::vector<std::unique_ptr<channel>> channels_;
+};
+
+/**
+ * @brief A controller process's end of a channel.
+ */
+class ControllerClient {
+ public:
+  ControllerClient(void);
+  ~ControllerClient(void);
+
+  bool Attach(const char * name, std::string * error);
+  void Detach(void);
+  bool attached(void) const { return mapping_ != nullptr; }
+
+  /**
+   * @brief Take the newest observation waiting, skipping any older ones.
+   *
+   * @return false if there is none; never waits.
+   */
+  bool Receive(struct controller_observation * out);
+
+  /**
+   * @brief Answer an observation.
+   *
+   * @return false if the simulation has not taken enough of the earlier
+   * answers to make room.
+   */
+  bool Reply(const struct controller_observation& observation,
+             enum event_commands command);
+
+ private:
+  ControllerClient& operator=(const ControllerClient& other) = delete;
+  ControllerClient(const ControllerClient& other) = delete;
+
+  controller_channel * mapping_;
+  size_t mapping_size_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_CONTROLLER_CHANNEL_H_
@@ -0,0 +1,249 @@
+/**
+ * @file distance_field.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/distance_field.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constant Definitions
+ ******************************************************************************/
+// Squared distance standing in for "no occupied cell in this line"
+static const double kFar = 1e20;
+// Fewer lines than this per thread are not worth starting a thread for
+static const size_t kLinesPerThread = 64;
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief One dimension of the distance transform: d[q] = min over p of
+ * (q - p)^2 + f[p], by the lower envelope of the parabolas rooted at each p.
+ * v and z are scratch of n and n + 1 elements.
+ */
+static void Transform1D(const double * f, int n, double * d, int * v,
+                        double * z) {
+  const double inf = std::numeric_limits<double>::infinity();
+  int k = 0;
+  v[0] = 0;
+  z[0] = -inf;
+  z[1] = inf;
+  for (int q = 1; q < n; ++q) {
+    // Where q's parabola crosses that of the last one in the envelope
+    double s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) /
+        (2.0 * q - 2.0 * v[k]);
+    while (s <= z[k]) {
+      --k;
+      s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0 * q - 2.0 * v[k]);
+    }
+    ++k;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = inf;
+  } /* for(q..) */
+  k = 0;
+  for (int q = 0; q < n; ++q) {
+    while (z[k + 1] < q) {
+      ++k;
+    }
+    d[q] = (q - v[k]) * static_cast<double>(q - v[k]) + f[v[k]];
+  } /* for(q..) */
+} /* Transform1D() */
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+DistanceField::DistanceField(uint x_dim, uint y_dim, double cell_size,
+                             double max_distance) :
+  x_dim_(x_dim),
+  y_dim_(y_dim),
+  cell_(cell_size),
+  max_distance_(max_distance),
+  cols_(std::max(1u, static_cast<uint>(std::ceil(x_dim / cell_size)))),
+  rows_(std::max(1u, static_cast<uint>(std::ceil(y_dim / cell_size)))),
+  built_(false),
+  coverage_(static_cast<size_t>(cols_) * rows_, 0),
+  field_(static_cast<size_t>(cols_) * rows_,
+         static_cast<float>(max_distance)) {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void DistanceField::AddCircle(double x, double y, double radius) {
+  Rasterize(x, y, radius, 1);
+} /* AddCircle() */
+
+void DistanceField::RemoveCircle(double x, double y, double radius) {
+  Rasterize(x, y, radius, -1);
+} /* RemoveCircle() */
+
+void DistanceField::Build(void) {
+  WorkerPool pool(0);
+  Compute(0, 0, cols_, rows_, &pool);
+  built_ = true;
+} /* Build() */
+
+void DistanceField::Rasterize(double x, double y, double radius, int delta) {
+  int c0 = std::max(0, static_cast<int>(std::floor((x - radius) / cell_)));
+  int c1 = std::min(static_cast<int>(cols_) - 1,
+                    static_cast<int>(std::floor((x + radius) / cell_)));
+  int r0 = std::max(0, static_cast<int>(std::floor((y - radius) / cell_)));
+  int r1 = std::min(static_cast<int>(rows_) - 1,
+                    static_cast<int>(std::floor((y + radius) / cell_)));
+  // The cell holding the center always counts, so that obstacles smaller
+  // than a cell are not lost
+  int center_c = static_cast<int>(std::floor(x / cell_));
+  int center_r = static_cast<int>(std::floor(y / cell_));
+  for (int r = r0; r <= r1; ++r) {
+    for (int c = c0; c <= c1; ++c) {
+      double dx = (c + 0.5) * cell_ - x;
+      double dy = (r + 0.5) * cell_ - y;
+      if (dx * dx + dy * dy <= radius * radius ||
+          (c == center_c && r == center_r)) {
+        coverage_[static_cast<size_t>(r) * cols_ + c] += delta;
+      }
+    } /* for(c..) */
+  } /* for(r..) */
+  if (built_ && c0 <= c1 && r0 <= r1) {
+    int pad = static_cast<int>(std::ceil(max_distance_ / cell_)) + 1;
+    Compute(std::max(0, c0 - pad), std::max(0, r0 - pad),
+            std::min(static_cast<int>(cols_), c1 + 1 + pad),
+            std::min(static_cast<int>(rows_), r1 + 1 + pad), nullptr);
+  }
+} /* Rasterize() */
+
+void DistanceField::Compute(int c0, int r0, int c1, int r1,
+                            WorkerPool * pool) {
+  // Cells further out than max_distance cannot change the result
+  int pad = static_cast<int>(std::ceil(max_distance_ / cell_)) + 1;
+  int x0 = std::max(0, c0 - pad);
+  int y0 = std::max(0, r0 - pad);
+  int x1 = std::min(static_cast<int>(cols_), c1 + pad);
+  int y1 = std::min(static_cast<int>(rows_), r1 + pad);
+  int w = x1 - x0;
+  int h = y1 - y0;
+
+  // Squared distance (in cells) to the nearest occupied cell, and to the
+  // nearest free one
+  std::vector<double> outside(static_cast<size_t>(w) * h);
+  std::vector<double> inside(outside.size());
+  for (int r = 0; r < h; ++r) {
+    for (int c = 0; c < w; ++c) {
+      bool occupied = coverage_[static_cast<size_t>(y0 + r) * cols_ + x0 + c];
+      outside[static_cast<size_t>(r) * w + c] = occupied ? 0 : kFar;
+      inside[static_cast<size_t>(r) * w + c] = occupied ? kFar : 0;
+    } /* for(c..) */
+  } /* for(r..) */
+
+  int longest = std::max(w, h);
+  auto columns = [&](size_t, size_t begin, size_t end) {
+    std::vector<double> f(longest), d(longest), z(longest + 1);
+    std::vector<int> v(longest);
+    for (std::vector<double> * grid : {&outside, &inside}) {
+      for (int c = static_cast<int>(begin); c < static_cast<int>(end); ++c) {
+        for (int r = 0; r < h; ++r) {
+          f[r] = (*grid)[static_cast<size_t>(r) * w + c];
+        } /* for(r..) */
+        Transform1D(f.data(), h, d.data(), v.data(), z.data());
+        for (int r = 0; r < h; ++r) {
+          (*grid)[static_cast<size_t>(r) * w + c] = d[r];
+        } /* for(r..) */
+      } /* for(c..) */
+    } /* for(grid..) */
+  };
+  auto rows = [&](size_t, size_t begin, size_t end) {
+    std::vector<double> d(longest), z(longest + 1);
+    std::vector<int> v(longest);
+    for (std::vector<double> * grid : {&outside, &inside}) {
+      for (int r = static_cast<int>(begin); r < static_cast<int>(end); ++r) {
+        double * line = &(*grid)[static_cast<size_t>(r) * w];
+        Transform1D(line, w, d.data(), v.data(), z.data());
+        std::copy(d.begin(), d.begin() + w, line);
+      } /* for(r..) */
+    } /* for(grid..) */
+  };
+  ForRanges(pool, w, kLinesPerThread, columns);
+  ForRanges(pool, h, kLinesPerThread, rows);
+
+  for (int r = r0; r < r1; ++r) {
+    for (int c = c0; c < c1; ++c) {
+      size_t i = static_cast<size_t>(r - y0) * w + (c - x0);
+      double dist = (std::sqrt(outside[i]) - std::sqrt(inside[i])) * cell_;
+      field_[static_cast<size_t>(r) * cols_ + c] = static_cast<float>(
+          std::min(std::max(dist, -max_distance_), max_distance_));
+    } /* for(c..) */
+  } /* for(r..) */
+} /* Compute() */
+
+double DistanceField::GridSample(double x, double y, double * gx,
+                                 double * gy) const {
+  // Values sit at cell centers
+  double fx = std::min(std::max(x / cell_ - 0.5, 0.0), cols_ - 1.0);
+  double fy = std::min(std::max(y / cell_ - 0.5, 0.0), rows_ - 1.0);
+  uint c0 = std::min(static_cast<uint>(fx), cols_ > 1 ? cols_ - 2 : 0);
+  uint r0 = std::min(static_cast<uint>(fy), rows_ > 1 ? rows_ - 2 : 0);
+  uint c1 = std::min(c0 + 1, cols_ - 1);
+  uint r1 = std::min(r0 + 1, rows_ - 1);
+  double tx = fx - c0;
+  double ty = fy - r0;
+  double v00 = field_[r0 * cols_ + c0];
+  double v10 = field_[r0 * cols_ + c1];
+  double v01 = field_[r1 * cols_ + c0];
+  double v11 = field_[r1 * cols_ + c1];
+  *gx = ((v10 - v00) * (1 - ty) + (v11 - v01) * ty) / cell_;
+  *gy = ((v01 - v00) * (1 - tx) + (v11 - v10) * tx) / cell_;
+  return (v00 * (1 - tx) + v10 * tx) * (1 - ty) +
+      (v01 * (1 - tx) + v11 * tx) * ty;
+} /* GridSample() */
+
+double DistanceField::WallDistance(double x, double y, double * gx,
+                                   double * gy) const {
+  double d = x;
+  *gx = 1;
+  *gy = 0;
+  if (x_dim_ - x < d) {
+    d = x_dim_ - x;
+    *gx = -1;
+  }
+  if (y < d) {
+    d = y;
+    *gx = 0;
+    *gy = 1;
+  }
+  if (y_dim_ - y < d) {
+    d = y_dim_ - y;
+    *gx = 0;
+    *gy = -1;
+  }
+  return d;
+} /* WallDistance() */
+
+double DistanceField::Distance(double x, double y) const {
+  double gx, gy;
+  return std::min(GridSample(x, y, &gx, &gy), WallDistance(x, y, &gx, &gy));
+} /* Distance() */
+
+Vector2 DistanceField::Gradient(double x, double y) const {
+  double gx, gy, wx, wy;
+  double grid = GridSample(x, y, &gx, &gy);
+  double wall = WallDistance(x, y, &wx, &wy);
+  if (wall < grid) {
+    return wall < max_distance_ ? Vector2(wx, wy) : Vector2();
+  }
+  double len = std::sqrt(gx * gx + gy * gy);
+  return len > 0 ? Vector2(gx / len, gy / len) : Vector2();
+} /* Gradient() */
+
+NAMESPACE_END(csci3081);
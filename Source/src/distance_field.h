@@ -0,0 +1,119 @@
+/**
+ * @file distance_field.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_DISTANCE_FIELD_H_
+#define SRC_DISTANCE_FIELD_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include <vector>
+#include "src/common.h"
+#include "src/vector2.h"
+#include "src/worker_pool.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Signed distance to the nearest obstacle or wall, precomputed over a
+ * grid so that a query costs the same however many obstacles there are.
+ *
+ * Obstacles are rasterized into an occupancy grid (a cell is occupied while
+ * its center lies inside at least one obstacle) and the distance to the
+ * occupied cells is found with Felzenszwalb and Huttenlocher's linear-time
+ * Euclidean distance transform: once down every column, then along every
+ * row, each pass split across threads. Distances are kept only up to
+ * max_distance, so adding or removing an obstacle only recomputes the cells
+ * within max_distance of it.
+ *
+ * Walls are not rasterized; Distance() takes the nearer of the grid and the
+ * walls. Distances are positive outside obstacles and negative inside them
+ * or outside the arena, and accurate to about a cell.
+ */
+class DistanceField {
+ public:
+  /**
+   * @param[in] cell_size Grid spacing, in arena units.
+   * @param[in] max_distance Distances are clamped to +/- this.
+   */
+  DistanceField(uint x_dim, uint y_dim, double cell_size,
+                double max_distance);
+
+  /**
+   * @brief Add an obstacle. Build() must be called before the first query;
+   * after it, each Add/Remove updates the field right away.
+   */
+  void AddCircle(double x, double y, double radius);
+
+  /**
+   * @brief Remove an obstacle added with the same arguments.
+   */
+  void RemoveCircle(double x, double y, double radius);
+
+  /**
+   * @brief Compute the whole field from the obstacles added so far.
+   */
+  void Build(void);
+
+  /**
+   * @brief Bilinearly interpolated signed distance at (x, y).
+   */
+  double Distance(double x, double y) const;
+
+  /**
+   * @brief Unit vector pointing away from the nearest obstacle or wall, i.e.
+   * the direction in which Distance() grows fastest. Zero far from
+   * everything.
+   */
+  Vector2 Gradient(double x, double y) const;
+
+  double cell_size(void) const { return cell_; }
+  double max_distance(void) const { return max_distance_; }
+  uint cols(void) const { return cols_; }
+  uint rows(void) const { return rows_; }
+
+ private:
+  /**
+   * @brief Change the coverage of the cells under a circle, and update the
+   * field around it if it has been built.
+   */
+  void Rasterize(double x, double y, double radius, int delta);
+
+  /**
+   * @brief Recompute the cells in [c0, c1) x [r0, r1), split across pool's
+   * threads if it is not nullptr.
+   */
+  void Compute(int c0, int r0, int c1, int r1, WorkerPool * pool);
+
+  /**
+   * @brief The bilinear sample of the grid alone, and its gradient.
+   */
+  double GridSample(double x, double y, double * gx, double * gy) const;
+
+  double WallDistance(double x, double y, double * gx, double * gy) const;
+
+  double x_dim_;
+  double y_dim_;
+  double cell_;
+  double max_distance_;
+  uint cols_;
+  uint rows_;
+  bool built_;
+  // How many obstacles cover each cell, and the signed distance at its center
+  std::vector<uint16_t> coverage_;
+  std::vector<float> field_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif /* SRC_DISTANCE_FIELD_H_ */
@@ -33,7 +33,7 @@ class EventBaseClass {
    * stdout saying what happened, in order to aid debugging.
    *
    */
-  virtual void EmitMessage(void) = 0;
+  virtual void EmitMessage(void) const = 0;
 };
 
 NAMESPACE_END(csci3081);
@@ -0,0 +1,129 @@
+/**
+ * @file event_bus.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_EVENT_BUS_H_
+#define SRC_EVENT_BUS_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <functional>
+#include <vector>
+#include "src/common.h"
+#include "src/event_collision.h"
+#include "src/event_command.h"
+#include "src/event_game_over.h"
+#include "src/event_recharge.h"
+#include "src/registry.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief A queued event and the entity it is addressed to.
+ */
+struct collision_record {
+  entity_id target;
+  EventCollision event;
+};
+
+struct recharge_record {
+  entity_id target;
+  EventRecharge event;
+};
+
+struct command_record {
+  entity_id target;
+  EventCommand event;
+};
+
+struct game_over_record {
+  EventGameOver event;
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief A pooled array of one type of event, handed to every subscriber as a
+ * single batch.
+ *
+ * Producers Push() while the simulation detects things; Dispatch() then calls
+ * each subscriber once with the whole array and empties it. The array keeps
+ * its capacity, so once a run has warmed up queuing allocates nothing.
+ *
+ * Subscribers must not push to the queue that is being dispatched.
+ */
+template <typename T>
+class EventQueue {
+ public:
+  typedef std::function<void(const T * events, size_t n)> handler;
+
+  EventQueue(void) : events_(), handlers_() {}
+
+  void Push(const T& event) { events_.push_back(event); }
+  void Subscribe(const handler& h) { handlers_.push_back(h); }
+
+  void Dispatch(void) {
+    if (events_.empty()) {
+      return;
+    }
+    for (auto& h : handlers_) {
+      h(events_.data(), events_.size());
+    } /* for(h..) */
+    events_.clear();
+  }
+
+  void Clear(void) { events_.clear(); }
+  void Reserve(size_t n) { events_.reserve(n); }
+  size_t size(void) const { return events_.size(); }
+  size_t capacity(void) const { return events_.capacity(); }
+  const T * data(void) const { return events_.data(); }
+
+ private:
+  std::vector<T> events_;
+  std::vector<handler> handlers_;
+};
+
+/**
+ * @brief The queues through which the Arena delivers events.
+ *
+ * Collision, recharge, command and game over events each have their own
+ * queue. The Arena fills them during a step and dispatches them by type
+ * afterward; anything that wants to observe the events, e.g. a logger or a
+ * recorder, subscribes to the queue it cares about.
+ */
+class EventBus {
+ public:
+  EventBus(void) : collisions_(), recharges_(), commands_(), game_overs_() {}
+
+  EventQueue<collision_record>& collisions(void) { return collisions_; }
+  EventQueue<recharge_record>& recharges(void) { return recharges_; }
+  EventQueue<command_record>& commands(void) { return commands_; }
+  EventQueue<game_over_record>& game_overs(void) { return game_overs_; }
+
+  void Clear(void) {
+    collisions_.Clear();
+    recharges_.Clear();
+    commands_.Clear();
+    game_overs_.Clear();
+  }
+
+ private:
+  EventQueue<collision_record> collisions_;
+  EventQueue<recharge_record> recharges_;
+  EventQueue<command_record> commands_;
+  EventQueue<game_over_record> game_overs_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif /* SRC_EVENT_BUS_H_ */
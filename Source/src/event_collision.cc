@@ -21,7 +21,7 @@ NAMESPACE_BEGIN(csci3081);
 EventCollision::EventCollision() :
   collided_(false),
   point_of_contact_(0, 0),
-  angle_of_contact_(0) {
+  contact_() {
 }
 
 /*******************************************************************************
@@ -32,9 +32,10 @@ EventCollision::EventCollision() :
  * angle_of_contact_  of this object. Used primarily for debugging.
  *
  */
-void EventCollision::EmitMessage(void) {
-  printf("Collision event at point %d %d. Angle %f \n",
-  point_of_contact_.x, point_of_contact_.y, angle_of_contact_);
+void EventCollision::EmitMessage(void) const {
+  printf("Collision event at point %f %f. Angle %f \n",
+  RealToDouble(point_of_contact_.x), RealToDouble(point_of_contact_.y),
+  angle_of_contact());
 } /* EmitMessage() */
 
 NAMESPACE_END(csci3081);
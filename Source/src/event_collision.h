@@ -12,6 +12,7 @@
  ******************************************************************************/
 #include <stdlib.h>
 #include "src/event_base_class.h"
+#include "src/vector2.h"
 
 /*******************************************************************************
  * Namespaces
@@ -24,28 +25,32 @@ NAMESPACE_BEGIN(csci3081);
 /**
 * @brief Responsible for storing collision information, such as
 * the state of collision, along with point_of_contact_
-* and angle_of_contact_.
+* and the direction of contact.
 *
 * All three are used to calculate motion for
-* ArenaMobileEntity objects.
+* ArenaMobileEntity objects. The direction of contact is the unit vector from
+* the entity's center toward whatever it hit; angle_of_contact() exposes it in
+* degrees for callers outside the motion pipeline.
 */
 
 class EventCollision : public EventBaseClass {
  public:
   EventCollision();
-  void EmitMessage(void);
-  bool collided() { return collided_; }
+  void EmitMessage(void) const;
+  bool collided() const { return collided_; }
   void collided(bool c) { collided_ = c; }
-  Position point_of_contact() { return point_of_contact_; }
+  Position point_of_contact() const { return point_of_contact_; }
   void point_of_contact(Position p) { point_of_contact_ = p; }
-  double angle_of_contact() { return angle_of_contact_; }
-  void angle_of_contact(double aoc) { angle_of_contact_ = aoc; }
+  double angle_of_contact() const { return contact_.degrees(); }
+  void angle_of_contact(double aoc) { contact_.degrees(aoc); }
+  const Vector2& contact_direction() const { return contact_.vector(); }
+  void contact_direction(const Vector2& dir) { contact_.vector(dir); }
   void collided_with_wall(bool c) { collided_with_wall_ = c; }
-  bool collided_with_wall() { return collided_with_wall_; }
+  bool collided_with_wall() const { return collided_with_wall_; }
  private:
   bool collided_;
   Position point_of_contact_;
-  double angle_of_contact_;
+  Heading contact_;
 
   /* Variable used to determine whether or not the robot hit a wall or not.
   * Used in calculating whether or not the robot should lose battery when it hits obstacles.
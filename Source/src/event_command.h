@@ -30,7 +30,7 @@ class EventCommand : public EventBaseClass {
  public:
   explicit EventCommand(enum event_commands cmd) : cmd_(cmd) {}
 
-  void EmitMessage(void) { printf("Motion cmd %d received\n", cmd_); }
+  void EmitMessage(void) const { printf("Motion cmd %d received\n", cmd_); }
   enum event_commands cmd(void) const { return cmd_; }
 
  private:
@@ -25,7 +25,9 @@ enum event_commands {
   COM_TURN_LEFT,
   COM_TURN_RIGHT,
   COM_SPEED_UP,
-  COM_SLOW_DOWN
+  COM_SLOW_DOWN,
+  // Do nothing, e.g. for a learning agent's step without a key press
+  COM_NONE
 };
 NAMESPACE_END(csci3081);
 
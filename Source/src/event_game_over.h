@@ -0,0 +1,43 @@
+/**
+ * @file event_game_over.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_EVENT_GAME_OVER_H_
+#define SRC_EVENT_GAME_OVER_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include "src/event_base_class.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Raised when the robot reaches the HomeBase (a win) or runs out of
+ * battery (a loss). The Arena ends the game when it receives one.
+ */
+class EventGameOver : public EventBaseClass {
+ public:
+  explicit EventGameOver(bool won) : won_(won) {}
+
+  void EmitMessage(void) const {
+    printf(won_ ? "You win!\n\n" : "You lose!\n\n");
+  }
+  bool won(void) const { return won_; }
+
+ private:
+  bool won_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif /* SRC_EVENT_GAME_OVER_H_ */
@@ -32,7 +32,7 @@ class EventKeypress : public EventBaseClass {
  public:
   explicit EventKeypress(int key) : key_(key) {}
 
-  void EmitMessage(void) { printf("Keypress command received\n"); }
+  void EmitMessage(void) const { printf("Keypress command received\n"); }
 
   int get_key(void) const {return key_;}
   enum event_commands get_key_cmd() const;
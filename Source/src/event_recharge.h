@@ -30,7 +30,7 @@ class EventRecharge : public EventBaseClass {
  public:
   EventRecharge(void) {}
 
-  void EmitMessage(void) { printf("Robot Battery recharged!\n"); }
+  void EmitMessage(void) const { printf("Robot Battery recharged!\n"); }
 };
 
 NAMESPACE_END(csci3081);
@@ -0,0 +1,117 @@
+/**
+ * @file fixed_point.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/fixed_point.h"
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+// Polynomial coefficients in raw Q16, so that no floating point is involved
+// even when the constants are initialized.
+// sin(pi/2 * t) ~ t * (S1 + t^2 * (S3 + t^2 * (S5 + t^2 * (S7 + t^2 * S9))))
+static constexpr Fixed kS1 = Fixed::FromRaw(102944);
+static constexpr Fixed kS3 = Fixed::FromRaw(-42334);
+static constexpr Fixed kS5 = Fixed::FromRaw(5223);
+static constexpr Fixed kS7 = Fixed::FromRaw(-307);
+static constexpr Fixed kS9 = Fixed::FromRaw(11);
+// atan(z) ~ z * (A1 + z^2 * (A3 + z^2 * (A5 + z^2 * (A7 + z^2 * A9)))), z<=1
+static constexpr Fixed kA1 = Fixed::FromRaw(65527);
+static constexpr Fixed kA3 = Fixed::FromRaw(-21647);
+static constexpr Fixed kA5 = Fixed::FromRaw(11806);
+static constexpr Fixed kA7 = Fixed::FromRaw(-5579);
+static constexpr Fixed kA9 = Fixed::FromRaw(1365);
+static constexpr Fixed kRadToDeg = Fixed::FromRaw(3754936);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+Fixed FixedSqrt(Fixed x) {
+  if (x.raw() <= 0) {
+    return Fixed();
+  }
+  // sqrt(raw / 2^16) * 2^16 == sqrt(raw * 2^16)
+  unsigned __int128 n = static_cast<unsigned __int128>(x.raw()) <<
+      Fixed::kFractionBits;
+  unsigned __int128 res = 0;
+  unsigned __int128 bit = static_cast<unsigned __int128>(1) << 126;
+  while (bit > n) {
+    bit >>= 2;
+  }
+  while (bit) {
+    if (n >= res + bit) {
+      n -= res + bit;
+      res = (res >> 1) + bit;
+    } else {
+      res >>= 1;
+    }
+    bit >>= 2;
+  } /* while(bit..) */
+  return Fixed::FromRaw(static_cast<int64_t>(res));
+} /* FixedSqrt() */
+
+/**
+* @brief sin(pi/2 * t) for t in [0, 1].
+*/
+static Fixed QuarterSine(Fixed t) {
+  Fixed t2 = t * t;
+  return t * (kS1 + t2 * (kS3 + t2 * (kS5 + t2 * (kS7 + t2 * kS9))));
+} /* QuarterSine() */
+
+Fixed FixedSinDeg(Fixed degrees) {
+  const int64_t full = 360 * Fixed::kOne;
+  const int64_t quarter = 90 * Fixed::kOne;
+  int64_t d = degrees.raw() % full;
+  if (d < 0) {
+    d += full;
+  }
+  int64_t q = d / quarter;
+  Fixed t = Fixed::FromRaw(d - q * quarter) / Fixed(90);
+  switch (q) {
+    case 0: return QuarterSine(t);
+    case 1: return QuarterSine(Fixed(1) - t);
+    case 2: return -QuarterSine(t);
+    default: return -QuarterSine(Fixed(1) - t);
+  } /* switch() */
+} /* FixedSinDeg() */
+
+Fixed FixedCosDeg(Fixed degrees) {
+  return FixedSinDeg(degrees + Fixed(90));
+} /* FixedCosDeg() */
+
+Fixed FixedAtan2Deg(Fixed y, Fixed x) {
+  Fixed ax = x < Fixed() ? -x : x;
+  Fixed ay = y < Fixed() ? -y : y;
+  if (ax == Fixed() && ay == Fixed()) {
+    return Fixed();
+  }
+  // Reduce to the first octant so the polynomial only sees z in [0, 1].
+  bool swapped = ay > ax;
+  Fixed z = swapped ? ax / ay : ay / ax;
+  Fixed z2 = z * z;
+  Fixed a = z * (kA1 + z2 * (kA3 + z2 * (kA5 + z2 * (kA7 + z2 * kA9)))) *
+      kRadToDeg;
+  if (swapped) {
+    a = Fixed(90) - a;
+  }
+  if (x < Fixed()) {
+    a = Fixed(180) - a;
+  }
+  if (y < Fixed() && a != Fixed()) {
+    a = Fixed(360) - a;
+  }
+  return a;
+} /* FixedAtan2Deg() */
+
+NAMESPACE_END(csci3081);
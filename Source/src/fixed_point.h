@@ -0,0 +1,117 @@
+/**
+ * @file fixed_point.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_FIXED_POINT_H_
+#define SRC_FIXED_POINT_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include <type_traits>
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+// Spelled out rather than NAMESPACE_BEGIN: common.h includes this header (via
+// numeric.h) before Position, so it cannot depend on common.h itself.
+namespace csci3081 {
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief A signed Q47.16 fixed-point number stored in 64 bits.
+ *
+ * All arithmetic is integer-only (products and quotients go through a 128-bit
+ * intermediate), so results are bit-identical regardless of compiler, flags or
+ * FPU. Conversions from double are only meant for configuration values and
+ * literals; the simulation itself never touches floating point in fixed mode.
+ *
+ * The range (about +/-1.4e14) comfortably covers squared distances in large
+ * arenas, and the resolution is 1/65536.
+ */
+class Fixed {
+ public:
+  static const int kFractionBits = 16;
+  static const int64_t kOne = static_cast<int64_t>(1) << kFractionBits;
+
+  // constexpr, so that Fixed constants at namespace scope are initialized
+  // before any code runs rather than in link order
+  constexpr Fixed(void) : raw_(0) {}
+  template <typename T>
+  constexpr Fixed(T v,  // NOLINT(runtime/explicit)
+        typename std::enable_if<std::is_integral<T>::value>::type* = 0)
+      : raw_(static_cast<int64_t>(v) * kOne) {}
+  template <typename T>
+  constexpr Fixed(T v,  // NOLINT(runtime/explicit)
+        typename std::enable_if<std::is_floating_point<T>::value>::type* = 0)
+      : raw_(static_cast<int64_t>(v * kOne + (v < 0 ? -0.5 : 0.5))) {}
+
+  static constexpr Fixed FromRaw(int64_t raw) { return Fixed(raw, raw_tag()); }
+  int64_t raw(void) const { return raw_; }
+
+  explicit operator double(void) const {
+    return static_cast<double>(raw_) / kOne;
+  }
+  explicit operator int(void) const {
+    return static_cast<int>(raw_ >> kFractionBits);
+  }
+
+  Fixed operator-(void) const { return FromRaw(-raw_); }
+  Fixed& operator+=(Fixed o) { raw_ += o.raw_; return *this; }
+  Fixed& operator-=(Fixed o) { raw_ -= o.raw_; return *this; }
+  Fixed& operator*=(Fixed o) { *this = *this * o; return *this; }
+  Fixed& operator/=(Fixed o) { *this = *this / o; return *this; }
+
+  friend Fixed operator+(Fixed a, Fixed b) { return FromRaw(a.raw_ + b.raw_); }
+  friend Fixed operator-(Fixed a, Fixed b) { return FromRaw(a.raw_ - b.raw_); }
+  friend Fixed operator*(Fixed a, Fixed b) {
+    __int128 p = static_cast<__int128>(a.raw_) * b.raw_;
+    return FromRaw(static_cast<int64_t>(p >> kFractionBits));
+  }
+  friend Fixed operator/(Fixed a, Fixed b) {
+    __int128 n = static_cast<__int128>(a.raw_) << kFractionBits;
+    return FromRaw(b.raw_ ? static_cast<int64_t>(n / b.raw_) : 0);
+  }
+  friend bool operator==(Fixed a, Fixed b) { return a.raw_ == b.raw_; }
+  friend bool operator!=(Fixed a, Fixed b) { return a.raw_ != b.raw_; }
+  friend bool operator<(Fixed a, Fixed b) { return a.raw_ < b.raw_; }
+  friend bool operator>(Fixed a, Fixed b) { return a.raw_ > b.raw_; }
+  friend bool operator<=(Fixed a, Fixed b) { return a.raw_ <= b.raw_; }
+  friend bool operator>=(Fixed a, Fixed b) { return a.raw_ >= b.raw_; }
+
+ private:
+  struct raw_tag {};
+  constexpr Fixed(int64_t raw, raw_tag) : raw_(raw) {}
+
+  int64_t raw_;
+};
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief Square root by the bit-by-bit integer method. Negative inputs give 0.
+ */
+Fixed FixedSqrt(Fixed x);
+
+/**
+ * @brief Sine and cosine of an angle in degrees, via quadrant reduction and
+ * an odd polynomial (max error about 5e-5).
+ */
+Fixed FixedSinDeg(Fixed degrees);
+Fixed FixedCosDeg(Fixed degrees);
+
+/**
+ * @brief Angle of (x, y) in degrees in [0, 360), via octant reduction and a
+ * polynomial arctangent (max error about 5e-3 degrees).
+ */
+Fixed FixedAtan2Deg(Fixed y, Fixed x);
+
+}  // namespace csci3081
+
+#endif /* SRC_FIXED_POINT_H_ */
@@ -0,0 +1,267 @@
+/**
+ * @file flow_field.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/flow_field.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <utility>
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constant Definitions
+ ******************************************************************************/
+// The 8 neighbors, counterclockwise from +x; neighbor k + 4 is opposite k
+static const int kDx[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+static const int kDy[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+static const int8_t kNone = -1;
+
+// One-cell moves of the goal the near field is patched for, by leading the
+// goal's last cell on to its new one, before it is solved again. Each can
+// leave paths up to two cells longer than the shortest.
+static const int kNearTrail = 8;
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+FlowField::FlowField(uint x_dim, uint y_dim,
+                     const struct circle_batch& obstacles,
+                     const struct flow_field_params& params) :
+  cell_(params.cell_size),
+  window_(std::max(1, params.window)),
+  cols_(std::max(1, static_cast<int>(std::ceil(x_dim / params.cell_size)))),
+  rows_(std::max(1, static_cast<int>(std::ceil(y_dim / params.cell_size)))),
+  blocked_(static_cast<size_t>(cols_) * rows_, 0),
+  far_(),
+  pending_(),
+  pending_center_(-1),
+  far_solving_(false),
+  far_scratch_(),
+  far_job_([this](size_t) { SolveFar(pending_center_, &pending_); }),
+  near_goal_(-1),
+  near_c0_(0), near_r0_(0), near_c1_(0), near_r1_(0),
+  near_next_(),
+  near_trail_(0),
+  near_scratch_(),
+  far_solves_(0),
+  near_solves_(0),
+  worker_(2) {
+  // A cell is blocked while its center is inside an inflated obstacle
+  for (size_t i = 0; i < obstacles.size(); ++i) {
+    double r = obstacles.r[i] + params.clearance;
+    int c0 = std::max(0, static_cast<int>((obstacles.x[i] - r) / cell_));
+    int c1 = std::min(cols_ - 1,
+                      static_cast<int>((obstacles.x[i] + r) / cell_));
+    int r0 = std::max(0, static_cast<int>((obstacles.y[i] - r) / cell_));
+    int r1 = std::min(rows_ - 1,
+                      static_cast<int>((obstacles.y[i] + r) / cell_));
+    for (int row = r0; row <= r1; ++row) {
+      for (int col = c0; col <= c1; ++col) {
+        double dx = (col + 0.5) * cell_ - obstacles.x[i];
+        double dy = (row + 0.5) * cell_ - obstacles.y[i];
+        if (dx * dx + dy * dy <= r * r) {
+          blocked_[static_cast<size_t>(row) * cols_ + col] = 1;
+        }
+      } /* for(col..) */
+    } /* for(row..) */
+  } /* for(i..) */
+}
+
+FlowField::~FlowField(void) {
+  worker_.Wait();
+}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+int FlowField::CellOf(double x, double y) const {
+  int col = std::min(std::max(static_cast<int>(std::floor(x / cell_)), 0),
+                     cols_ - 1);
+  int row = std::min(std::max(static_cast<int>(std::floor(y / cell_)), 0),
+                     rows_ - 1);
+  return row * cols_ + col;
+} /* CellOf() */
+
+void FlowField::Window(int center, int * c0, int * r0, int * c1,
+                       int * r1) const {
+  int col = center % cols_;
+  int row = center / cols_;
+  *c0 = std::max(0, col - window_);
+  *r0 = std::max(0, row - window_);
+  *c1 = std::min(cols_, col + window_ + 1);
+  *r1 = std::min(rows_, row + window_ + 1);
+} /* Window() */
+
+void FlowField::Solve(int c0, int r0, int c1, int r1, solve_scratch * scratch,
+                      std::vector<int8_t> * next) const {
+  int w = c1 - c0;
+  int h = r1 - r0;
+  std::vector<float>& dist = scratch->dist;
+  dist.assign(static_cast<size_t>(w) * h,
+              std::numeric_limits<float>::infinity());
+  next->assign(dist.size(), kNone);
+  typedef std::pair<float, int> entry;
+  std::vector<entry>& open = scratch->open;
+  open.clear();
+  for (int s : scratch->sources) {
+    int local = (s / cols_ - r0) * w + (s % cols_ - c0);
+    dist[local] = 0;
+    open.push_back(entry(0.0f, local));
+  } /* for(s..) */
+  std::make_heap(open.begin(), open.end(), std::greater<entry>());
+  const float diagonal = static_cast<float>(std::sqrt(2.0));
+  while (!open.empty()) {
+    std::pop_heap(open.begin(), open.end(), std::greater<entry>());
+    entry top = open.back();
+    open.pop_back();
+    int u = top.second;
+    if (top.first > dist[u]) {
+      continue;
+    }
+    int ucol = u % w;
+    int urow = u / w;
+    for (int k = 0; k < 8; ++k) {
+      int col = ucol + kDx[k];
+      int row = urow + kDy[k];
+      if (col < 0 || col >= w || row < 0 || row >= h) {
+        continue;
+      }
+      bool blocked = blocked_[static_cast<size_t>(row + r0) * cols_ + col + c0];
+      // No cutting corners between two blocked cells
+      if (!blocked && kDx[k] && kDy[k] &&
+          (blocked_[static_cast<size_t>(urow + r0) * cols_ + col + c0] ||
+           blocked_[static_cast<size_t>(row + r0) * cols_ + ucol + c0])) {
+        continue;
+      }
+      int v = row * w + col;
+      float d = top.first + ((kDx[k] && kDy[k]) ? diagonal : 1.0f);
+      if (d < dist[v]) {
+        dist[v] = d;
+        (*next)[v] = static_cast<int8_t>((k + 4) % 8);
+        // Blocked cells only lead out, for whatever has strayed into one
+        if (!blocked) {
+          open.push_back(entry(d, v));
+          std::push_heap(open.begin(), open.end(), std::greater<entry>());
+        }
+      }
+    } /* for(k..) */
+  } /* while() */
+} /* Solve() */
+
+void FlowField::SolveFar(int center, far_layer * out) {
+  far_scratch_.sources.assign(1, center);
+  Solve(0, 0, cols_, rows_, &far_scratch_, &out->next);
+  out->center = center;
+} /* SolveFar() */
+
+void FlowField::SolveNear(int goal) {
+  Window(far_.center, &near_c0_, &near_r0_, &near_c1_, &near_r1_);
+  int col = goal % cols_;
+  int row = goal / cols_;
+  near_scratch_.sources.clear();
+  if (col >= near_c0_ && col < near_c1_ && row >= near_r0_ && row < near_r1_) {
+    near_scratch_.sources.push_back(goal);
+  }
+  Solve(near_c0_, near_r0_, near_c1_, near_r1_, &near_scratch_, &near_next_);
+  near_goal_ = goal;
+  near_trail_ = 0;
+  ++near_solves_;
+} /* SolveNear() */
+
+bool FlowField::PatchNear(int goal) {
+  if (near_goal_ < 0 || near_trail_ >= kNearTrail) {
+    return false;
+  }
+  int col = near_goal_ % cols_;
+  int row = near_goal_ / cols_;
+  int dc = goal % cols_ - col;
+  int dr = goal / cols_ - row;
+  // Both cells must be in the window
+  if (std::abs(dc) > 1 || std::abs(dr) > 1 ||
+      std::min(col, col + dc) < near_c0_ ||
+      std::max(col, col + dc) >= near_c1_ ||
+      std::min(row, row + dr) < near_r0_ ||
+      std::max(row, row + dr) >= near_r1_) {
+    return false;
+  }
+  int k = 0;
+  while (kDx[k] != dc || kDy[k] != dr) {
+    ++k;
+  }
+  near_next_[(row - near_r0_) * (near_c1_ - near_c0_) + (col - near_c0_)] =
+      static_cast<int8_t>(k);
+  near_goal_ = goal;
+  ++near_trail_;
+  return true;
+} /* PatchNear() */
+
+void FlowField::Update(double x, double y) {
+  int goal = CellOf(x, y);
+  int dc = std::abs(goal % cols_ - far_.center % cols_);
+  int dr = std::abs(goal / cols_ - far_.center / cols_);
+  int out = std::max(dc, dr);
+  if (far_.center < 0 || out > window_) {
+    // First use, or the goal has left the window: nothing to wait for
+    worker_.Wait();
+    far_solving_ = false;
+    SolveFar(goal, &far_);
+    ++far_solves_;
+    near_goal_ = -1;
+    out = 0;
+  }
+  // Start on the next far field once the goal is halfway to the edge of the
+  // window, and take it over (waiting for it if need be) three quarters of
+  // the way. Both depend on the goal only, never on the worker's timing.
+  if (far_solving_ && out > window_ * 3 / 4) {
+    worker_.Wait();
+    far_solving_ = false;
+    std::swap(far_, pending_);
+    ++far_solves_;
+    near_goal_ = -1;
+  } else if (!far_solving_ && out > window_ / 2) {
+    pending_center_ = goal;
+    far_solving_ = true;
+    worker_.Start(far_job_);
+  }
+  if (goal != near_goal_ && !PatchNear(goal)) {
+    SolveNear(goal);
+  }
+} /* Update() */
+
+Vector2 FlowField::Direction(double x, double y) const {
+  static const double kDiag = std::sqrt(0.5);
+  int cell = CellOf(x, y);
+  int col = cell % cols_;
+  int row = cell / cols_;
+  if (cell == near_goal_) {
+    return Vector2();
+  }
+  int8_t k = kNone;
+  if (col >= near_c0_ && col < near_c1_ && row >= near_r0_ &&
+      row < near_r1_) {
+    k = near_next_[(row - near_r0_) * (near_c1_ - near_c0_) +
+                   (col - near_c0_)];
+  }
+  // Outside the window, or cut off from the goal inside it
+  if (k == kNone && !far_.next.empty()) {
+    k = far_.next[cell];
+  }
+  if (k == kNone) {
+    return Vector2();
+  }
+  double scale = (kDx[k] && kDy[k]) ? kDiag : 1.0;
+  return Vector2(kDx[k] * scale, kDy[k] * scale);
+} /* Direction() */
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,165 @@
+/**
+ * @file flow_field.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_FLOW_FIELD_H_
+#define SRC_FLOW_FIELD_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "src/common.h"
+#include "src/ray_cast.h"
+#include "src/vector2.h"
+#include "src/worker_pool.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+struct flow_field_params {
+  flow_field_params(void) : cell_size(8), clearance(0), window(16) {}
+
+  double cell_size;
+  // Added to every obstacle's radius when marking cells blocked
+  double clearance;
+  // Half the side, in cells, of the square around the goal that is solved
+  // again as the goal moves about in it
+  int window;
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Directions toward one goal for every cell of a grid, so that any
+ * number of entities can head for it by one lookup each.
+ *
+ * The field is solved with Dijkstra over the free cells, 8-connected, in two
+ * parts so that a goal that moves every step is cheap to follow:
+ *
+ * - The far field leads every cell to where the goal was when it was solved,
+ *   the center of a square window. It is only redone when the goal nears the
+ *   edge of the window, and then on a worker thread, kept for the life of
+ *   the field, while the simulation runs on; the goal is still inside the
+ *   old window meanwhile, so the old field stays good until the new one is
+ *   swapped in. A goal that jumps out of the window (e.g. into a new game)
+ *   has it redone on the spot.
+ * - The near field leads the cells of the window to the goal itself. When
+ *   the goal moves on to a neighboring cell, the cell it left is made to
+ *   lead on to it, so paths follow the goal's own trail for the last few
+ *   cells; only after a handful of such moves, or a longer one, is it
+ *   redone, over the window only. Cells it cannot lead to the goal without
+ *   leaving the window follow the far field.
+ *
+ * The new far field is swapped in at a point fixed by how far the goal has
+ * moved, so runs stay reproducible. Solving reuses the memory of the solves
+ * before it, so a field that is kept, e.g. one shared by the games of a run
+ * (see arena_params::flow_field), stops allocating.
+ */
+class FlowField {
+ public:
+  FlowField(uint x_dim, uint y_dim, const struct circle_batch& obstacles,
+            const struct flow_field_params& params);
+  ~FlowField(void);
+
+  /**
+   * @brief Follow the goal to (x, y). Call once per step, before reading
+   * Direction().
+   */
+  void Update(double x, double y);
+
+  /**
+   * @brief Unit vector to steer along at (x, y); zero at the goal, or where
+   * it cannot be reached.
+   */
+  Vector2 Direction(double x, double y) const;
+
+  /**
+   * @brief How often each part has been solved, for tuning the window.
+   */
+  unsigned far_solves(void) const { return far_solves_; }
+  unsigned near_solves(void) const { return near_solves_; }
+
+ private:
+  /**
+   * @brief Where each cell goes next toward center: the index (0-7) of the
+   * neighbor on its shortest path, or kNone.
+   */
+  struct far_layer {
+    far_layer(void) : center(-1), next() {}
+    int center;
+    std::vector<int8_t> next;
+  };
+
+  /**
+   * @brief What a Solve() works in; one for each thread that solves.
+   */
+  struct solve_scratch {
+    solve_scratch(void) : sources(), dist(), open() {}
+    std::vector<int> sources;
+    std::vector<float> dist;
+    std::vector<std::pair<float, int>> open;
+  };
+
+  FlowField(const FlowField& other) = delete;
+  FlowField& operator=(const FlowField& other) = delete;
+
+  int CellOf(double x, double y) const;
+
+  /**
+   * @brief Dijkstra from scratch->sources over the cells in [c0, c1) x
+   * [r0, r1), writing each cell's next step into next (indexed as region
+   * cells).
+   */
+  void Solve(int c0, int r0, int c1, int r1, solve_scratch * scratch,
+             std::vector<int8_t> * next) const;
+  void SolveFar(int center, far_layer * out);
+  void SolveNear(int goal);
+  /**
+   * @brief Lead the near field on to goal, a neighbor of the cell it leads
+   * to, without solving it again.
+   *
+   * @return false if the near field must be solved instead.
+   */
+  bool PatchNear(int goal);
+  void Window(int center, int * c0, int * r0, int * c1, int * r1) const;
+
+  double cell_;
+  int window_;
+  int cols_;
+  int rows_;
+  std::vector<uint8_t> blocked_;
+  far_layer far_;
+  // Solved by worker_ toward pending_center_ while far_solving_
+  far_layer pending_;
+  int pending_center_;
+  bool far_solving_;
+  solve_scratch far_scratch_;
+  std::function<void(size_t)> far_job_;
+  // The window of far_, solved toward near_goal_
+  int near_goal_;
+  int near_c0_, near_r0_, near_c1_, near_r1_;
+  std::vector<int8_t> near_next_;
+  // One-cell moves patched into near_next_ since it was solved
+  int near_trail_;
+  solve_scratch near_scratch_;
+  unsigned far_solves_;
+  unsigned near_solves_;
+  // Declared last, so it stops before what its job uses goes away
+  WorkerPool worker_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif /* SRC_FLOW_FIELD_H_ */
@@ -8,6 +8,7 @@
  * Includes
  ******************************************************************************/
 #include "src/graphics_arena_viewer.h"
+#include <stdio.h>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -15,8 +16,10 @@
 #include "src/robot.h"
 #include "src/home_base.h"
 #include "src/obstacle.h"
+#include "src/recharge_station.h"
 #include "src/arena_params.h"
 #include "src/event_keypress.h"
+#include "src/trace.h"
 
 /*******************************************************************************
  * Namespaces
@@ -32,7 +35,12 @@ GraphicsArenaViewer::GraphicsArenaViewer(
       arena_(new Arena(params)),
       paused_(false),
       pause_btn_(nullptr),
+      restart_btn_(nullptr),
+      input_(),
+      latency_(),
       params_(params) {
+  arena_->input_queue(&input_);
+  input_.latency_tracker(&latency_);
   nanogui::FormHelper *gui = new nanogui::FormHelper(this);
   nanogui::ref<nanogui::Window> window = gui->addWindow(Eigen::Vector2i(10, 10),
                                                     "Simulation Controls");
@@ -53,10 +61,12 @@ GraphicsArenaViewer::GraphicsArenaViewer(
 // This is the primary driver for state change in the arena.
 // It will be called at each iteration of nanogui::mainloop()
 void GraphicsArenaViewer::UpdateSimulation(double dt) {
+  TRACE_SCOPE("GraphicsArenaViewer::UpdateSimulation", "sim");
   if (!paused_) {
     last_dt += dt;
     while (last_dt > 0.05) {
       arena_->AdvanceTime();
+      latency_.StepDone();
       last_dt -= 0.05;
     }
     if (arena_->getGameStatus()) {
@@ -78,6 +88,7 @@ void GraphicsArenaViewer::UpdateSimulation(double dt) {
 void GraphicsArenaViewer::OnRestartBtnPressed() {
   arena_->Reset();
   arena_ = new Arena(params_);
+  arena_->input_queue(&input_);
 }
 
 void GraphicsArenaViewer::OnPauseBtnPressed() {
@@ -110,26 +121,31 @@ void GraphicsArenaViewer::OnRightMouseUp(int x, int y) {
 }
 
 void GraphicsArenaViewer::OnKeyDown(const char *c, int modifiers) {
+  TRACE_SCOPE("GraphicsArenaViewer::OnKeyDown", "input");
   std::cout << "Key DOWN (" << c << ") modifiers=" << modifiers << std::endl;
 }
 
 void GraphicsArenaViewer::OnKeyUp(const char *c, int modifiers) {
+  TRACE_SCOPE("GraphicsArenaViewer::OnKeyUp", "input");
   std::cout << "Key UP (" << c << ") modifiers=" << modifiers << std::endl;
 }
 /**
 * @brief Framework used to pass keypresses into the arena so that
-* they may be in scope of the arena and handled appropriately.
+* they may be in scope of the arena and handled appropriately. The
+* command goes through the input queue rather than straight to the
+* arena, so it is applied at the start of the next step.
 */
 void GraphicsArenaViewer::OnSpecialKeyDown(int key, int scancode,
   int modifiers) {
+  TRACE_SCOPE("GraphicsArenaViewer::OnSpecialKeyDown", "input");
   EventKeypress e(key);
-  arena_->Accept(&e);
-//  arena_->Robot()->
+  input_.Push(kNoEntity, e.get_key_cmd());
   std::cout << "Special Key DOWN key=" << key << " scancode=" << scancode
             << " modifiers=" << modifiers << std::endl;
 }
 
 void GraphicsArenaViewer::OnSpecialKeyUp(int key, int scancode, int modifiers) {
+  TRACE_SCOPE("GraphicsArenaViewer::OnSpecialKeyUp", "input");
   std::cout << "Special Key UP key=" << key << " scancode=" << scancode
             << " modifiers=" << modifiers << std::endl;
 }
@@ -152,10 +168,10 @@ void GraphicsArenaViewer::DrawRobot(NVGcontext *ctx, const Robot* const robot) {
   nvgRotate(ctx, -90*M_PI/180);
   // robot's circle
   nvgBeginPath(ctx);
-  nvgCircle(ctx, 0.0, 0.0, robot->radius());
-  nvgFillColor(ctx, nvgRGBA(robot->color().r,
-                            robot->color().g,
-                            robot->color().b,
+  nvgCircle(ctx, 0.0, 0.0, RealToDouble(robot->get_radius()));
+  nvgFillColor(ctx, nvgRGBA(robot->get_color().r,
+                            robot->get_color().g,
+                            robot->get_color().b,
                             255));
   nvgFill(ctx);
   nvgStrokeColor(ctx, nvgRGBA(0, 0, 0, 255));
@@ -163,7 +179,7 @@ void GraphicsArenaViewer::DrawRobot(NVGcontext *ctx, const Robot* const robot) {
   // string stream to convert double to string to display battery level
   std::stringstream stream;
   stream << " Battery level: ";
-  double battery = robot->battery_level();
+  double battery = RealToDouble(robot->get_battery_level());
   stream << battery;
   stream << "%";
   std::string formatted_name = robot->name() + stream.str();
@@ -180,10 +196,10 @@ void GraphicsArenaViewer::DrawObstacle(NVGcontext *ctx,
                                        const Obstacle* const obstacle) {
   nvgBeginPath(ctx);
   nvgCircle(ctx, (int) obstacle->get_pos().x, (int) obstacle->get_pos().y,
-    obstacle->radius());
-  nvgFillColor(ctx, nvgRGBA(obstacle->color().r,
-                            obstacle->color().g,
-                            obstacle->color().b,
+    RealToDouble(obstacle->get_radius()));
+  nvgFillColor(ctx, nvgRGBA(obstacle->get_color().r,
+                            obstacle->get_color().g,
+                            obstacle->get_color().b,
                             255));
   nvgFill(ctx);
   nvgStrokeColor(ctx, nvgRGBA(0, 0, 0, 255));
@@ -200,10 +216,11 @@ void GraphicsArenaViewer::DrawHomeBase(NVGcontext *ctx,
   // nvgTranslate(ctx, home->get_pos().x, home->get_pos().y);
   // nvgRotate(ctx, home->heading_angle());
   nvgBeginPath(ctx);
-  nvgCircle(ctx, (int) home->get_pos().x, (int) home->get_pos().y, home->radius());
-  nvgFillColor(ctx, nvgRGBA(home->color().r,
-                            home->color().g,
-                            home->color().b,
+  nvgCircle(ctx, (int) home->get_pos().x, (int) home->get_pos().y,
+    RealToDouble(home->get_radius()));
+  nvgFillColor(ctx, nvgRGBA(home->get_color().r,
+                            home->get_color().g,
+                            home->get_color().b,
                             255));
   nvgFill(ctx);
   nvgStrokeColor(ctx, nvgRGBA(0, 0, 0, 255));
@@ -214,21 +231,61 @@ void GraphicsArenaViewer::DrawHomeBase(NVGcontext *ctx,
     NULL);
 }
 
+void GraphicsArenaViewer::DrawLatencyOverlay(NVGcontext *ctx) {
+  const LatencyWindow * windows[] = {&latency_.to_step(),
+                                     &latency_.to_frame()};
+  const char * names[] = {"input to step", "input to frame"};
+  nvgSave(ctx);
+  nvgFontSize(ctx, 14.0f);
+  nvgTextAlign(ctx, NVG_ALIGN_RIGHT | NVG_ALIGN_TOP);
+  nvgFillColor(ctx, nvgRGBA(0, 0, 0, 255));
+  for (int i = 0; i < 2; ++i) {
+    char line[96];
+    snprintf(line, sizeof(line), "%s  p50 %.1f  p90 %.1f  p99 %.1f ms",
+             names[i], windows[i]->Percentile(50) / 1e6,
+             windows[i]->Percentile(90) / 1e6,
+             windows[i]->Percentile(99) / 1e6);
+    nvgText(ctx, params_->x_dim - 10.0f, 10.0f + 18.0f * i, line, NULL);
+  } /* for(i..) */
+  nvgRestore(ctx);
+}
+
 // This is the primary driver for drawing all entities in the arena.
 // It is called at each iteration of nanogui::mainloop()
 void GraphicsArenaViewer::DrawUsingNanoVG(NVGcontext *ctx) {
+  TRACE_SCOPE("GraphicsArenaViewer::DrawUsingNanoVG", "render");
   // initialize text rendering settings
   nvgFontSize(ctx, 18.0f);
   nvgFontFace(ctx, "sans-bold");
   nvgTextAlign(ctx, NVG_ALIGN_CENTER | NVG_ALIGN_MIDDLE);
 
-  std::vector<Obstacle*> obstacles = arena_->obstacles();
+  const std::vector<entity_id>& obstacles = arena_->obstacles();
   for (size_t i = 0; i < obstacles.size(); i++) {
-    DrawObstacle(ctx, obstacles[i]);
+    Obstacle obstacle(&arena_->registry(), obstacles[i]);
+    DrawObstacle(ctx, &obstacle);
+  } /* for(i..) */
+  // Precompiled obstacles may number in the millions, so they get no labels
+  const StaticMap * map = arena_->static_map();
+  if (map) {
+    map->ForEachInBox(0, 0, map->x_dim(), map->y_dim(),
+                      [ctx](const static_obstacle& o) {
+        nvgBeginPath(ctx);
+        nvgCircle(ctx, o.x, o.y, o.radius);
+        nvgFillColor(ctx, nvgRGBA(o.r, o.g, o.b, o.a));
+        nvgFill(ctx);
+      });
+  }
+  const std::vector<entity_id>& stations = arena_->recharge_stations();
+  for (size_t i = 0; i < stations.size(); i++) {
+    RechargeStation station(&arena_->registry(), stations[i]);
+    DrawObstacle(ctx, &station);
   } /* for(i..) */
 
   DrawRobot(ctx, arena_->robot());
   DrawHomeBase(ctx, arena_->home_base());
+  DrawLatencyOverlay(ctx);
+  // The frame is complete; the buffer swap that shows it comes next
+  latency_.FramePresented(Tracer::NowNs());
 }
 
 NAMESPACE_END(csci3081);
@@ -13,6 +13,8 @@
 #include <simple_graphics/graphics_app.h>
 #include "src/arena.h"
 #include "src/common.h"
+#include "src/input_queue.h"
+#include "src/latency_tracker.h"
 
 /*******************************************************************************
  * Namespaces
@@ -172,6 +174,17 @@ class GraphicsArenaViewer : public GraphicsApp {
 
   Arena* arena(void) const { return arena_; }
 
+  /**
+   * @brief Where key presses wait for the next step, and how long they
+   * waited.
+   */
+  const InputQueue& input_queue(void) const { return input_; }
+
+  /**
+   * @brief How long key presses take to show on screen, e.g. to log them.
+   */
+  InputLatencyTracker& latency_tracker(void) { return latency_; }
+
  private:
   /**
    * @brief Draw a robot using nanogui.
@@ -197,11 +210,20 @@ class GraphicsArenaViewer : public GraphicsApp {
 
   void DrawHomeBase(NVGcontext *ctx, const class HomeBase* const home);
 
+  /**
+   * @brief Draw rolling percentiles of input latency in the top right
+   * corner.
+   */
+  void DrawLatencyOverlay(NVGcontext *ctx);
+
   Arena *arena_;
   bool paused_;
   double last_dt = 0.;
   nanogui::Button *pause_btn_;
   nanogui::Button *restart_btn_;
+  // Key presses, applied by the arena at the start of its next step
+  InputQueue input_;
+  InputLatencyTracker latency_;
   /* Added this for restart function, since restart needs
     an arena_params* as an argument.
   */
@@ -0,0 +1,332 @@
+/**
+ * @file headless_main.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <memory>
+#include <vector>
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/arena_defaults.h"
+#include "src/arena_generator.h"
+#include "src/controller_channel.h"
+#include "src/flow_field.h"
+#include "src/perf_counters.h"
+#include "src/scenario.h"
+#include "src/state_export.h"
+#include "src/static_map.h"
+#include "src/trace.h"
+#include "src/visibility_graph.h"
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+static void Usage(const char * prog) {
+  fprintf(stderr,
+          "Usage: %s [--scenario file | --generate N] [--compile out]"
+          " [--compile-map out] [--map file] [--steps N] [--seed N] [--perf]"
+          " [--perf-steps] [--trace file]"
+          " [--autopilot] [--track] [--flow] [--export name]"
+          " [--controller name]... [--budget us] [--quiet]\n"
+          "  --scenario file  load the arena from a text or compiled scenario\n"
+          "  --generate N     generate an arena with N obstacles from the"
+          " seed\n"
+          "  --compile out    write the scenario to out in compiled form and"
+          " exit\n"
+          "  --compile-map out  write the obstacles to out as a static map and"
+          " exit\n"
+          "  --map file       take the obstacles and size of the arena from a"
+          " static map\n"
+          "  --steps N     number of simulation steps to run (default 1000)\n"
+          "  --seed N      seed the home base so the run is reproducible\n"
+          "  --perf        aggregate hardware counters per phase\n"
+          "  --perf-steps  also print the counters of every step\n"
+          "  --trace file  write a Chrome trace of the run to file\n"
+          "  --autopilot   every robot steers itself to the home base\n"
+          "  --track       like --autopilot, repairing each path every step\n"
+          "  --flow        like --autopilot, but by one shared flow field\n"
+          "  --export name publish every step to POSIX shared memory name"
+          " (e.g. /arena) for outside viewers\n"
+          "  --controller name  let a process attached to shared memory name"
+          " steer the\n"
+          "                next robot, the player's first\n"
+          "  --budget us   microseconds controllers have to answer each step"
+          " (default\n"
+          "                1000)\n"
+          "  --quiet       discard the simulation's stdout chatter\n",
+          prog);
+} /* Usage() */
+
+/**
+ * @brief Entry point of the headless runner: steps an Arena without opening a
+ * window, for batch runs and profiling. Reports go to stderr so they are not
+ * mixed with the simulation's own logging.
+ */
+int main(int argc, char **argv) {
+  unsigned long n_steps = 1000;
+  unsigned seed = 0;
+  bool seed_set = false;
+  const char * scenario_path = nullptr;
+  const char * compile_path = nullptr;
+  const char * compile_map_path = nullptr;
+  const char * map_path = nullptr;
+  unsigned long n_generate = 0;
+  bool perf = false;
+  bool perf_steps = false;
+  bool quiet = false;
+  bool autopilot = false;
+  bool track = false;
+  bool flow = false;
+  const char * trace_path = nullptr;
+  const char * export_name = nullptr;
+  std::vector<const char *> controller_names;
+  uint64_t budget_us = 1000;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc) {
+      n_steps = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      seed = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+      seed_set = true;
+    } else if (strcmp(argv[i], "--scenario") == 0 && i + 1 < argc) {
+      scenario_path = argv[++i];
+    } else if (strcmp(argv[i], "--generate") == 0 && i + 1 < argc) {
+      n_generate = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--compile") == 0 && i + 1 < argc) {
+      compile_path = argv[++i];
+    } else if (strcmp(argv[i], "--compile-map") == 0 && i + 1 < argc) {
+      compile_map_path = argv[++i];
+    } else if (strcmp(argv[i], "--map") == 0 && i + 1 < argc) {
+      map_path = argv[++i];
+    } else if (strcmp(argv[i], "--perf") == 0) {
+      perf = true;
+    } else if (strcmp(argv[i], "--perf-steps") == 0) {
+      perf = perf_steps = true;
+    } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+      trace_path = argv[++i];
+    } else if (strcmp(argv[i], "--autopilot") == 0) {
+      autopilot = true;
+    } else if (strcmp(argv[i], "--track") == 0) {
+      autopilot = track = true;
+    } else if (strcmp(argv[i], "--flow") == 0) {
+      autopilot = flow = true;
+    } else if (strcmp(argv[i], "--export") == 0 && i + 1 < argc) {
+      export_name = argv[++i];
+    } else if (strcmp(argv[i], "--controller") == 0 && i + 1 < argc) {
+      controller_names.push_back(argv[++i]);
+    } else if (strcmp(argv[i], "--budget") == 0 && i + 1 < argc) {
+      budget_us = strtoull(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--quiet") == 0) {
+      quiet = true;
+    } else {
+      Usage(argv[0]);
+      return 1;
+    }
+  } /* for(i..) */
+  if (scenario_path && n_generate) {
+    // Either would replace the other's arena
+    fprintf(stderr, "--scenario and --generate cannot be used together\n");
+    Usage(argv[0]);
+    return 1;
+  }
+  if (quiet && !freopen("/dev/null", "w", stdout)) {
+    fprintf(stderr, "Unable to silence stdout\n");
+  }
+  if (trace_path) {
+    csci3081::Tracer::Instance().enabled(true);
+    csci3081::Tracer::Instance().ThreadName("sim");
+  }
+
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  std::string error;
+  if (scenario_path &&
+      !csci3081::LoadScenario(scenario_path, &aparams, &error)) {
+    fprintf(stderr, "%s\n", error.c_str());
+    return 1;
+  } else if (n_generate) {
+    csci3081::arena_generator_params gparams;
+    gparams.n_obstacles = n_generate;
+    gparams.seed = seed_set ? seed : 1;
+    uint64_t gen_ns = csci3081::Tracer::NowNs();
+    size_t placed = 0;
+    if (!csci3081::GenerateArenaParams(&gparams, &aparams, &placed,
+                                       &error)) {
+      fprintf(stderr, "%s\n", error.c_str());
+      return 1;
+    }
+    fprintf(stderr, "generated %zu obstacles in a %ux%u arena in %.3f ms\n",
+            placed, aparams.x_dim, aparams.y_dim,
+            (csci3081::Tracer::NowNs() - gen_ns) / 1e6);
+  }
+  if (compile_path) {
+    if (!csci3081::SaveScenarioBinary(compile_path, aparams, &error)) {
+      fprintf(stderr, "%s\n", error.c_str());
+      return 1;
+    }
+    return 0;
+  }
+  csci3081::StaticMap map;
+  if (compile_map_path) {
+    map.Build(aparams.obstacles, aparams.x_dim, aparams.y_dim);
+    if (!map.Save(compile_map_path, &error)) {
+      fprintf(stderr, "%s\n", error.c_str());
+      return 1;
+    }
+    return 0;
+  }
+  if (map_path) {
+    uint64_t map_ns = csci3081::Tracer::NowNs();
+    if (!map.Open(map_path, &error)) {
+      fprintf(stderr, "%s\n", error.c_str());
+      return 1;
+    }
+    fprintf(stderr, "mapped %zu obstacles in %.3f ms\n", map.size(),
+            (csci3081::Tracer::NowNs() - map_ns) / 1e6);
+    aparams.obstacles.clear();
+    aparams.x_dim = map.x_dim();
+    aparams.y_dim = map.y_dim();
+    aparams.static_map = &map;
+  }
+  if (seed_set || (!scenario_path && !n_generate)) {
+    aparams.home_base.seed = seed;
+  }
+  // One planning graph, or one flow field, serves every game of the run
+  csci3081::VisibilityGraph planner;
+  std::unique_ptr<csci3081::FlowField> flow_field;
+  csci3081::circle_batch circles;
+  if (autopilot && !track) {
+    for (const csci3081::arena_entity_params& o : aparams.obstacles) {
+      circles.Push(csci3081::RealToDouble(o.pos.x),
+                   csci3081::RealToDouble(o.pos.y), o.radius);
+    } /* for(o..) */
+    if (map.loaded()) {
+      map.ForEachInBox(0, 0, map.x_dim(), map.y_dim(),
+                       [&circles](const csci3081::static_obstacle& o) {
+          circles.Push(o.x, o.y, o.radius); });
+    }
+  }
+  if (autopilot && flow) {
+    csci3081::flow_field_params fparams;
+    fparams.clearance = aparams.robot.radius +
+        aparams.robot.collision_delta + 1;
+    flow_field.reset(new csci3081::FlowField(aparams.x_dim, aparams.y_dim,
+                                             circles, fparams));
+    aparams.flow_field = flow_field.get();
+  } else if (autopilot && !track) {
+    csci3081::visibility_graph_params vparams;
+    vparams.clearance = aparams.robot.radius +
+        aparams.robot.collision_delta + 1;
+    // Large maps only link nearby corners
+    if (circles.size() > 1000) {
+      vparams.max_edge = 8 * vparams.clearance;
+    }
+    planner.Build(circles, aparams.x_dim, aparams.y_dim, vparams);
+    aparams.planner = &planner;
+  }
+  auto enable_autopilot = [autopilot, track, flow](csci3081::Arena * a) {
+    if (autopilot) {
+      for (csci3081::entity_id r : a->registry().of_kind(
+               csci3081::KIND_ROBOT)) {
+        a->EnableAutopilot(r, csci3081::AUTOPILOT_HOME_BASE,
+                           track ? csci3081::AUTOPILOT_TRACK :
+                           flow ? csci3081::AUTOPILOT_FLOW :
+                           csci3081::AUTOPILOT_PLAN);
+      } /* for(r..) */
+    }
+  };
+  std::unique_ptr<csci3081::Arena> arena(new csci3081::Arena(&aparams));
+  enable_autopilot(arena.get());
+
+  csci3081::PerfPhaseProfiler profiler;
+  bool counters = false;
+  if (perf) {
+    counters = profiler.Open();
+    if (!counters) {
+      fprintf(stderr, "Hardware counters unavailable (check "
+              "/proc/sys/kernel/perf_event_paranoid); running without\n");
+    }
+  }
+
+  // Room for every entity, in a ring of 64 frames
+  csci3081::StateExporter exporter;
+  if (export_name &&
+      !exporter.Open(export_name, 64,
+                     static_cast<uint32_t>(arena->registry().n_entities()),
+                     aparams.x_dim, aparams.y_dim, &error)) {
+    fprintf(stderr, "%s\n", error.c_str());
+    return 1;
+  }
+
+  // The player's robot comes first among the robots
+  csci3081::ControllerHost controllers;
+  const std::vector<csci3081::entity_id>& robots =
+      arena->registry().of_kind(csci3081::KIND_ROBOT);
+  if (controller_names.size() > robots.size()) {
+    fprintf(stderr, "%zu controllers for %zu robots\n",
+            controller_names.size(), robots.size());
+    return 1;
+  }
+  for (size_t i = 0; i < controller_names.size(); ++i) {
+    if (!controllers.Add(controller_names[i], robots[i], &error)) {
+      fprintf(stderr, "%s\n", error.c_str());
+      return 1;
+    }
+  } /* for(i..) */
+
+  uint64_t begin_ns = csci3081::Tracer::NowNs();
+  unsigned long n_games = 1;
+  for (unsigned long step = 0; step < n_steps; ++step) {
+    // Like the viewer's restart button, a finished game is replaced by a
+    // freshly constructed arena so long runs keep stepping.
+    if (arena->getGameStatus()) {
+      arena.reset(new csci3081::Arena(&aparams));
+      enable_autopilot(arena.get());
+      ++n_games;
+    }
+    arena->perf_profiler(counters ? &profiler : nullptr);
+    if (controllers.n_controllers()) {
+      controllers.Send(*arena, step, budget_us * 1000);
+      controllers.Collect(arena.get());
+    }
+    arena->AdvanceTime();
+    if (exporter.opened()) {
+      exporter.Publish(*arena, step);
+    }
+    if (perf_steps && counters) {
+      profiler.PrintStep(stderr);
+    }
+  } /* for(step..) */
+  uint64_t elapsed_ns = csci3081::Tracer::NowNs() - begin_ns;
+
+  fprintf(stderr, "%lu steps (%lu games) in %.3f ms (%.1f ns/step)\n",
+          n_steps, n_games, elapsed_ns / 1e6,
+          n_steps ? static_cast<double>(elapsed_ns) / n_steps : 0.0);
+  for (size_t i = 0; i < controllers.n_controllers(); ++i) {
+    const csci3081::controller_stats& stats = controllers.stats(i);
+    fprintf(stderr, "%s: %llu answered, %llu missed, %llu late, %llu dropped;"
+            " round trip %.2f us mean, %.2f us max\n",
+            controllers.name(i).c_str(),
+            static_cast<unsigned long long>(stats.answered),
+            static_cast<unsigned long long>(stats.missed),
+            static_cast<unsigned long long>(stats.late),
+            static_cast<unsigned long long>(stats.dropped),
+            stats.answered ?
+                stats.round_trip_ns / 1e3 / stats.answered : 0.0,
+            stats.max_round_trip_ns / 1e3);
+  } /* for(i..) */
+  if (counters) {
+    profiler.PrintSummary(stderr);
+  }
+  if (trace_path && !csci3081::Tracer::Instance().Dump(trace_path)) {
+    fprintf(stderr, "Unable to write trace to %s\n", trace_path);
+    return 1;
+  }
+  return 0;
+}
@@ -29,10 +29,15 @@ NAMESPACE_BEGIN(csci3081);
  /**
  * @brief Struct containing parameters used to initialize
  * HomeBase object variables, such as heading_angle_.
+ *
+ * A non-zero seed makes the HomeBase's wandering reproducible; 0 seeds it
+ * from the clock.
  */
 struct home_base_params : public arena_mobile_entity_params {
   home_base_params(void) :
-      arena_mobile_entity_params() {}
+      arena_mobile_entity_params(), seed() {}
+
+  unsigned seed;
 };
 
 NAMESPACE_END(csci3081);
@@ -0,0 +1,430 @@
+/**
+ * @file incremental_planner.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/incremental_planner.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constant Definitions
+ ******************************************************************************/
+static const int kDx[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+static const int kDy[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+// Step costs, in tenths of a cell. Integer costs keep ties between keys
+// exact, which the search relies on to settle every cell a path uses.
+static const int64_t kStraight = 10;
+static const int64_t kDiagonal = 14;
+static const int64_t kInfinity = std::numeric_limits<int64_t>::max() / 4;
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+IncrementalPlanner::IncrementalPlanner(
+    uint x_dim, uint y_dim, const struct circle_batch& obstacles,
+    const struct incremental_planner_params& params) :
+  cell_(params.cell_size),
+  clearance_(params.clearance),
+  cols_(std::max(1, static_cast<int>(std::ceil(x_dim / params.cell_size)))),
+  rows_(std::max(1, static_cast<int>(std::ceil(y_dim / params.cell_size)))),
+  coverage_(static_cast<size_t>(cols_) * rows_, 0),
+  g_(coverage_.size()),
+  rhs_(coverage_.size()),
+  parent_(coverage_.size()),
+  heap_pos_(coverage_.size()),
+  stamp_(coverage_.size(), 0),
+  generation_(0),
+  heap_(),
+  mark_(coverage_.size(), 0),
+  mark_generation_(0),
+  stack_(),
+  deleted_(),
+  start_(-1),
+  goal_(-1),
+  km_(0),
+  expansions_(0) {
+  for (size_t i = 0; i < obstacles.size(); ++i) {
+    Rasterize(obstacles.x[i], obstacles.y[i], obstacles.r[i], 1);
+  } /* for(i..) */
+}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+int IncrementalPlanner::CellOf(double x, double y) const {
+  int col = std::min(std::max(static_cast<int>(std::floor(x / cell_)), 0),
+                     cols_ - 1);
+  int row = std::min(std::max(static_cast<int>(std::floor(y / cell_)), 0),
+                     rows_ - 1);
+  return row * cols_ + col;
+} /* CellOf() */
+
+int64_t IncrementalPlanner::Cost(int u, int v) const {
+  if (blocked(v)) {
+    return kInfinity;
+  }
+  int dc = v % cols_ - u % cols_;
+  int dr = v / cols_ - u / cols_;
+  if (dc && dr) {
+    // A path may leave a blocked cell any way it can
+    if (!blocked(u) && (blocked(u + dc) || blocked(u + dr * cols_))) {
+      return kInfinity;
+    }
+    return kDiagonal;
+  }
+  return kStraight;
+} /* Cost() */
+
+int64_t IncrementalPlanner::Heuristic(int a, int b) const {
+  int dc = std::abs(a % cols_ - b % cols_);
+  int dr = std::abs(a / cols_ - b / cols_);
+  return kStraight * std::max(dc, dr) +
+      (kDiagonal - kStraight) * std::min(dc, dr);
+} /* Heuristic() */
+
+void IncrementalPlanner::Touch(int cell) {
+  if (stamp_[cell] != generation_) {
+    stamp_[cell] = generation_;
+    g_[cell] = kInfinity;
+    rhs_[cell] = kInfinity;
+    parent_[cell] = -1;
+    heap_pos_[cell] = -1;
+  }
+} /* Touch() */
+
+int64_t IncrementalPlanner::g(int cell) const {
+  return stamp_[cell] == generation_ ? g_[cell] : kInfinity;
+} /* g() */
+
+int64_t IncrementalPlanner::rhs(int cell) const {
+  return stamp_[cell] == generation_ ? rhs_[cell] : kInfinity;
+} /* rhs() */
+
+int IncrementalPlanner::parent(int cell) const {
+  return stamp_[cell] == generation_ ? parent_[cell] : -1;
+} /* parent() */
+
+void IncrementalPlanner::AddObstacle(double x, double y, double radius) {
+  Rasterize(x, y, radius, 1);
+} /* AddObstacle() */
+
+void IncrementalPlanner::RemoveObstacle(double x, double y, double radius) {
+  Rasterize(x, y, radius, -1);
+} /* RemoveObstacle() */
+
+void IncrementalPlanner::Rasterize(double x, double y, double radius,
+                                   int delta) {
+  double r = radius + clearance_;
+  int c0 = std::max(0, static_cast<int>(std::floor((x - r) / cell_)));
+  int c1 = std::min(cols_ - 1, static_cast<int>(std::floor((x + r) / cell_)));
+  int r0 = std::max(0, static_cast<int>(std::floor((y - r) / cell_)));
+  int r1 = std::min(rows_ - 1, static_cast<int>(std::floor((y + r) / cell_)));
+  for (int row = r0; row <= r1; ++row) {
+    for (int col = c0; col <= c1; ++col) {
+      double dx = (col + 0.5) * cell_ - x;
+      double dy = (row + 0.5) * cell_ - y;
+      if (dx * dx + dy * dy > r * r) {
+        continue;
+      }
+      int cell = row * cols_ + col;
+      bool was_blocked = blocked(cell);
+      coverage_[cell] += delta;
+      if (start_ < 0 || was_blocked == blocked(cell)) {
+        continue;
+      }
+      // The edges into and out of the cell, and the diagonals past its
+      // corners, all end at it or its neighbors
+      for (int k = -1; k < 8; ++k) {
+        int ncol = col + (k < 0 ? 0 : kDx[k]);
+        int nrow = row + (k < 0 ? 0 : kDy[k]);
+        if (ncol < 0 || ncol >= cols_ || nrow < 0 || nrow >= rows_) {
+          continue;
+        }
+        int s = nrow * cols_ + ncol;
+        if (s != start_) {
+          UpdateRhs(s);
+          UpdateState(s);
+        }
+      } /* for(k..) */
+    } /* for(col..) */
+  } /* for(row..) */
+} /* Rasterize() */
+
+void IncrementalPlanner::Reset(void) {
+  ++generation_;
+  heap_.clear();
+  start_ = -1;
+  goal_ = -1;
+} /* Reset() */
+
+void IncrementalPlanner::Initialize(int start) {
+  ++generation_;
+  heap_.clear();
+  km_ = 0;
+  start_ = start;
+  Touch(start);
+  rhs_[start] = 0;
+  HeapPush(start);
+} /* Initialize() */
+
+void IncrementalPlanner::MoveStart(int start) {
+  if (rhs(start) == kInfinity) {
+    // Somewhere the last search never reached: nothing to keep
+    Initialize(start);
+    return;
+  }
+  // The tree below the new start stays; the search from the old start never
+  // descends into it, since the new start is the only way in
+  const uint32_t seen = ++mark_generation_;
+  mark_[start] = seen;
+  deleted_.clear();
+  stack_.assign(1, start_);
+  mark_[start_] = seen;
+  while (!stack_.empty()) {
+    int u = stack_.back();
+    stack_.pop_back();
+    int col = u % cols_;
+    int row = u / cols_;
+    for (int k = 0; k < 8; ++k) {
+      int ncol = col + kDx[k];
+      int nrow = row + kDy[k];
+      if (ncol < 0 || ncol >= cols_ || nrow < 0 || nrow >= rows_) {
+        continue;
+      }
+      int v = nrow * cols_ + ncol;
+      if (mark_[v] != seen && parent(v) == u) {
+        mark_[v] = seen;
+        stack_.push_back(v);
+      }
+    } /* for(k..) */
+    Touch(u);
+    if (heap_pos_[u] >= 0) {
+      HeapRemove(u);
+    }
+    g_[u] = kInfinity;
+    rhs_[u] = kInfinity;
+    parent_[u] = -1;
+    deleted_.push_back(u);
+  } /* while() */
+
+  start_ = start;
+  parent_[start] = -1;
+  // The border of what was kept is where the search picks up again
+  for (int u : deleted_) {
+    UpdateRhs(u);
+    UpdateState(u);
+  } /* for(u..) */
+} /* MoveStart() */
+
+void IncrementalPlanner::UpdateRhs(int cell) {
+  Touch(cell);
+  int64_t best = kInfinity;
+  int best_parent = -1;
+  int col = cell % cols_;
+  int row = cell / cols_;
+  for (int k = 0; k < 8; ++k) {
+    int ncol = col + kDx[k];
+    int nrow = row + kDy[k];
+    if (ncol < 0 || ncol >= cols_ || nrow < 0 || nrow >= rows_) {
+      continue;
+    }
+    int u = nrow * cols_ + ncol;
+    int64_t cost = g(u) + Cost(u, cell);
+    if (cost < best) {
+      best = cost;
+      best_parent = u;
+    }
+  } /* for(k..) */
+  rhs_[cell] = best;
+  parent_[cell] = best_parent;
+} /* UpdateRhs() */
+
+void IncrementalPlanner::UpdateState(int cell) {
+  Touch(cell);
+  bool open = heap_pos_[cell] >= 0;
+  if (g_[cell] != rhs_[cell]) {
+    if (open) {
+      HeapUpdate(cell);
+    } else {
+      HeapPush(cell);
+    }
+  } else if (open) {
+    HeapRemove(cell);
+  }
+} /* UpdateState() */
+
+bool IncrementalPlanner::ComputePath(void) {
+  while (!heap_.empty() &&
+         (Less(heap_[0], Key(goal_)) || rhs(goal_) > g(goal_))) {
+    ++expansions_;
+    open_entry top = heap_[0];
+    int u = top.cell;
+    if (Less(top, Key(u))) {
+      // Queued under an older goal
+      HeapUpdate(u);
+      continue;
+    }
+    int col = u % cols_;
+    int row = u / cols_;
+    if (g_[u] > rhs_[u]) {
+      g_[u] = rhs_[u];
+      HeapRemove(u);
+      for (int k = 0; k < 8; ++k) {
+        int ncol = col + kDx[k];
+        int nrow = row + kDy[k];
+        if (ncol < 0 || ncol >= cols_ || nrow < 0 || nrow >= rows_) {
+          continue;
+        }
+        int s = nrow * cols_ + ncol;
+        int64_t cost = g_[u] + Cost(u, s);
+        if (s != start_ && cost < rhs(s)) {
+          Touch(s);
+          parent_[s] = u;
+          rhs_[s] = cost;
+          UpdateState(s);
+        }
+      } /* for(k..) */
+    } else {
+      g_[u] = kInfinity;
+      UpdateState(u);
+      for (int k = 0; k < 8; ++k) {
+        int ncol = col + kDx[k];
+        int nrow = row + kDy[k];
+        if (ncol < 0 || ncol >= cols_ || nrow < 0 || nrow >= rows_) {
+          continue;
+        }
+        int s = nrow * cols_ + ncol;
+        if (s != start_ && parent(s) == u) {
+          UpdateRhs(s);
+          UpdateState(s);
+        }
+      } /* for(k..) */
+    }
+  } /* while() */
+  return rhs(goal_) < kInfinity;
+} /* ComputePath() */
+
+bool IncrementalPlanner::FindPath(const Position& start, const Position& goal,
+                                  std::vector<Position> * path) {
+  int s = CellOf(RealToDouble(start.x), RealToDouble(start.y));
+  int t = CellOf(RealToDouble(goal.x), RealToDouble(goal.y));
+  if (start_ < 0) {
+    goal_ = t;
+    Initialize(s);
+  } else {
+    if (t != goal_) {
+      // Keys queued for the old goal stay lower bounds for the new one
+      km_ += Heuristic(goal_, t);
+      goal_ = t;
+    }
+    if (s != start_) {
+      MoveStart(s);
+    }
+  }
+  path->clear();
+  if (blocked(t) && s != t) {
+    return false;
+  }
+  if (!ComputePath()) {
+    return false;
+  }
+  size_t limit = coverage_.size();
+  for (int c = parent(t); c >= 0 && c != s && path->size() < limit;
+       c = parent(c)) {
+    path->push_back(Position((c % cols_ + 0.5) * cell_,
+                             (c / cols_ + 0.5) * cell_));
+  } /* for(c..) */
+  std::reverse(path->begin(), path->end());
+  path->push_back(goal);
+  return true;
+} /* FindPath() */
+
+double IncrementalPlanner::path_cost(void) const {
+  if (start_ < 0 || goal_ < 0 || rhs(goal_) == kInfinity) {
+    return std::numeric_limits<double>::infinity();
+  }
+  // Costs are kept from wherever the tree was first rooted
+  return static_cast<double>(rhs(goal_) - rhs(start_)) / kStraight * cell_;
+} /* path_cost() */
+
+IncrementalPlanner::open_entry IncrementalPlanner::Key(int cell) const {
+  int64_t m = std::min(g(cell), rhs(cell));
+  open_entry e;
+  e.k1 = m + Heuristic(cell, goal_) + km_;
+  e.k2 = m;
+  e.cell = cell;
+  return e;
+} /* Key() */
+
+void IncrementalPlanner::HeapPush(int cell) {
+  heap_pos_[cell] = static_cast<int32_t>(heap_.size());
+  heap_.push_back(Key(cell));
+  SiftUp(heap_.size() - 1);
+} /* HeapPush() */
+
+void IncrementalPlanner::HeapUpdate(int cell) {
+  size_t i = heap_pos_[cell];
+  heap_[i] = Key(cell);
+  SiftUp(i);
+  SiftDown(heap_pos_[cell]);
+} /* HeapUpdate() */
+
+void IncrementalPlanner::HeapRemove(int cell) {
+  size_t i = heap_pos_[cell];
+  heap_pos_[cell] = -1;
+  open_entry last = heap_.back();
+  heap_.pop_back();
+  if (i < heap_.size()) {
+    heap_[i] = last;
+    heap_pos_[last.cell] = static_cast<int32_t>(i);
+    SiftUp(i);
+    SiftDown(heap_pos_[last.cell]);
+  }
+} /* HeapRemove() */
+
+void IncrementalPlanner::SiftUp(size_t i) {
+  while (i > 0) {
+    size_t up = (i - 1) / 2;
+    if (!Less(heap_[i], heap_[up])) {
+      break;
+    }
+    std::swap(heap_[i], heap_[up]);
+    heap_pos_[heap_[i].cell] = static_cast<int32_t>(i);
+    heap_pos_[heap_[up].cell] = static_cast<int32_t>(up);
+    i = up;
+  } /* while() */
+} /* SiftUp() */
+
+void IncrementalPlanner::SiftDown(size_t i) {
+  for (;;) {
+    size_t least = i;
+    size_t left = 2 * i + 1;
+    size_t right = left + 1;
+    if (left < heap_.size() && Less(heap_[left], heap_[least])) {
+      least = left;
+    }
+    if (right < heap_.size() && Less(heap_[right], heap_[least])) {
+      least = right;
+    }
+    if (least == i) {
+      return;
+    }
+    std::swap(heap_[i], heap_[least]);
+    heap_pos_[heap_[i].cell] = static_cast<int32_t>(i);
+    heap_pos_[heap_[least].cell] = static_cast<int32_t>(least);
+    i = least;
+  } /* for(;;) */
+} /* SiftDown() */
+
+NAMESPACE_END(csci3081);
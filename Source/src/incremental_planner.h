@@ -0,0 +1,168 @@
+/**
+ * @file incremental_planner.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_INCREMENTAL_PLANNER_H_
+#define SRC_INCREMENTAL_PLANNER_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include <vector>
+#include "src/common.h"
+#include "src/ray_cast.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+struct incremental_planner_params {
+  incremental_planner_params(void) : cell_size(8), clearance(0) {}
+
+  double cell_size;
+  // Added to every obstacle's radius when marking cells blocked
+  double clearance;
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Shortest paths on a grid between a start and a goal that both move,
+ * repairing the last search rather than starting over (Moving Target D*
+ * Lite, Sun, Yeoh and Koenig 2010).
+ *
+ * The search grows from the start, 8-connected over the free cells (with
+ * diagonal steps costing 1.4), and
+ * keeps its tree between calls to FindPath():
+ * - When the goal moves, only the heuristic changes. The keys in the open
+ *   list are kept valid by adding how far it moved to an offset, and the
+ *   search resumes until the new goal is settled.
+ * - When the start moves, the part of the tree that does not hang from the
+ *   new start is thrown away and its border put back in the open list; the
+ *   rest is kept as it is.
+ * - When an obstacle is added or removed, the cells around the ones that
+ *   changed are updated and the search repairs from there.
+ *
+ * Reset() forgets the search, for comparing against planning from scratch.
+ */
+class IncrementalPlanner {
+ public:
+  IncrementalPlanner(uint x_dim, uint y_dim,
+                     const struct circle_batch& obstacles,
+                     const struct incremental_planner_params& params);
+
+  void AddObstacle(double x, double y, double radius);
+  void RemoveObstacle(double x, double y, double radius);
+
+  /**
+   * @brief Whether (x, y) is in a blocked cell. Paths never enter one, but
+   * may leave the one they start in.
+   */
+  bool Blocked(double x, double y) const { return blocked(CellOf(x, y)); }
+
+  /**
+   * @brief Find the shortest path from start to goal, reusing what is left
+   * of the last search.
+   *
+   * @param[out] path The centers of the cells after start's, then goal.
+   *
+   * @return false if goal cannot be reached.
+   */
+  bool FindPath(const Position& start, const Position& goal,
+                std::vector<Position> * path);
+
+  /**
+   * @brief Length of the path last found.
+   */
+  double path_cost(void) const;
+
+  void Reset(void);
+
+  /**
+   * @brief Cells taken off the open list so far, over all searches.
+   */
+  uint64_t expansions(void) const { return expansions_; }
+
+ private:
+  // The open list orders cells by (k1, k2)
+  struct open_entry {
+    int64_t k1;
+    int64_t k2;
+    int cell;
+  };
+
+  int CellOf(double x, double y) const;
+  bool blocked(int cell) const { return coverage_[cell] != 0; }
+
+  /**
+   * @brief Step cost from u to its neighbor v, or infinity where there is no
+   * edge: into a blocked cell, or diagonally past one.
+   */
+  int64_t Cost(int u, int v) const;
+  int64_t Heuristic(int a, int b) const;
+
+  /**
+   * @brief Bring a cell's entry up to the current search, as never seen if
+   * it dates from an earlier one.
+   */
+  void Touch(int cell);
+  int64_t g(int cell) const;
+  int64_t rhs(int cell) const;
+  int parent(int cell) const;
+
+  void Rasterize(double x, double y, double radius, int delta);
+  void Initialize(int start);
+  void MoveStart(int start);
+  void UpdateState(int cell);
+
+  /**
+   * @brief Set rhs and the parent of cell from its cheapest predecessor.
+   */
+  void UpdateRhs(int cell);
+  bool ComputePath(void);
+
+  bool Less(const open_entry& a, const open_entry& b) const {
+    return a.k1 < b.k1 || (a.k1 == b.k1 && a.k2 < b.k2);
+  }
+  open_entry Key(int cell) const;
+  void HeapPush(int cell);
+  void HeapRemove(int cell);
+  void HeapUpdate(int cell);
+  void SiftUp(size_t i);
+  void SiftDown(size_t i);
+
+  double cell_;
+  double clearance_;
+  int cols_;
+  int rows_;
+  std::vector<uint16_t> coverage_;
+  // Per cell search state, valid where stamp_ matches generation_
+  std::vector<int64_t> g_;
+  std::vector<int64_t> rhs_;
+  std::vector<int32_t> parent_;
+  std::vector<int32_t> heap_pos_;
+  std::vector<uint32_t> stamp_;
+  uint32_t generation_;
+  std::vector<open_entry> heap_;
+  // Scratch for MoveStart()
+  std::vector<uint32_t> mark_;
+  uint32_t mark_generation_;
+  std::vector<int> stack_;
+  std::vector<int> deleted_;
+  int start_;
+  int goal_;
+  int64_t km_;
+  uint64_t expansions_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif /* SRC_INCREMENTAL_PLANNER_H_ */
@@ -0,0 +1,84 @@
+/**
+ * @file input_queue.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/input_queue.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constant Definitions
+ ******************************************************************************/
+static_assert((INPUT_QUEUE_CAPACITY & (INPUT_QUEUE_CAPACITY - 1)) == 0,
+              "INPUT_QUEUE_CAPACITY must be a power of two");
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+InputQueue::InputQueue(void) : head_(0), head_pad_(), tail_(0), latency_(),
+                               dropped_(0), tracker_(nullptr), cells_() {
+  for (uint64_t i = 0; i < INPUT_QUEUE_CAPACITY; ++i) {
+    cells_[i].seq.store(i, std::memory_order_relaxed);
+  } /* for(i..) */
+}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+bool InputQueue::Push(const struct input_record& record) {
+  uint64_t pos = head_.load(std::memory_order_relaxed);
+  cell * c;
+  for (;;) {
+    c = &cells_[pos % INPUT_QUEUE_CAPACITY];
+    uint64_t seq = c->seq.load(std::memory_order_acquire);
+    int64_t lag = static_cast<int64_t>(seq - pos);
+    if (lag == 0) {
+      // Free for pos; claim it, or learn where head_ has got to
+      if (head_.compare_exchange_weak(pos, pos + 1,
+                                      std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (lag < 0) {
+      // Still holding the input from a lap ago: full
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    } else {
+      pos = head_.load(std::memory_order_relaxed);
+    }
+  } /* for(;;) */
+  c->record = record;
+  c->seq.store(pos + 1, std::memory_order_release);
+  return true;
+} /* Push() */
+
+bool InputQueue::Pop(struct input_record * out) {
+  cell& c = cells_[tail_ % INPUT_QUEUE_CAPACITY];
+  if (c.seq.load(std::memory_order_acquire) != tail_ + 1) {
+    // Empty, or the next input is claimed but not yet filled in
+    return false;
+  }
+  *out = c.record;
+  c.seq.store(tail_ + INPUT_QUEUE_CAPACITY, std::memory_order_release);
+  ++tail_;
+  return true;
+} /* Pop() */
+
+void InputQueue::PrintSummary(FILE * fp) const {
+  fprintf(fp, "%llu inputs applied (%llu dropped); input to step %.3f ms "
+          "mean, %.3f ms max\n",
+          static_cast<unsigned long long>(latency_.applied),
+          static_cast<unsigned long long>(dropped()),
+          latency_.applied ?
+              latency_.total_ns / 1e6 / latency_.applied : 0.0,
+          latency_.max_ns / 1e6);
+} /* PrintSummary() */
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,161 @@
+/**
+ * @file input_queue.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_INPUT_QUEUE_H_
+#define SRC_INPUT_QUEUE_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <atomic>
+#include "src/common.h"
+#include "src/event_commands.h"
+#include "src/latency_tracker.h"
+#include "src/registry.h"
+#include "src/trace.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constant Definitions
+ ******************************************************************************/
+// Inputs that can wait for the next step; a power of two
+#define INPUT_QUEUE_CAPACITY 256
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief A command as the user gave it, before the simulation took it.
+ */
+struct input_record {
+  // kNoEntity for the player's robot, whichever that is when it is applied
+  entity_id target;
+  enum event_commands command;
+  // Tracer::NowNs() when the input happened
+  uint64_t input_ns;
+};
+
+/**
+ * @brief From an input happening to the start of the step that applies it.
+ */
+struct input_latency {
+  input_latency(void) : applied(0), total_ns(0), max_ns(0) {}
+
+  uint64_t applied;
+  uint64_t total_ns;
+  uint64_t max_ns;
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Commands on their way from input handlers to the simulation.
+ *
+ * Any number of threads Push(), without locks: each claims a cell with one
+ * compare-and-swap and publishes it with a store of the cell's sequence
+ * number. The one thread that steps the simulation drains the queue at the
+ * start of each step (see Arena::input_queue()), so commands change the
+ * robots only at step boundaries, never while a step or a frame is under
+ * way.
+ *
+ * A full queue drops the input, and counts it, rather than making the
+ * input thread wait.
+ */
+class InputQueue {
+ public:
+  InputQueue(void);
+
+  /**
+   * @brief Queue command for target, stamped with the time now. Safe from
+   * any thread.
+   *
+   * @return false if the queue is full.
+   */
+  bool Push(entity_id target, enum event_commands command) {
+    return Push(input_record {target, command, Tracer::NowNs()});
+  }
+  bool Push(const struct input_record& record);
+
+  /**
+   * @brief Hand every queued input to apply, oldest first, and charge each
+   * one's wait to latency() and the latency_tracker(), if any. Only the
+   * simulation's thread may drain.
+   *
+   * @return How many inputs were drained.
+   */
+  template <typename F>
+  size_t Drain(F apply) {
+    uint64_t now = Tracer::NowNs();
+    input_record record;
+    size_t n = 0;
+    while (Pop(&record)) {
+      apply(record);
+      uint64_t waited = now > record.input_ns ? now - record.input_ns : 0;
+      ++latency_.applied;
+      latency_.total_ns += waited;
+      latency_.max_ns = std::max(latency_.max_ns, waited);
+      if (tracker_) {
+        tracker_->Applied(record.input_ns, now);
+      }
+      ++n;
+    } /* while() */
+    return n;
+  }
+
+  /**
+   * @brief Read by the simulation's thread only.
+   */
+  const struct input_latency& latency(void) const { return latency_; }
+  uint64_t dropped(void) const {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Follow each drained input on to the frame that shows it. Pass
+   * nullptr to detach. The queue does not take ownership.
+   */
+  void latency_tracker(InputLatencyTracker * tracker) { tracker_ = tracker; }
+
+  /**
+   * @brief Write how many inputs were applied and how long they waited.
+   */
+  void PrintSummary(FILE * fp) const;
+
+ private:
+  struct cell {
+    // pos while free for the Push() that claims position pos, pos + 1 once
+    // that Push() has filled it
+    std::atomic<uint64_t> seq;
+    input_record record;
+  };
+
+  bool Pop(struct input_record * out);
+
+  InputQueue& operator=(const InputQueue& other) = delete;
+  InputQueue(const InputQueue& other) = delete;
+
+  // Claimed by producers; padded out to a cache line of its own, rather
+  // than aligned, so the queue can live in objects made with plain new
+  std::atomic<uint64_t> head_;
+  char head_pad_[64 - sizeof(std::atomic<uint64_t>)];
+  uint64_t tail_;
+  struct input_latency latency_;
+  std::atomic<uint64_t> dropped_;
+  InputLatencyTracker * tracker_;
+  cell cells_[INPUT_QUEUE_CAPACITY];
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_INPUT_QUEUE_H_
@@ -0,0 +1,101 @@
+/**
+ * @file latency_tracker.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/latency_tracker.h"
+#include <algorithm>
+#include <cmath>
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constant Definitions
+ ******************************************************************************/
+// Inputs kept waiting for a frame, e.g. while the window is hidden, before
+// the oldest are given up on
+static const size_t kMaxPending = 1024;
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+LatencyWindow::LatencyWindow(size_t capacity) : samples_(capacity, 0),
+                                                next_(0), count_(0),
+                                                scratch_() {
+  scratch_.reserve(capacity);
+}
+
+InputLatencyTracker::InputLatencyTracker(void)
+    : pending_(), to_step_(LATENCY_WINDOW_SIZE),
+      to_frame_(LATENCY_WINDOW_SIZE), log_(nullptr), n_presented_(0) {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void LatencyWindow::Add(uint64_t ns) {
+  samples_[next_] = ns;
+  next_ = (next_ + 1) % samples_.size();
+  count_ = std::min(count_ + 1, samples_.size());
+} /* Add() */
+
+uint64_t LatencyWindow::Percentile(double p) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  scratch_.assign(samples_.begin(), samples_.begin() + count_);
+  size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * count_));
+  size_t k = std::min(count_ - 1, rank ? rank - 1 : 0);
+  std::nth_element(scratch_.begin(), scratch_.begin() + k, scratch_.end());
+  return scratch_[k];
+} /* Percentile() */
+
+void InputLatencyTracker::Applied(uint64_t input_ns, uint64_t applied_ns) {
+  if (pending_.size() >= kMaxPending) {
+    pending_.erase(pending_.begin());
+  }
+  pending_.push_back(pending_input {input_ns, applied_ns, false});
+  to_step_.Add(applied_ns > input_ns ? applied_ns - input_ns : 0);
+} /* Applied() */
+
+void InputLatencyTracker::StepDone(void) {
+  for (pending_input& p : pending_) {
+    p.stepped = true;
+  } /* for(p..) */
+} /* StepDone() */
+
+void InputLatencyTracker::FramePresented(uint64_t presented_ns) {
+  // Inputs are applied in order, so the stepped ones come first
+  size_t n = 0;
+  while (n < pending_.size() && pending_[n].stepped) {
+    const pending_input& p = pending_[n];
+    uint64_t to_frame =
+        presented_ns > p.input_ns ? presented_ns - p.input_ns : 0;
+    to_frame_.Add(to_frame);
+    ++n_presented_;
+    if (log_) {
+      fprintf(log_, "%.1f,%.1f\n",
+              (p.applied_ns > p.input_ns ? p.applied_ns - p.input_ns : 0) /
+                  1e3,
+              to_frame / 1e3);
+    }
+    ++n;
+  } /* while() */
+  pending_.erase(pending_.begin(), pending_.begin() + n);
+} /* FramePresented() */
+
+void InputLatencyTracker::PrintSummary(FILE * fp) const {
+  fprintf(fp, "%llu inputs shown; over the last %zu, input to frame "
+          "p50 %.2f p90 %.2f p99 %.2f max %.2f ms\n",
+          static_cast<unsigned long long>(n_presented_), to_frame_.size(),
+          to_frame_.Percentile(50) / 1e6, to_frame_.Percentile(90) / 1e6,
+          to_frame_.Percentile(99) / 1e6, to_frame_.Percentile(100) / 1e6);
+} /* PrintSummary() */
+
+NAMESPACE_END(csci3081);
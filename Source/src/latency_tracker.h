@@ -0,0 +1,110 @@
+/**
+ * @file latency_tracker.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_LATENCY_TRACKER_H_
+#define SRC_LATENCY_TRACKER_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constant Definitions
+ ******************************************************************************/
+// Inputs the rolling percentiles are taken over
+#define LATENCY_WINDOW_SIZE 128
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief The last few latencies, in nanoseconds, and percentiles of them.
+ */
+class LatencyWindow {
+ public:
+  explicit LatencyWindow(size_t capacity);
+
+  void Add(uint64_t ns);
+  size_t size(void) const { return count_; }
+
+  /**
+   * @brief The nearest-rank percentile p, in [0, 100], of the samples in
+   * the window; 0 if it is empty.
+   */
+  uint64_t Percentile(double p) const;
+
+ private:
+  std::vector<uint64_t> samples_;
+  size_t next_;
+  size_t count_;
+  // Reordered by Percentile(), so samples_ keeps its order
+  mutable std::vector<uint64_t> scratch_;
+};
+
+/**
+ * @brief Follows each user input from the moment it happened, through the
+ * step that applied it, to the first frame drawn after that step: the
+ * latency a player feels, short of the buffer swap and the display itself.
+ *
+ * Applied() is called by the InputQueue as the arena drains it,
+ * StepDone() after each step and FramePresented() when a frame has been
+ * drawn, all from the one thread that runs the viewer's loop.
+ */
+class InputLatencyTracker {
+ public:
+  InputLatencyTracker(void);
+
+  /**
+   * @brief Write a line for every input once its frame is drawn, as
+   * comma separated microseconds: input to step, input to frame. nullptr
+   * to stop. The tracker does not take ownership.
+   */
+  void log(FILE * fp) { log_ = fp; }
+
+  void Applied(uint64_t input_ns, uint64_t applied_ns);
+  void StepDone(void);
+  void FramePresented(uint64_t presented_ns);
+
+  /**
+   * @brief From an input to the start of the step applying it, and to the
+   * frame showing it, over the last LATENCY_WINDOW_SIZE inputs.
+   */
+  const LatencyWindow& to_step(void) const { return to_step_; }
+  const LatencyWindow& to_frame(void) const { return to_frame_; }
+  uint64_t n_presented(void) const { return n_presented_; }
+
+  void PrintSummary(FILE * fp) const;
+
+ private:
+  InputLatencyTracker& operator=(const InputLatencyTracker& other) = delete;
+  InputLatencyTracker(const InputLatencyTracker& other) = delete;
+
+  struct pending_input {
+    uint64_t input_ns;
+    uint64_t applied_ns;
+    // The step that applied it has finished, so the next frame shows it
+    bool stepped;
+  };
+
+  std::vector<pending_input> pending_;
+  LatencyWindow to_step_;
+  LatencyWindow to_frame_;
+  FILE * log_;
+  uint64_t n_presented_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_LATENCY_TRACKER_H_
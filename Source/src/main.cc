@@ -7,9 +7,13 @@
 /*******************************************************************************
  * Includes
  ******************************************************************************/
+#include <string.h>
 #include "src/graphics_arena_viewer.h"
 #include "src/arena_params.h"
-#include "src/color.h"
+#include "src/arena_defaults.h"
+#include "src/scenario.h"
+#include "src/static_map.h"
+#include "src/trace.h"
 
 /*******************************************************************************
  * Non-Member Functions
@@ -19,60 +23,86 @@
  * arena and robot parameters. Also instantiates a graphics window
  * used to visualize the arena. Also defines boundaries of the
  * arena. 
+ *
+ * Passing `--trace <file>` records sim, render and input spans and writes
+ * them to <file> as Chrome trace JSON when the window is closed. Passing
+ * `--scenario <file>` loads the arena from a scenario file instead of the
+ * built-in layout. Passing `--map <file>` takes the obstacles and the size of
+ * the arena from a static map compiled by the headless runner. Passing
+ * `--latency-log <file>` writes, for each arrow key press, how long it took
+ * to reach a step and to be drawn, in microseconds.
  */
-int main(int, char **) {
+int main(int argc, char **argv) {
+  const char * trace_path = nullptr;
+  const char * scenario_path = nullptr;
+  const char * map_path = nullptr;
+  const char * latency_log_path = nullptr;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+      trace_path = argv[++i];
+    } else if (strcmp(argv[i], "--scenario") == 0 && i + 1 < argc) {
+      scenario_path = argv[++i];
+    } else if (strcmp(argv[i], "--map") == 0 && i + 1 < argc) {
+      map_path = argv[++i];
+    } else if (strcmp(argv[i], "--latency-log") == 0 && i + 1 < argc) {
+      latency_log_path = argv[++i];
+    }
+  } /* for(i..) */
+  if (trace_path) {
+    csci3081::Tracer::Instance().enabled(true);
+    csci3081::Tracer::Instance().ThreadName("ui+sim");
+  }
+
   // Essential call to initiate the graphics window
   csci3081::InitGraphics();
 
   // Initialize default start values for various arena entities
-  csci3081::robot_params rparams;
-
-  rparams.battery_max_charge = 100.0;
-  rparams.angle_delta = 10;
-  rparams.collision_delta = 2;
-  rparams.radius = 20.0;
-  rparams.pos = Position(500, 500);
-  rparams.color = csci3081::Color(0, 0, 255, 255); /* blue */
-
   csci3081::arena_params aparams;
-
-  aparams.robot = rparams;
-
-  aparams.recharge_station.radius = 20.0;
-  aparams.recharge_station.pos = {500, 300};
-  aparams.recharge_station.color = csci3081::Color(0, 128, 128, 255);
-  /* green */
-
-  aparams.home_base.radius = 20.0;
-  aparams.home_base.pos = {400, 400};
-  aparams.home_base.color = csci3081::Color(255, 0, 0, 255); /* red */
-  // Arbitrary positions used to instantiate the obstacles.
-  // Radius and color are copied from the first obstacle, all white.
-  aparams.obstacles[0].radius = 30.0;
-  aparams.obstacles[0].pos = {200, 200};
-  aparams.obstacles[0].color = csci3081::Color(255, 255, 255, 255); /* white */
-  aparams.obstacles[1].radius = 30.0;
-  aparams.obstacles[1].pos = {400, 600};
-  aparams.obstacles[1].color = csci3081::Color(255, 255, 255, 255);
-  aparams.obstacles[2].radius = 30.0;
-  aparams.obstacles[2].pos = {200, 350};
-  aparams.obstacles[2].color = csci3081::Color(255, 255, 255, 255);
-  aparams.obstacles[3].radius = 30.0;
-  aparams.obstacles[3].pos = {700, 300};
-  aparams.obstacles[3].color = csci3081::Color(255, 255, 255, 255);
-  aparams.obstacles[4].radius = 30.0;
-  aparams.obstacles[4].pos = {400, 100};
-  aparams.obstacles[4].color = csci3081::Color(255, 255, 255, 255);
-  // aparams.n_obstacles changed from 1 to 5 to fulfill priority 3 req.
-  aparams.n_obstacles = 5;
-  aparams.x_dim = 1024;
-  aparams.y_dim = 768;
+  csci3081::DefaultArenaParams(&aparams);
+  std::string error;
+  if (scenario_path &&
+      !csci3081::LoadScenario(scenario_path, &aparams, &error)) {
+    fprintf(stderr, "%s\n", error.c_str());
+    csci3081::ShutdownGraphics();
+    return 1;
+  }
+  csci3081::StaticMap map;
+  if (map_path) {
+    if (!map.Open(map_path, &error)) {
+      fprintf(stderr, "%s\n", error.c_str());
+      csci3081::ShutdownGraphics();
+      return 1;
+    }
+    aparams.obstacles.clear();
+    aparams.x_dim = map.x_dim();
+    aparams.y_dim = map.y_dim();
+    aparams.static_map = &map;
+  }
 
   // Start up the graphics (which creates the arena).
   // Run will enter the nanogui::mainloop()
   csci3081::GraphicsArenaViewer *app =
     new csci3081::GraphicsArenaViewer(&aparams);
+  FILE * latency_log = nullptr;
+  if (latency_log_path) {
+    latency_log = fopen(latency_log_path, "w");
+    if (!latency_log) {
+      fprintf(stderr, "Unable to write latencies to %s\n", latency_log_path);
+    } else {
+      fprintf(latency_log, "input_to_step_us,input_to_frame_us\n");
+      app->latency_tracker().log(latency_log);
+    }
+  }
   app->Run();
+  app->input_queue().PrintSummary(stderr);
+  app->latency_tracker().PrintSummary(stderr);
+  if (latency_log) {
+    app->latency_tracker().log(nullptr);
+    fclose(latency_log);
+  }
+  if (trace_path && !csci3081::Tracer::Instance().Dump(trace_path)) {
+    fprintf(stderr, "Unable to write trace to %s\n", trace_path);
+  }
   csci3081::ShutdownGraphics();
   return 0;
 }
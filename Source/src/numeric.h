@@ -0,0 +1,63 @@
+/**
+ * @file numeric.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_NUMERIC_H_
+#define SRC_NUMERIC_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cmath>
+#include "src/common.h"
+#include "src/fixed_point.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Type Definitions
+ ******************************************************************************/
+/**
+ * @brief The scalar used by motion, collision and battery code.
+ *
+ * Building with -DARENA_FIXED_POINT (`make FIXED_POINT=1`) switches it to the
+ * integer-only Fixed type, which makes a run bit-exact across machines,
+ * compilers and optimization flags. The default is double.
+ */
+#ifdef ARENA_FIXED_POINT
+typedef Fixed real_t;
+#else
+typedef double real_t;
+#endif
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+#ifdef ARENA_FIXED_POINT
+inline real_t RealSqrt(real_t x) { return FixedSqrt(x); }
+inline real_t RealSinDeg(real_t deg) { return FixedSinDeg(deg); }
+inline real_t RealCosDeg(real_t deg) { return FixedCosDeg(deg); }
+inline real_t RealAtan2Deg(real_t y, real_t x) { return FixedAtan2Deg(y, x); }
+#else
+inline real_t RealSqrt(real_t x) { return std::sqrt(x); }
+inline real_t RealSinDeg(real_t deg) { return std::sin(deg * M_PI / 180.0); }
+inline real_t RealCosDeg(real_t deg) { return std::cos(deg * M_PI / 180.0); }
+inline real_t RealAtan2Deg(real_t y, real_t x) {
+  real_t deg = std::atan2(y, x) * 180.0 / M_PI;
+  return deg < 0 ? deg + 360.0 : deg;
+}
+#endif
+
+/**
+ * @brief Convert for printing and drawing, which always use double.
+ */
+inline double RealToDouble(real_t x) { return static_cast<double>(x); }
+
+NAMESPACE_END(csci3081);
+
+#endif /* SRC_NUMERIC_H_ */
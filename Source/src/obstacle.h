@@ -29,25 +29,24 @@ NAMESPACE_BEGIN(csci3081);
  */
 class Obstacle: public ArenaImmobileEntity {
  public:
-  Obstacle(double radius, const Position& pos,
-                   const Color& color);
-
-  std::string name(void) const {
-    return "Obstacle" + std::to_string(id_);
-  }
   /**
-  * @brief Resets the next_id_ val to 0
-  * when Arena::Reset() is called. This is so that
-  * when the Arena state is reset, the id_ of the obstacle
-  * doesn't increase.
+  * @brief Add a new obstacle to the registry.
   */
-  void Reset() {
-    next_id_ = 0;
-  }
- private:
-  static uint next_id_;
+  Obstacle(Registry * registry, real_t radius, const Position& pos,
+           const Color& color) :
+      Obstacle(registry, KIND_OBSTACLE, radius, pos, color) {}
 
-  int id_;
+  /**
+  * @brief View an existing obstacle.
+  */
+  Obstacle(Registry * registry, entity_id id) :
+      ArenaImmobileEntity(registry, id) {}
+
+ protected:
+  Obstacle(Registry * registry, enum entity_kind kind, real_t radius,
+           const Position& pos, const Color& color) :
+      ArenaImmobileEntity(registry, Spawn(registry, kind, radius, pos,
+                                          color)) {}
 };
 
 NAMESPACE_END(csci3081);
@@ -0,0 +1,175 @@
+/**
+ * @file occupancy_patch.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/occupancy_patch.h"
+#include <string.h>
+#include <algorithm>
+#include <cmath>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "src/arena.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief OR bit into the cells of row whose columns lie in [lo, hi].
+ */
+static void FillSpan(uint8_t * row, size_t n, double lo, double hi,
+                     uint8_t bit) {
+  double last = static_cast<double>(n) - 1;
+  lo = std::max(0.0, std::ceil(lo));
+  hi = std::min(last, std::floor(hi));
+  if (lo > hi) {
+    return;
+  }
+  size_t c = static_cast<size_t>(lo);
+  size_t end = static_cast<size_t>(hi) + 1;
+#ifdef __SSE2__
+  // Sixteen cells at a time; the build does not optimize enough for the
+  // compiler to do this itself
+  if (c + 16 <= end) {
+    const __m128i vbit = _mm_set1_epi8(static_cast<char>(bit));
+    for (; c + 16 <= end; c += 16) {
+      __m128i * p = reinterpret_cast<__m128i *>(row + c);
+      _mm_storeu_si128(p, _mm_or_si128(_mm_loadu_si128(p), vbit));
+    } /* for(c..) */
+  }
+#endif
+  for (; c < end; ++c) {
+    row[c] |= bit;
+  } /* for(c..) */
+} /* FillSpan() */
+
+/**
+ * @brief Narrow [lo, hi] to the columns where a + b * column is within
+ * [0, limit].
+ */
+static void ClipToWall(double a, double b, double limit, double * lo,
+                       double * hi) {
+  if (std::fabs(b) < 1e-12) {
+    if (a < 0 || a > limit) {
+      *lo = 1;
+      *hi = 0;
+    }
+    return;
+  }
+  double t0 = -a / b;
+  double t1 = (limit - a) / b;
+  *lo = std::max(*lo, std::min(t0, t1));
+  *hi = std::min(*hi, std::max(t0, t1));
+} /* ClipToWall() */
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void PatchRasterizer::Render(const Arena& arena, entity_id robot,
+                             const struct patch_params& params,
+                             uint8_t * out) {
+  const Registry& registry = arena.registry();
+  const size_t n = params.size;
+  const double cell = params.cell_size;
+  // Row and column of the patch's center
+  const double center = n * 0.5 - 0.5;
+  memset(out, 0, n * n);
+
+  const Position& pos = registry.transform_pool().Get(robot).pos;
+  const Vector2& heading =
+      registry.kinematics_pool().Get(robot).motion.direction();
+  double px = RealToDouble(pos.x);
+  double py = RealToDouble(pos.y);
+  double hx = RealToDouble(heading.x);
+  double hy = RealToDouble(heading.y);
+
+  // Ahead is heading and right is heading turned a quarter clockwise (y
+  // points down), so row r is (center - r) cells ahead and column c is
+  // (c - center) cells right.
+  auto draw = [&](double x, double y, double radius, uint8_t bit) {
+    double dx = x - px;
+    double dy = y - py;
+    double row = center - (dx * hx + dy * hy) / cell;
+    double col = center + (dy * hx - dx * hy) / cell;
+    double r = radius / cell;
+    double first = std::max(0.0, std::ceil(row - r));
+    double last = std::min(static_cast<double>(n) - 1, std::floor(row + r));
+    for (double i = first; i <= last; ++i) {
+      double w = std::sqrt(std::max(0.0, r * r - (i - row) * (i - row)));
+      FillSpan(out + static_cast<size_t>(i) * n, n, col - w, col + w, bit);
+    } /* for(i..) */
+  };
+
+  // Whatever could cover a cell center is within the half diagonal
+  double reach = n * 0.5 * cell * std::sqrt(2.0);
+  size_t found = arena.QueryRadius(pos, reach, params.kinds, nearby_.data(),
+                                   nearby_.size());
+  if (found > nearby_.size()) {
+    nearby_.resize(found);
+    arena.QueryRadius(pos, reach, params.kinds, nearby_.data(),
+                      nearby_.size());
+  }
+  for (size_t i = 0; i < found; ++i) {
+    entity_id e = nearby_[i];
+    if (e == robot) {
+      continue;
+    }
+    const transform& xf = registry.transform_pool().Get(e);
+    draw(RealToDouble(xf.pos.x), RealToDouble(xf.pos.y),
+         RealToDouble(xf.radius),
+         static_cast<uint8_t>(KindBit(registry.kind(e))));
+  } /* for(i..) */
+
+  const StaticMap * map = arena.static_map();
+  if (map && (params.kinds & KindBit(KIND_OBSTACLE))) {
+    uint8_t bit = static_cast<uint8_t>(KindBit(KIND_OBSTACLE));
+    map->ForEachInBox(px - reach, py - reach, px + reach, py + reach,
+                      [&](const static_obstacle& o) {
+        draw(o.x, o.y, o.radius, bit);
+      });
+  }
+
+  // Along each row the world position is linear in the column, so the
+  // cells inside the walls are one run
+  double x_dim = RealToDouble(arena.x_dim());
+  double y_dim = RealToDouble(arena.y_dim());
+  double bx = -hy * cell;
+  double by = hx * cell;
+  for (size_t i = 0; i < n; ++i) {
+    double ahead = (center - i) * cell;
+    double lo = 0;
+    double hi = static_cast<double>(n) - 1;
+    ClipToWall(px + ahead * hx - center * bx, bx, x_dim, &lo, &hi);
+    ClipToWall(py + ahead * hy - center * by, by, y_dim, &lo, &hi);
+    uint8_t * row = out + i * n;
+    if (lo > hi) {
+      FillSpan(row, n, 0, static_cast<double>(n) - 1, kPatchWall);
+      continue;
+    }
+    FillSpan(row, n, 0, std::ceil(lo) - 1, kPatchWall);
+    FillSpan(row, n, std::floor(hi) + 1, static_cast<double>(n) - 1,
+             kPatchWall);
+  } /* for(i..) */
+} /* Render() */
+
+void PatchRasterizer::RenderAll(const Arena& arena,
+                                const struct patch_params& params,
+                                uint8_t * out) {
+  const std::vector<entity_id>& robots =
+      arena.registry().of_kind(KIND_ROBOT);
+  for (size_t i = 0; i < robots.size(); ++i) {
+    Render(arena, robots[i], params, out + i * params.size * params.size);
+  } /* for(i..) */
+} /* RenderAll() */
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,89 @@
+/**
+ * @file occupancy_patch.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_OCCUPANCY_PATCH_H_
+#define SRC_OCCUPANCY_PATCH_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include <vector>
+#include "src/common.h"
+#include "src/registry.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constant Definitions
+ ******************************************************************************/
+// Set in a patch cell outside the walls; the entity kinds take the bits
+// below it, as KindBit()
+static const uint8_t kPatchWall = 0x80;
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+struct patch_params {
+  patch_params(void) : size(32), cell_size(4), kinds(kAllKinds) {}
+
+  // Cells along each side
+  size_t size;
+  // Arena units each cell covers
+  double cell_size;
+  // Which kinds of entity to draw, as KindBit()s; static map obstacles are
+  // drawn as KIND_OBSTACLE
+  uint32_t kinds;
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+class Arena;
+
+/**
+ * @brief Draws top-down occupancy patches around robots, for controllers
+ * that look rather than read positions.
+ *
+ * A patch is size x size bytes, row by row, centered on the robot and
+ * turned with it: row 0 is furthest ahead and columns run from its left to
+ * its right. Each cell holds the KindBit()s of the entities covering its
+ * center, other than the robot itself, and kPatchWall if it is outside the
+ * arena.
+ *
+ * The entities are found through the arena's neighbor queries, and each
+ * circle is drawn as one run of cells per row, OR-ing its bit in with a
+ * loop the compiler vectorizes. A rasterizer keeps its scratch between
+ * calls, so give each thread its own.
+ */
+class PatchRasterizer {
+ public:
+  PatchRasterizer(void) : nearby_() {}
+
+  /**
+   * @param[out] out Room for params.size * params.size bytes.
+   */
+  void Render(const Arena& arena, entity_id robot,
+              const struct patch_params& params, uint8_t * out);
+
+  /**
+   * @brief Render() every robot of the arena, in the order of
+   * registry().of_kind(KIND_ROBOT); robot i's patch starts at
+   * out + i * params.size * params.size.
+   */
+  void RenderAll(const Arena& arena, const struct patch_params& params,
+                 uint8_t * out);
+
+ private:
+  std::vector<entity_id> nearby_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_OCCUPANCY_PATCH_H_
@@ -0,0 +1,342 @@
+/**
+ * @file orca.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/orca.h"
+#include <algorithm>
+#include <cmath>
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constant Definitions
+ ******************************************************************************/
+// Below this many agents per thread, threads cost more than they save
+static const size_t kAgentsPerThread = 256;
+static const double kEpsilon = 1e-9;
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+namespace {
+struct vec {
+  double x;
+  double y;
+};
+
+inline vec operator+(vec a, vec b) { return vec {a.x + b.x, a.y + b.y}; }
+inline vec operator-(vec a, vec b) { return vec {a.x - b.x, a.y - b.y}; }
+inline vec operator*(double s, vec a) { return vec {s * a.x, s * a.y}; }
+inline double Dot(vec a, vec b) { return a.x * b.x + a.y * b.y; }
+inline double Det(vec a, vec b) { return a.x * b.y - a.y * b.x; }
+inline double LengthSquared(vec a) { return Dot(a, a); }
+inline vec Normalized(vec a) {
+  double l = std::sqrt(LengthSquared(a));
+  return l > 0 ? vec {a.x / l, a.y / l} : a;
+}
+
+/**
+ * @brief The velocities allowed by one neighbor: those to the left of the
+ * line through point along direction.
+ */
+struct line {
+  vec point;
+  vec direction;
+};
+
+}  // namespace
+
+/**
+ * @brief What one thread needs while solving, kept across its agents and,
+ * by an OrcaSolver, across steps.
+ */
+struct orca_workspace {
+  orca_workspace(void) : neighbors(), distances(), lines(), projected() {}
+
+  std::vector<uint32_t> neighbors;
+  std::vector<double> distances;
+  std::vector<line> lines;
+  std::vector<line> projected;
+};
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+OrcaSolver::OrcaSolver(void) : pool_(), workspaces_() {}
+
+OrcaSolver::~OrcaSolver(void) {}
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief The half plane of velocities that avoid one circle for time_horizon
+ * steps (or, if already overlapping it, get out within a step), taking the
+ * given share of the avoiding.
+ */
+static line OrcaLine(vec rel_pos, vec rel_vel, double combined_radius,
+                     double time_horizon, vec velocity, double share) {
+  double dist2 = LengthSquared(rel_pos);
+  double r2 = combined_radius * combined_radius;
+  line l;
+  vec u;
+  if (dist2 > r2) {
+    // Vector from the cutoff circle's center to the relative velocity
+    vec w = rel_vel - (1.0 / time_horizon) * rel_pos;
+    double w2 = LengthSquared(w);
+    double dot = Dot(w, rel_pos);
+    if (dot < 0 && dot * dot > r2 * w2) {
+      // Nearest the cutoff circle
+      double w_length = std::sqrt(w2);
+      vec unit_w = (1.0 / w_length) * w;
+      l.direction = vec {unit_w.y, -unit_w.x};
+      u = (combined_radius / time_horizon - w_length) * unit_w;
+    } else {
+      // Nearest one of the legs of the cone
+      double leg = std::sqrt(dist2 - r2);
+      if (Det(rel_pos, w) > 0) {
+        l.direction = (1.0 / dist2) *
+            vec {rel_pos.x * leg - rel_pos.y * combined_radius,
+                 rel_pos.x * combined_radius + rel_pos.y * leg};
+      } else {
+        l.direction = (-1.0 / dist2) *
+            vec {rel_pos.x * leg + rel_pos.y * combined_radius,
+                 -rel_pos.x * combined_radius + rel_pos.y * leg};
+      }
+      u = Dot(rel_vel, l.direction) * l.direction - rel_vel;
+    }
+  } else {
+    // Already overlapping: get apart by the next step
+    vec w = rel_vel - rel_pos;
+    double w_length = std::sqrt(LengthSquared(w));
+    vec unit_w = w_length > 0 ? (1.0 / w_length) * w : vec {1, 0};
+    l.direction = vec {unit_w.y, -unit_w.x};
+    u = (combined_radius - w_length) * unit_w;
+  }
+  l.point = velocity + share * u;
+  return l;
+} /* OrcaLine() */
+
+/**
+ * @brief Best velocity on line i within the speed circle and left of lines
+ * [0, i): nearest opt, or furthest along opt if direction_opt.
+ */
+static bool LinearProgram1(const std::vector<line>& lines, size_t i,
+                           double radius, vec opt, bool direction_opt,
+                           vec * result) {
+  double dot = Dot(lines[i].point, lines[i].direction);
+  double discriminant = dot * dot + radius * radius -
+      LengthSquared(lines[i].point);
+  if (discriminant < 0) {
+    // The speed circle misses the line altogether
+    return false;
+  }
+  double root = std::sqrt(discriminant);
+  double t_left = -dot - root;
+  double t_right = -dot + root;
+  for (size_t j = 0; j < i; ++j) {
+    double denominator = Det(lines[i].direction, lines[j].direction);
+    double numerator = Det(lines[j].direction,
+                           lines[i].point - lines[j].point);
+    if (std::fabs(denominator) <= kEpsilon) {
+      // Parallel: line i is either all allowed by line j or all ruled out
+      if (numerator < 0) {
+        return false;
+      }
+      continue;
+    }
+    double t = numerator / denominator;
+    if (denominator >= 0) {
+      t_right = std::min(t_right, t);
+    } else {
+      t_left = std::max(t_left, t);
+    }
+    if (t_left > t_right) {
+      return false;
+    }
+  } /* for(j..) */
+
+  double t;
+  if (direction_opt) {
+    t = Dot(opt, lines[i].direction) > 0 ? t_right : t_left;
+  } else {
+    t = std::min(std::max(Dot(lines[i].direction, opt - lines[i].point),
+                          t_left), t_right);
+  }
+  *result = lines[i].point + t * lines[i].direction;
+  return true;
+} /* LinearProgram1() */
+
+/**
+ * @brief Best velocity within the speed circle and left of every line.
+ *
+ * @return lines.size() on success, else the line it failed on; result is
+ * then the best velocity for the lines before it.
+ */
+static size_t LinearProgram2(const std::vector<line>& lines, double radius,
+                             vec opt, bool direction_opt, vec * result) {
+  if (direction_opt) {
+    *result = radius * opt;
+  } else if (LengthSquared(opt) > radius * radius) {
+    *result = radius * Normalized(opt);
+  } else {
+    *result = opt;
+  }
+  for (size_t i = 0; i < lines.size(); ++i) {
+    if (Det(lines[i].direction, lines[i].point - *result) > 0) {
+      // The result so far is ruled out by line i; the new one is on it
+      vec before = *result;
+      if (!LinearProgram1(lines, i, radius, opt, direction_opt, result)) {
+        *result = before;
+        return i;
+      }
+    }
+  } /* for(i..) */
+  return lines.size();
+} /* LinearProgram2() */
+
+/**
+ * @brief When no velocity satisfies every line, the one that minimizes the
+ * greatest distance by which it breaks any of them, from line begin on.
+ */
+static void LinearProgram3(const std::vector<line>& lines, size_t begin,
+                           double radius, std::vector<line> * projected,
+                           vec * result) {
+  double distance = 0;
+  for (size_t i = begin; i < lines.size(); ++i) {
+    if (Det(lines[i].direction, lines[i].point - *result) <= distance) {
+      continue;
+    }
+    // Lines j < i, as seen from line i
+    projected->clear();
+    for (size_t j = 0; j < i; ++j) {
+      line l;
+      double determinant = Det(lines[i].direction, lines[j].direction);
+      if (std::fabs(determinant) <= kEpsilon) {
+        if (Dot(lines[i].direction, lines[j].direction) > 0) {
+          // Same direction: never the binding one
+          continue;
+        }
+        l.point = 0.5 * (lines[i].point + lines[j].point);
+      } else {
+        l.point = lines[i].point +
+            (Det(lines[j].direction, lines[i].point - lines[j].point) /
+             determinant) * lines[i].direction;
+      }
+      l.direction = Normalized(lines[j].direction - lines[i].direction);
+      projected->push_back(l);
+    } /* for(j..) */
+    vec before = *result;
+    if (LinearProgram2(*projected, radius,
+                       vec {-lines[i].direction.y, lines[i].direction.x},
+                       true, result) < projected->size()) {
+      // Can only fail by rounding; the result so far is as good
+      *result = before;
+    }
+    distance = Det(lines[i].direction, lines[i].point - *result);
+  } /* for(i..) */
+} /* LinearProgram3() */
+
+static void SolveAgent(const orca_params& params,
+                       const circle_batch& circles, const orca_bodies& bodies,
+                       const SpatialGrid& grid, const StaticMap * static_map,
+                       orca_workspace * ws, orca_agent * agent) {
+  uint32_t self = agent->body;
+  vec pos = {circles.x[self], circles.y[self]};
+  vec velocity = {bodies.vx[self], bodies.vy[self]};
+  double radius = circles.r[self] + agent->margin;
+  ws->lines.clear();
+
+  size_t n = grid.Nearest(pos.x, pos.y, params.neighbor_distance,
+                          params.max_neighbors, ws->neighbors.data(),
+                          ws->distances.data(), self);
+  for (size_t i = 0; i < n; ++i) {
+    uint32_t other = ws->neighbors[i];
+    vec rel_pos = {circles.x[other] - pos.x,
+                   circles.y[other] - pos.y};
+    vec rel_vel = velocity - vec {bodies.vx[other], bodies.vy[other]};
+    if (bodies.avoids[other]) {
+      ws->lines.push_back(OrcaLine(rel_pos, rel_vel,
+                                   radius + circles.r[other],
+                                   params.time_horizon, velocity, 0.5));
+    } else {
+      ws->lines.push_back(OrcaLine(rel_pos, rel_vel,
+                                   radius + circles.r[other],
+                                   params.obstacle_time_horizon, velocity,
+                                   1.0));
+    }
+  } /* for(i..) */
+
+  if (static_map) {
+    double reach = params.obstacle_time_horizon * agent->max_speed + radius;
+    static_map->ForEachInBox(pos.x - reach, pos.y - reach, pos.x + reach,
+                             pos.y + reach, [&](const static_obstacle& o) {
+        vec rel_pos = {o.x - pos.x, o.y - pos.y};
+        double gap = reach + o.radius;
+        if (LengthSquared(rel_pos) <= gap * gap) {
+          ws->lines.push_back(OrcaLine(rel_pos, velocity, radius + o.radius,
+                                       params.obstacle_time_horizon,
+                                       velocity, 1.0));
+        }
+      });
+  }
+
+  vec pref = {agent->pref_vx, agent->pref_vy};
+  vec result;
+  size_t failed = LinearProgram2(ws->lines, agent->max_speed, pref, false,
+                                 &result);
+  if (failed < ws->lines.size()) {
+    LinearProgram3(ws->lines, failed, agent->max_speed, &ws->projected,
+                   &result);
+  }
+  agent->vx = result.x;
+  agent->vy = result.y;
+} /* SolveAgent() */
+
+void SolveOrca(const orca_params& params, const circle_batch& circles,
+               const orca_bodies& bodies, const SpatialGrid& grid,
+               const StaticMap * static_map,
+               std::vector<orca_agent> * agents) {
+  OrcaSolver solver;
+  solver.Solve(params, circles, bodies, grid, static_map, agents);
+} /* SolveOrca() */
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void OrcaSolver::Solve(const orca_params& params, const circle_batch& circles,
+                       const orca_bodies& bodies, const SpatialGrid& grid,
+                       const StaticMap * static_map,
+                       std::vector<orca_agent> * agents) {
+  size_t n = agents->size();
+  if (params.parallel && !pool_ && n >= 2 * kAgentsPerThread) {
+    pool_.reset(new WorkerPool(0));
+  }
+  WorkerPool * pool = params.parallel ? pool_.get() : nullptr;
+  size_t n_threads = pool ? pool->n_threads() : 1;
+  while (workspaces_.size() < n_threads) {
+    workspaces_.emplace_back(new orca_workspace);
+  } /* while() */
+  for (size_t t = 0; t < n_threads; ++t) {
+    workspaces_[t]->neighbors.resize(params.max_neighbors);
+    workspaces_[t]->distances.resize(params.max_neighbors);
+  } /* for(t..) */
+
+  ForRanges(pool, n, kAgentsPerThread,
+            [&](size_t t, size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        SolveAgent(params, circles, bodies, grid, static_map,
+                   workspaces_[t].get(), &(*agents)[i]);
+      } /* for(i..) */
+    });
+} /* Solve() */
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,141 @@
+/**
+ * @file orca.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_ORCA_H_
+#define SRC_ORCA_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include <memory>
+#include <vector>
+#include "src/common.h"
+#include "src/ray_cast.h"
+#include "src/spatial_grid.h"
+#include "src/static_map.h"
+#include "src/worker_pool.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+struct orca_params {
+  orca_params(void) : time_horizon(10), obstacle_time_horizon(5),
+                      neighbor_distance(100), max_neighbors(10),
+                      parallel(true) {}
+
+  // Steps ahead within which to avoid other agents, which avoid in turn
+  double time_horizon;
+  // Steps ahead within which to avoid everything else
+  double obstacle_time_horizon;
+  // How far apart two centers may be and still be avoided
+  double neighbor_distance;
+  // How many of the nearest circles each agent avoids
+  size_t max_neighbors;
+  bool parallel;
+};
+
+/**
+ * @brief How the circles agents steer around are moving, and whether each
+ * steers around them in turn (is an agent itself). Indexed as the circles.
+ */
+struct orca_bodies {
+  orca_bodies(void) : vx(), vy(), avoids() {}
+
+  void Clear(void) { vx.clear(); vy.clear(); avoids.clear(); }
+  void Push(double cvx, double cvy, bool agent) {
+    vx.push_back(cvx);
+    vy.push_back(cvy);
+    avoids.push_back(agent);
+  }
+  size_t size(void) const { return vx.size(); }
+
+  std::vector<double> vx;
+  std::vector<double> vy;
+  std::vector<uint8_t> avoids;
+};
+
+/**
+ * @brief One agent: which circle it is, the velocity it would like, and (on
+ * return from SolveOrca()) the one it gets. margin is kept between it and
+ * what it avoids, on top of their radii.
+ */
+struct orca_agent {
+  uint32_t body;
+  double pref_vx;
+  double pref_vy;
+  double max_speed;
+  double margin;
+  double vx;
+  double vy;
+};
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief Choose each agent's velocity for the next step by optimal
+ * reciprocal collision avoidance (van den Berg et al. 2011).
+ *
+ * Each agent looks at its nearest circles through grid (built from
+ * circles) and at the static map obstacles within reach. Every one of
+ * them rules out a half plane of velocities that would collide with it
+ * within the time horizon; against another agent, which will do the same,
+ * the agent takes only half of the avoiding, and all of it otherwise. The
+ * velocity chosen is the one nearest the preferred velocity that is in every
+ * half plane and no faster than max_speed, found by a 2D linear program;
+ * where there is none, the one that intrudes least into the worst of them.
+ *
+ * Agents read only what is passed in, never each other's answers, so the
+ * result does not depend on the order they are solved in, and they are
+ * solved in parallel. Solving every step, keep an OrcaSolver instead, which
+ * keeps its threads and scratch from one solve to the next.
+ */
+void SolveOrca(const struct orca_params& params,
+               const struct circle_batch& circles,
+               const struct orca_bodies& bodies, const SpatialGrid& grid,
+               const StaticMap * static_map,
+               std::vector<struct orca_agent> * agents);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+struct orca_workspace;
+
+/**
+ * @brief SolveOrca() over and over. The threads are started the first time
+ * there are agents enough to split among them, and live as long as the
+ * solver; each keeps its scratch memory, so that once warmed up a solve
+ * allocates nothing.
+ */
+class OrcaSolver {
+ public:
+  OrcaSolver(void);
+  ~OrcaSolver(void);
+
+  void Solve(const struct orca_params& params,
+             const struct circle_batch& circles,
+             const struct orca_bodies& bodies, const SpatialGrid& grid,
+             const StaticMap * static_map,
+             std::vector<struct orca_agent> * agents);
+
+ private:
+  OrcaSolver& operator=(const OrcaSolver& other) = delete;
+  OrcaSolver(const OrcaSolver& other) = delete;
+
+  std::unique_ptr<WorkerPool> pool_;
+  // One per thread, each in an allocation of its own
+  std::vector<std::unique_ptr<orca_workspace>> workspaces_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif /* SRC_ORCA_H_ */
@@ -0,0 +1,205 @@
+/**
+ * @file perf_counters.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/perf_counters.h"
+
+#include <string.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+PerfCounterGroup::PerfCounterGroup(void) : fd_(), n_open_(0) {
+  for (int i = 0; i < PERF_N_COUNTERS; ++i) {
+    fd_[i] = -1;
+  } /* for(i..) */
+}
+
+PerfCounterGroup::~PerfCounterGroup(void) {
+  for (int i = 0; i < PERF_N_COUNTERS; ++i) {
+    if (fd_[i] >= 0) {
+      close(fd_[i]);
+    }
+  } /* for(i..) */
+}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+/**
+* @brief Open each counter as a member of one group, led by the first counter
+* that opens successfully. The group is created disabled and then enabled as
+* a unit so all members count over exactly the same interval.
+*/
+bool PerfCounterGroup::Open(void) {
+#ifdef __linux__
+  static const uint32_t kTypes[PERF_N_COUNTERS] = {
+    PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE,
+    PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE
+  };
+  static const uint64_t kConfigs[PERF_N_COUNTERS] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+    PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+    PERF_COUNT_HW_BRANCH_MISSES
+  };
+  int leader = -1;
+  for (int i = 0; i < PERF_N_COUNTERS; ++i) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = kTypes[i];
+    attr.config = kConfigs[i];
+    attr.disabled = (leader < 0);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    int fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1,
+                                      leader, 0));
+    if (fd < 0) {
+      continue;
+    }
+    fd_[i] = fd;
+    ++n_open_;
+    if (leader < 0) {
+      leader = fd;
+    }
+  } /* for(i..) */
+  if (leader < 0) {
+    return false;
+  }
+  ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  return true;
+#else
+  return false;
+#endif
+} /* Open() */
+
+/**
+* @brief Read the whole group with one syscall. With PERF_FORMAT_GROUP the
+* kernel returns the member count followed by one value per member, in the
+* order the members were opened, which is the order of perf_counter_kind.
+*/
+void PerfCounterGroup::Read(struct perf_sample * sample) {
+  *sample = perf_sample();
+  if (!n_open_) {
+    return;
+  }
+  int leader = -1;
+  for (int i = 0; i < PERF_N_COUNTERS && leader < 0; ++i) {
+    leader = fd_[i];
+  } /* for(i..) */
+  uint64_t buf[1 + PERF_N_COUNTERS];
+  ssize_t n = read(leader, buf, sizeof(buf));
+  if (n < static_cast<ssize_t>(sizeof(uint64_t))) {
+    return;
+  }
+  uint64_t slot = 0;
+  for (int i = 0; i < PERF_N_COUNTERS && slot < buf[0]; ++i) {
+    if (fd_[i] >= 0) {
+      sample->value[i] = buf[1 + slot++];
+    }
+  } /* for(i..) */
+} /* Read() */
+
+const char * PerfCounterGroup::name(enum perf_counter_kind kind) {
+  switch (kind) {
+    case PERF_CYCLES: return "cycles";
+    case PERF_INSTRUCTIONS: return "instructions";
+    case PERF_L1D_MISSES: return "L1d-misses";
+    case PERF_LLC_MISSES: return "LLC-misses";
+    case PERF_BRANCH_MISSES: return "branch-misses";
+    default: return "unknown";
+  } /* switch() */
+} /* name() */
+
+void PerfPhaseProfiler::BeginStep(void) {
+  counters_.Read(&mark_);
+  ++n_steps_;
+} /* BeginStep() */
+
+void PerfPhaseProfiler::EndPhase(enum sim_phase phase) {
+  struct perf_sample now;
+  counters_.Read(&now);
+  for (int i = 0; i < PERF_N_COUNTERS; ++i) {
+    uint64_t delta = now.value[i] - mark_.value[i];
+    last_step_[phase].value[i] = delta;
+    totals_[phase].value[i] += delta;
+  } /* for(i..) */
+  mark_ = now;
+} /* EndPhase() */
+
+const char * PerfPhaseProfiler::name(enum sim_phase phase) {
+  switch (phase) {
+    case PHASE_ENTITY_UPDATE: return "entity_update";
+    case PHASE_GAME_STATE: return "game_state";
+    case PHASE_SPECIAL_COLLISIONS: return "special_collisions";
+    case PHASE_MOBILE_COLLISIONS: return "mobile_collisions";
+    case PHASE_SENSING: return "sensing";
+    default: return "unknown";
+  } /* switch() */
+} /* name() */
+
+void PerfPhaseProfiler::PrintStep(FILE * fp) const {
+  for (int p = 0; p < PHASE_N_PHASES; ++p) {
+    fprintf(fp, "step %llu %-18s", static_cast<unsigned long long>(n_steps_),
+            name(static_cast<enum sim_phase>(p)));
+    for (int i = 0; i < PERF_N_COUNTERS; ++i) {
+      fprintf(fp, " %s=%llu", PerfCounterGroup::name(
+          static_cast<enum perf_counter_kind>(i)),
+              static_cast<unsigned long long>(last_step_[p].value[i]));
+    } /* for(i..) */
+    fprintf(fp, "\n");
+  } /* for(p..) */
+} /* PrintStep() */
+
+void PerfPhaseProfiler::PrintSummary(FILE * fp) const {
+  double steps = n_steps_ ? static_cast<double>(n_steps_) : 1.0;
+  fprintf(fp, "%-18s", "phase (per step)");
+  for (int i = 0; i < PERF_N_COUNTERS; ++i) {
+    enum perf_counter_kind kind = static_cast<enum perf_counter_kind>(i);
+    fprintf(fp, " %14s%s", PerfCounterGroup::name(kind),
+            counters_.supported(kind) ? "" : "*");
+  } /* for(i..) */
+  fprintf(fp, " %6s %8s %8s %8s\n", "IPC", "L1D/ki", "LLC/ki", "br/ki");
+  for (int p = 0; p < PHASE_N_PHASES; ++p) {
+    const struct perf_sample& t = totals_[p];
+    fprintf(fp, "%-18s", name(static_cast<enum sim_phase>(p)));
+    for (int i = 0; i < PERF_N_COUNTERS; ++i) {
+      fprintf(fp, " %14.1f", t.value[i] / steps);
+    } /* for(i..) */
+    double kilo = t.value[PERF_INSTRUCTIONS] / 1000.0;
+    fprintf(fp, " %6.2f", t.value[PERF_CYCLES] ?
+            static_cast<double>(t.value[PERF_INSTRUCTIONS]) /
+            t.value[PERF_CYCLES] : 0.0);
+    for (int i = PERF_L1D_MISSES; i <= PERF_BRANCH_MISSES; ++i) {
+      fprintf(fp, " %8.2f", kilo > 0 ? t.value[i] / kilo : 0.0);
+    } /* for(i..) */
+    fprintf(fp, "\n");
+  } /* for(p..) */
+  fprintf(fp, "%llu steps; /ki = misses per thousand instructions; "
+          "* = counter unavailable on this machine\n",
+          static_cast<unsigned long long>(n_steps_));
+} /* PrintSummary() */
+
+NAMESPACE_END(csci3081);
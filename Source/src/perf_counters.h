@@ -0,0 +1,159 @@
+/**
+ * @file perf_counters.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_PERF_COUNTERS_H_
+#define SRC_PERF_COUNTERS_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Type Definitions
+ ******************************************************************************/
+/**
+ * @brief The hardware events sampled by PerfCounterGroup.
+ */
+enum perf_counter_kind {
+  PERF_CYCLES,
+  PERF_INSTRUCTIONS,
+  PERF_L1D_MISSES,
+  PERF_LLC_MISSES,
+  PERF_BRANCH_MISSES,
+  PERF_N_COUNTERS
+};
+
+/**
+ * @brief The phases of Arena::UpdateEntitiesTimestep() that are profiled.
+ */
+enum sim_phase {
+  PHASE_ENTITY_UPDATE,
+  PHASE_GAME_STATE,
+  PHASE_SPECIAL_COLLISIONS,
+  PHASE_MOBILE_COLLISIONS,
+  PHASE_SENSING,
+  PHASE_N_PHASES
+};
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief One reading (or difference of readings) of every counter.
+ */
+struct perf_sample {
+  perf_sample(void) : value() {}
+  uint64_t value[PERF_N_COUNTERS];
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief A group of hardware counters for the calling thread, opened with
+ * perf_event_open(2) so that they are scheduled onto the PMU together.
+ *
+ * Counters the kernel or CPU refuses (no PMU in a VM, paranoid level too high,
+ * event unsupported) are marked unsupported and read back as zero, so callers
+ * never need to special-case machines without counters.
+ */
+class PerfCounterGroup {
+ public:
+  PerfCounterGroup(void);
+  ~PerfCounterGroup(void);
+
+  /**
+   * @brief Open and start the counters. Returns false if none are available.
+   */
+  bool Open(void);
+
+  /**
+   * @brief Whether at least one counter was opened.
+   */
+  bool available(void) const { return n_open_ > 0; }
+
+  /**
+   * @brief Whether a particular counter was opened.
+   */
+  bool supported(enum perf_counter_kind kind) const { return fd_[kind] >= 0; }
+
+  /**
+   * @brief Read the current value of every counter.
+   */
+  void Read(struct perf_sample * sample);
+
+  static const char * name(enum perf_counter_kind kind);
+
+ private:
+  PerfCounterGroup& operator=(const PerfCounterGroup& other) = delete;
+  PerfCounterGroup(const PerfCounterGroup& other) = delete;
+
+  int fd_[PERF_N_COUNTERS];
+  int n_open_;
+};
+
+/**
+ * @brief Attributes hardware counter deltas to the phases of a simulation
+ * step.
+ *
+ * Call BeginStep() at the top of a step and EndPhase() as each phase
+ * finishes; the counts since the previous mark are charged to that phase.
+ * Both the most recent step and the running totals are kept.
+ */
+class PerfPhaseProfiler {
+ public:
+  PerfPhaseProfiler(void) : counters_(), mark_(), last_step_(),
+                            totals_(), n_steps_(0) {}
+
+  bool Open(void) { return counters_.Open(); }
+  bool available(void) const { return counters_.available(); }
+
+  void BeginStep(void);
+  void EndPhase(enum sim_phase phase);
+
+  const struct perf_sample& last_step(enum sim_phase phase) const {
+    return last_step_[phase];
+  }
+  const struct perf_sample& totals(enum sim_phase phase) const {
+    return totals_[phase];
+  }
+  uint64_t n_steps(void) const { return n_steps_; }
+
+  /**
+   * @brief Print the counters of the most recent step, one line per phase.
+   */
+  void PrintStep(FILE * fp) const;
+
+  /**
+   * @brief Print per-phase per-step averages, IPC, and cache and branch
+   * misses per thousand instructions.
+   */
+  void PrintSummary(FILE * fp) const;
+
+  static const char * name(enum sim_phase phase);
+
+ private:
+  PerfPhaseProfiler& operator=(const PerfPhaseProfiler& other) = delete;
+  PerfPhaseProfiler(const PerfPhaseProfiler& other) = delete;
+
+  PerfCounterGroup counters_;
+  struct perf_sample mark_;
+  struct perf_sample last_step_[PHASE_N_PHASES];
+  struct perf_sample totals_[PHASE_N_PHASES];
+  uint64_t n_steps_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif /* SRC_PERF_COUNTERS_H_ */
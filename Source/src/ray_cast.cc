@@ -0,0 +1,91 @@
+/**
+ * @file ray_cast.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/ray_cast.h"
+#include <algorithm>
+#include <cmath>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief Shorten t[i] to where ray i meets the circle at (px, py) relative
+ * to the origin, for rays [begin, end). c2 is |p|^2 - r^2.
+ */
+static inline void CastRaysAtCircle(double px, double py, double c2,
+                                    const double * dx, const double * dy,
+                                    size_t begin, size_t end, double * t) {
+  for (size_t i = begin; i < end; ++i) {
+    double b = dx[i] * px + dy[i] * py;
+    double disc = b * b - c2;
+    double hit = b - std::sqrt(std::max(disc, 0.0));
+    // b > 0: the circle is ahead; disc >= 0: the ray does not pass it by
+    t[i] = (disc >= 0 && b > 0 && hit < t[i]) ? hit : t[i];
+  } /* for(i..) */
+} /* CastRaysAtCircle() */
+
+void CastRaysAtCircles(double ox, double oy, const double * dx,
+                       const double * dy, size_t n_rays,
+                       const struct circle_batch& circles, double * t) {
+  for (size_t c = 0; c < circles.size(); ++c) {
+    double px = circles.x[c] - ox;
+    double py = circles.y[c] - oy;
+    // |origin + s*d - p|^2 = r^2 is s^2 - 2bs + c2 = 0, with b = d.p
+    double c2 = px * px + py * py - circles.r[c] * circles.r[c];
+    if (c2 <= 0) {
+      std::fill(t, t + n_rays, 0.0);
+      return;
+    }
+    size_t i = 0;
+#ifdef __SSE2__
+    // Written out rather than left to the compiler, which keeps std::sqrt
+    // scalar for errno's sake and is not asked to optimize in any case.
+    // Each step is the loop below's, so the readings are identical.
+    const __m128d vpx = _mm_set1_pd(px);
+    const __m128d vpy = _mm_set1_pd(py);
+    const __m128d vc2 = _mm_set1_pd(c2);
+    const __m128d zero = _mm_setzero_pd();
+    for (; i + 2 <= n_rays; i += 2) {
+      __m128d b = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(dx + i), vpx),
+                             _mm_mul_pd(_mm_loadu_pd(dy + i), vpy));
+      __m128d disc = _mm_sub_pd(_mm_mul_pd(b, b), vc2);
+      __m128d hit = _mm_sub_pd(b, _mm_sqrt_pd(_mm_max_pd(disc, zero)));
+      __m128d old = _mm_loadu_pd(t + i);
+      __m128d take = _mm_and_pd(_mm_and_pd(_mm_cmpge_pd(disc, zero),
+                                           _mm_cmpgt_pd(b, zero)),
+                                _mm_cmplt_pd(hit, old));
+      _mm_storeu_pd(t + i, _mm_or_pd(_mm_and_pd(take, hit),
+                                     _mm_andnot_pd(take, old)));
+    } /* for(i..) */
+#endif
+    CastRaysAtCircle(px, py, c2, dx, dy, i, n_rays, t);
+  } /* for(c..) */
+} /* CastRaysAtCircles() */
+
+void CastRaysAtBox(double ox, double oy, const double * dx, const double * dy,
+                   size_t n_rays, double x_dim, double y_dim, double * t) {
+  for (size_t i = 0; i < n_rays; ++i) {
+    // A zero component never reaches those walls; the division gives inf
+    double tx = (dx[i] > 0 ? x_dim - ox : -ox) / dx[i];
+    double ty = (dy[i] > 0 ? y_dim - oy : -oy) / dy[i];
+    tx = dx[i] != 0 ? std::max(tx, 0.0) : t[i];
+    ty = dy[i] != 0 ? std::max(ty, 0.0) : t[i];
+    t[i] = std::min(t[i], std::min(tx, ty));
+  } /* for(i..) */
+} /* CastRaysAtBox() */
+
+NAMESPACE_END(csci3081);
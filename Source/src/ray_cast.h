@@ -0,0 +1,70 @@
+/**
+ * @file ray_cast.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_RAY_CAST_H_
+#define SRC_RAY_CAST_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stddef.h>
+#include <vector>
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief Circles to cast against, one array per coordinate. Clear() keeps the
+ * arrays' memory, so a batch that is refilled every step stops allocating.
+ */
+struct circle_batch {
+  circle_batch(void) : x(), y(), r() {}
+
+  void Clear(void) { x.clear(); y.clear(); r.clear(); }
+  void Push(double cx, double cy, double cr) {
+    x.push_back(cx);
+    y.push_back(cy);
+    r.push_back(cr);
+  }
+  size_t size(void) const { return x.size(); }
+
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<double> r;
+};
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief Cast a fan of rays from one origin against a batch of circles.
+ *
+ * Ray i runs from (ox, oy) along the unit vector (dx[i], dy[i]). On entry
+ * t[i] is how far it may go (its range); on return it is shortened to the
+ * first circle it meets, or 0 if the origin is inside one. Where the target
+ * has SSE2 (every x86-64), rays are cast two at a time; the readings are
+ * the same, bit for bit, as the one at a time loop elsewhere.
+ */
+void CastRaysAtCircles(double ox, double oy, const double * dx,
+                       const double * dy, size_t n_rays,
+                       const struct circle_batch& circles, double * t);
+
+/**
+ * @brief As CastRaysAtCircles(), against the inside walls of the box
+ * [0, x_dim] x [0, y_dim].
+ */
+void CastRaysAtBox(double ox, double oy, const double * dx, const double * dy,
+                   size_t n_rays, double x_dim, double y_dim, double * t);
+
+NAMESPACE_END(csci3081);
+
+#endif /* SRC_RAY_CAST_H_ */
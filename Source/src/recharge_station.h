@@ -29,12 +29,11 @@ NAMESPACE_BEGIN(csci3081);
  */
 class RechargeStation: public Obstacle {
  public:
-  RechargeStation(double radius, const Position& pos,
+  RechargeStation(Registry * registry, real_t radius, const Position& pos,
                   const Color& color) :
-      Obstacle(radius, pos, color) {}
-  std::string name(void) const {
-    return "Recharge Station";
-  }
+      Obstacle(registry, KIND_RECHARGE_STATION, radius, pos, color) {}
+  RechargeStation(Registry * registry, entity_id id) :
+      Obstacle(registry, id) {}
 };
 
 NAMESPACE_END(csci3081);
@@ -0,0 +1,88 @@
+/**
+ * @file registry.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/registry.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+Registry::Registry(size_t expected) :
+  slots_(), free_(), members_(), transforms_(), kinematics_(), batteries_(),
+  touch_sensors_(), renderables_(), wanderers_(), lidars_(),
+  autopilots_(), avoiders_() {
+  slots_.reserve(expected);
+  transforms_.Reserve(expected);
+  renderables_.Reserve(expected);
+  members_[KIND_OBSTACLE].reserve(expected);
+}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+entity_id Registry::Create(enum entity_kind kind) {
+  entity_id e;
+  if (!free_.empty()) {
+    e = free_.back();
+    free_.pop_back();
+  } else {
+    e = static_cast<entity_id>(slots_.size());
+    slots_.push_back(slot {kind, 0, 0, false});
+  }
+  slot& s = slots_[e];
+  s.kind = kind;
+  s.member = static_cast<uint32_t>(members_[kind].size());
+  s.alive = true;
+  members_[kind].push_back(e);
+  return e;
+} /* Create() */
+
+bool Registry::Destroy(entity_id e) {
+  if (!alive(e)) {
+    return false;
+  }
+  transforms_.Remove(e);
+  kinematics_.Remove(e);
+  batteries_.Remove(e);
+  touch_sensors_.Remove(e);
+  renderables_.Remove(e);
+  wanderers_.Remove(e);
+  lidars_.Remove(e);
+  autopilots_.Remove(e);
+  avoiders_.Remove(e);
+
+  // Swap the last entity of the same kind into this one's place
+  slot& s = slots_[e];
+  std::vector<entity_id>& members = members_[s.kind];
+  entity_id last = members.back();
+  members[s.member] = last;
+  slots_[last].member = s.member;
+  members.pop_back();
+
+  s.alive = false;
+  ++s.generation;
+  free_.push_back(e);
+  return true;
+} /* Destroy() */
+
+const char * Registry::kind_name(enum entity_kind kind) {
+  switch (kind) {
+    case KIND_ROBOT: return "Robot";
+    case KIND_HOME_BASE: return "Home Base";
+    case KIND_RECHARGE_STATION: return "Recharge Station";
+    case KIND_OBSTACLE: return "Obstacle";
+    default: return "unknown";
+  } /* switch() */
+} /* kind_name() */
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,270 @@
+/**
+ * @file registry.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_REGISTRY_H_
+#define SRC_REGISTRY_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include <assert.h>
+#include <vector>
+#include "src/common.h"
+#include "src/components.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Type Definitions
+ ******************************************************************************/
+typedef uint32_t entity_id;
+
+// No entity, e.g. for a query that has none to leave out
+static const entity_id kNoEntity = UINT32_MAX;
+
+/**
+ * @brief A reference to an entity that can outlive it.
+ *
+ * index is the entity_id. Ids are recycled once an entity is destroyed, and
+ * every recycling bumps the slot's generation, so a handle kept from before
+ * is recognized as stale by Registry::Valid() instead of quietly naming
+ * whatever was spawned into the slot next.
+ */
+struct entity_handle {
+  entity_id index;
+  uint32_t generation;
+};
+
+inline bool operator==(const entity_handle& a, const entity_handle& b) {
+  return a.index == b.index && a.generation == b.generation;
+}
+inline bool operator!=(const entity_handle& a, const entity_handle& b) {
+  return !(a == b);
+}
+
+enum entity_kind {
+  KIND_ROBOT,
+  KIND_HOME_BASE,
+  KIND_RECHARGE_STATION,
+  KIND_OBSTACLE,
+  KIND_N_KINDS
+};
+
+/**
+ * @brief Sets of kinds, as bit masks, for filtering queries.
+ */
+inline uint32_t KindBit(enum entity_kind kind) { return 1u << kind; }
+static const uint32_t kAllKinds = (1u << KIND_N_KINDS) - 1;
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Dense storage for one component type.
+ *
+ * Components are packed in a vector, in the order they were added, next to
+ * the id of the entity that owns each one; a sparse index maps an entity id
+ * back to its slot. Systems iterate data()/owners() directly, and removal
+ * moves the last component into the hole, so the array never has gaps.
+ */
+template <typename T>
+class ComponentPool {
+ public:
+  static const uint32_t kAbsent = UINT32_MAX;
+
+  ComponentPool(void) : dense_(), owners_(), sparse_() {}
+
+  bool Has(entity_id e) const {
+    return e < sparse_.size() && sparse_[e] != kAbsent;
+  }
+  T& Get(entity_id e) { assert(Has(e)); return dense_[sparse_[e]]; }
+  const T& Get(entity_id e) const {
+    assert(Has(e));
+    return dense_[sparse_[e]];
+  }
+  T * Find(entity_id e) { return Has(e) ? &dense_[sparse_[e]] : nullptr; }
+  // Where e's component is in data()
+  uint32_t IndexOf(entity_id e) const { assert(Has(e)); return sparse_[e]; }
+  const T * Find(entity_id e) const {
+    return Has(e) ? &dense_[sparse_[e]] : nullptr;
+  }
+
+  T& Add(entity_id e, const T& value) {
+    assert(!Has(e));
+    if (e >= sparse_.size()) {
+      sparse_.resize(e + 1, kAbsent);
+    }
+    sparse_[e] = static_cast<uint32_t>(dense_.size());
+    dense_.push_back(value);
+    owners_.push_back(e);
+    return dense_.back();
+  }
+
+  void Remove(entity_id e) {
+    if (!Has(e)) {
+      return;
+    }
+    uint32_t slot = sparse_[e];
+    entity_id last = owners_.back();
+    dense_[slot] = dense_.back();
+    owners_[slot] = last;
+    sparse_[last] = slot;
+    sparse_[e] = kAbsent;
+    dense_.pop_back();
+    owners_.pop_back();
+  }
+
+  void Reserve(size_t n) {
+    dense_.reserve(n);
+    owners_.reserve(n);
+    sparse_.reserve(n);
+  }
+
+  void Clear(void) {
+    dense_.clear();
+    owners_.clear();
+    sparse_.clear();
+  }
+
+  size_t size(void) const { return dense_.size(); }
+  T * data(void) { return dense_.data(); }
+  const T * data(void) const { return dense_.data(); }
+  const entity_id * owners(void) const { return owners_.data(); }
+
+ private:
+  std::vector<T> dense_;
+  std::vector<entity_id> owners_;
+  std::vector<uint32_t> sparse_;
+};
+
+template <typename T>
+const uint32_t ComponentPool<T>::kAbsent;
+
+/**
+ * @brief The entities of an Arena and their components.
+ *
+ * An entity is only an id. What it is made of is decided by which pools hold
+ * a component for it, and systems select entities by iterating the smallest
+ * pool they need. Every entity also has a kind, and the registry keeps a list
+ * of the entities of each kind, so a query such as "all obstacles" returns a
+ * reference to that list: no casts, no allocation, O(matches) to walk.
+ *
+ * Ids index a slot map. Destroy() puts the slot on a free list that Create()
+ * takes from first, and every container involved only ever shrinks by
+ * swap-and-pop, so once the arena has reached its largest population
+ * spawning and despawning are O(1) and allocate nothing.
+ */
+class Registry {
+ public:
+  /**
+   * @param[in] expected How many entities to make room for up front, so that
+   * populating the arena does not regrow the pools.
+   */
+  explicit Registry(size_t expected = 0);
+
+  /**
+   * @brief Create an entity of the given kind, with no components yet.
+   */
+  entity_id Create(enum entity_kind kind);
+
+  /**
+   * @brief Remove an entity and all its components. Its id may be reused by
+   * the next Create(); handles to it become stale.
+   *
+   * @return false if the entity was already destroyed.
+   */
+  bool Destroy(entity_id e);
+
+  /**
+   * @brief A handle to a live entity, for holding on to across steps.
+   */
+  entity_handle handle(entity_id e) const {
+    assert(alive(e));
+    return entity_handle {e, slots_[e].generation};
+  }
+
+  /**
+   * @brief Whether the handle still names the entity it was made for.
+   */
+  bool Valid(const entity_handle& h) const {
+    return h.index < slots_.size() && slots_[h.index].alive &&
+        slots_[h.index].generation == h.generation;
+  }
+
+  bool alive(entity_id e) const {
+    return e < slots_.size() && slots_[e].alive;
+  }
+  enum entity_kind kind(entity_id e) const { return slots_[e].kind; }
+  const std::vector<entity_id>& of_kind(enum entity_kind kind) const {
+    return members_[kind];
+  }
+  size_t n_entities(void) const { return slots_.size() - free_.size(); }
+
+  /**
+   * @brief Printable kind, e.g. "Obstacle".
+   */
+  static const char * kind_name(enum entity_kind kind);
+
+  ComponentPool<transform>& transform_pool(void) { return transforms_; }
+  ComponentPool<kinematics>& kinematics_pool(void) { return kinematics_; }
+  ComponentPool<battery>& battery_pool(void) { return batteries_; }
+  ComponentPool<touch_sensor>& touch_sensor_pool(void) {
+    return touch_sensors_;
+  }
+  ComponentPool<renderable>& renderable_pool(void) { return renderables_; }
+  ComponentPool<wander>& wander_pool(void) { return wanderers_; }
+  ComponentPool<lidar>& lidar_pool(void) { return lidars_; }
+  ComponentPool<autopilot>& autopilot_pool(void) { return autopilots_; }
+  ComponentPool<avoidance>& avoidance_pool(void) { return avoiders_; }
+  const ComponentPool<transform>& transform_pool(void) const {
+    return transforms_;
+  }
+  const ComponentPool<kinematics>& kinematics_pool(void) const {
+    return kinematics_;
+  }
+  const ComponentPool<battery>& battery_pool(void) const {
+    return batteries_;
+  }
+  const ComponentPool<touch_sensor>& touch_sensor_pool(void) const {
+    return touch_sensors_;
+  }
+  const ComponentPool<renderable>& renderable_pool(void) const {
+    return renderables_;
+  }
+  const ComponentPool<lidar>& lidar_pool(void) const { return lidars_; }
+  const ComponentPool<avoidance>& avoidance_pool(void) const {
+    return avoiders_;
+  }
+
+ private:
+  struct slot {
+    enum entity_kind kind;
+    uint32_t generation;
+    uint32_t member;  // position in members_[kind]
+    bool alive;
+  };
+
+  std::vector<slot> slots_;
+  std::vector<entity_id> free_;
+  std::vector<entity_id> members_[KIND_N_KINDS];
+  ComponentPool<transform> transforms_;
+  ComponentPool<kinematics> kinematics_;
+  ComponentPool<battery> batteries_;
+  ComponentPool<touch_sensor> touch_sensors_;
+  ComponentPool<renderable> renderables_;
+  ComponentPool<wander> wanderers_;
+  ComponentPool<lidar> lidars_;
+  ComponentPool<autopilot> autopilots_;
+  ComponentPool<avoidance> avoiders_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif /* SRC_REGISTRY_H_ */
@@ -8,58 +8,27 @@
  * Includes
  ******************************************************************************/
 #include "src/robot.h"
-#include "src/robot_motion_behavior.h"
 
 /*******************************************************************************
  * Namespaces
  ******************************************************************************/
 NAMESPACE_BEGIN(csci3081);
 
-/*******************************************************************************
- * Static Variables
- ******************************************************************************/
-uint Robot::next_id_ = 0;
-
 /*******************************************************************************
  * Constructors/Destructor
  ******************************************************************************/
-Robot::Robot(const struct robot_params* const params) :
-  ArenaMobileEntity(params->radius, params->collision_delta,
-    params->pos, params->color),
-  battery_(params->battery_max_charge),
-  heading_angle_(0),
-  angle_delta_(params->angle_delta),
-  motion_handler_(),
-  motion_behavior_(),
-  sensor_touch_(),
-  id_(-1) {
-  motion_handler_.heading_angle(270);
-  motion_handler_.speed(5);
-  id_ = next_id_++;
+Robot::Robot(Registry * registry, const struct robot_params* const params) :
+  ArenaMobileEntity(registry, SpawnMobile(registry, KIND_ROBOT,
+    params->radius, params->collision_delta, params->pos, params->color)) {
+  registry_->battery_pool().Add(id_, battery {
+      RobotBattery(params->battery_max_charge), false});
+  motion().heading_angle(270);
+  motion().speed(5);
 }
 
 /*******************************************************************************
  * Member Functions
  ******************************************************************************/
- /**
- * @brief Updates the position, heading angle, speed, and
- * depletes the battery as a function of time (dt).
- * @param[in] dt Change in time used to update position, and
- * deplete the battery
- */
-void Robot::TimestepUpdate(uint dt) {
-  Position old_pos = get_pos();
-  // Update heading and speed as indicated by touch sensor
-  motion_handler_.UpdateVelocity(sensor_touch_);
-  // Use velocity and position to update position
-  motion_behavior_.UpdatePosition(this, dt);
-  // Deplete battery as appropriate given distance and speed of movement
-  battery_.Deplete(old_pos, get_pos(), dt);
-  // Reset the status of hit_recharge_station_ so that the
-  // robot loses battery when it hits obstacles
-  hit_recharge_station_ = false;
-} /* TimestepUpdate() */
-
 /**
 * @brief Charges the battery to full
 *
@@ -67,8 +36,8 @@ void Robot::TimestepUpdate(uint dt) {
 *
 * @param e A pointer to an EventRecharge object
 */
-void Robot::Accept(EventRecharge * e) {
-  battery_.EventRecharge();
+void Robot::Accept(__unused const EventRecharge * e) {
+  cell().EventRecharge();
 }
 
 // Pass along a collision event (from arena) to the touch sensor.
@@ -81,19 +50,19 @@ void Robot::Accept(EventRecharge * e) {
 *
 * @param e Pointer to an EventCollision object
 */
-void Robot::Accept(EventCollision * e) {
-  sensor_touch_.Accept(e);
+void Robot::Accept(const EventCollision * e) {
+  sensor_touch().Accept(e);
   if (e->collided()) {
     /* If the robot has collided with a recharge station
      * Don't reduce the battery level, since it should recharge.
      */
     if (hit_recharge_station() == false && e->collided_with_wall() == false) {
-      battery_.Accept(e);
+      cell().Accept(e);
     }
   // Bug: When speed == 1, the robot stops moving
   // To address this, I prevent speed_ from going below 2.
-    if (motion_handler_.speed() > 2 && e->collided_with_wall() == false) {
-        motion_handler_.speed(motion_handler_.speed() - 1);
+    if (motion().speed() > 2 && e->collided_with_wall() == false) {
+        motion().speed(motion().speed() - 1);
     }
   }
 }
@@ -103,24 +72,23 @@ void Robot::Accept(EventCollision * e) {
 * @param cmd An event_commands enum
 */
 void Robot::EventCmd(enum event_commands cmd) {
-  motion_handler_.AcceptCommand(cmd);
+  motion().AcceptCommand(cmd);
 } /* event_cmd() */
 /**
 * @brief Resets the battery, motion_handler, and sensor_touch to
 * their newly constructed states.
 */
 void Robot::Reset(void) {
-  battery_.Reset();
-  motion_handler_.Reset();
-  sensor_touch_.Reset();
-  next_id_ = 0;
+  cell().Reset();
+  motion().Reset();
+  sensor_touch().Reset();
 } /* Reset() */
 /**
 * @brief Resets the battery to its newly constructed state.
 *
 */
 void Robot::ResetBattery(void) {
-  battery_.Reset();
+  cell().Reset();
 }
 
 NAMESPACE_END(csci3081);
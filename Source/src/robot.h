@@ -12,9 +12,9 @@
  ******************************************************************************/
 #include <string>
 #include "src/robot_motion_handler.h"
-#include "src/robot_motion_behavior.h"
 #include "src/sensor_touch.h"
 #include "src/robot_battery.h"
+#include "src/robot_params.h"
 #include "src/arena_mobile_entity.h"
 #include "src/event_recharge.h"
 #include "src/event_collision.h"
@@ -36,54 +36,45 @@ NAMESPACE_BEGIN(csci3081);
  */
 class Robot : public ArenaMobileEntity {
  public:
-  explicit Robot(const struct robot_params* const params);
+  /**
+  * @brief Add a new robot, with a battery, to the registry.
+  */
+  Robot(Registry * registry, const struct robot_params* const params);
+
+  /**
+  * @brief View an existing robot.
+  */
+  Robot(Registry * registry, entity_id id) : ArenaMobileEntity(registry, id) {}
 
   void ResetBattery(void);
   void Reset(void);
-  void HeadingAngleInc(void) { heading_angle_ += angle_delta_; }
-  void HeadingAngleDec(void) { heading_angle_ -= angle_delta_; }
-  void TimestepUpdate(unsigned int dt);
-  void Accept(EventRecharge * e);
-  void Accept(EventCollision * e);
+  void Accept(const EventRecharge * e);
+  void Accept(const EventCollision * e);
   void EventCmd(enum event_commands cmd);
 
-  double get_battery_level(void) const { return battery_.level(); }
-  double get_heading_angle(void) const { return motion_handler_.heading_angle(); }
-  void set_heading_angle(double ha) { motion_handler_.heading_angle(ha); }
-  double get_speed(void) { return motion_handler_.speed(); }
-  void set_speed(double sp) { motion_handler_.speed(sp); }
-  int get_id(void) const { return id_; }
-  std::string name(void) const {
-    return "Robot" + std::to_string(id());
+  real_t get_battery_level(void) const {
+    return registry_->battery_pool().Get(id_).cell.level();
   }
+  entity_id get_id(void) const { return id_; }
   /**
-  * @brief Returns hit_recharge_station_, a boolean object used to
-  * prevent the robot from reducing it's battery every time it collides
-  * with the recharge station.
+  * @brief Returns whether the robot is touching the recharge station this
+  * step, which prevents it from reducing its battery every time it
+  * collides with the recharge station.
   */
-  bool hit_recharge_station() {
-    return hit_recharge_station_;
+  bool hit_recharge_station() const {
+    return registry_->battery_pool().Get(id_).on_charger;
   }
   /**
-  * @brief Setter used to update the value of hit_recharge_station_.
+  * @brief Setter used to update the value of hit_recharge_station().
   *
-  * @param hit A bool object that hit_recharge_station_ is set to
+  * @param hit A bool object that hit_recharge_station() is set to
   */
   void hit_recharge_station(bool hit) {
-    hit_recharge_station_ = hit;
+    registry_->battery_pool().Get(id_).on_charger = hit;
   }
 
  private:
-  static unsigned int next_id_;
-
-  int id_;
-  double heading_angle_;
-  double angle_delta_;
-  RobotBattery battery_;
-  RobotMotionHandler motion_handler_;
-  RobotMotionBehavior motion_behavior_;
-  SensorTouch sensor_touch_;
-  bool hit_recharge_station_ = false;
+  RobotBattery& cell(void) { return registry_->battery_pool().Get(id_).cell; }
 };
 
 NAMESPACE_END(csci3081);
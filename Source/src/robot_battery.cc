@@ -8,8 +8,6 @@
  * Includes
  ******************************************************************************/
 #include "src/robot_battery.h"
-#include <math.h>
-#include <cmath>
 /*******************************************************************************
  * Namespaces
  ******************************************************************************/
@@ -26,22 +24,19 @@ NAMESPACE_BEGIN(csci3081);
 * @param[in] dt Double representing time; used to
 * calculate how much charge is depleted
 */
-double RobotBattery::Deplete(__unused Position old_pos,
-  __unused Position new_pos, __unused double dt) {
-  double old_pos_x = old_pos.x;
-  double old_pos_y = old_pos.y;
-  double new_pos_x = new_pos.x;
-  double new_pos_y = new_pos.y;
-  double dist = std::sqrt(std::pow(new_pos_x - old_pos_x, 2) +
-                          std::pow(new_pos_y - old_pos_y, 2));
+real_t RobotBattery::Deplete(__unused Position old_pos,
+  __unused Position new_pos, __unused real_t dt) {
+  real_t dx = new_pos.x - old_pos.x;
+  real_t dy = new_pos.y - old_pos.y;
+  real_t dist = RealSqrt(dx * dx + dy * dy);
   charge_ = charge_ - dist * kLINEAR_SCALE_FACTOR * dt * 5;
   if (charge_ < 0) {
-    charge_ = 0.0;
+    charge_ = 0;
   }
   return charge_;
 } /* deplete() */
 
-void RobotBattery::Accept(__unused EventCollision * e) {
+void RobotBattery::Accept(__unused const EventCollision * e) {
   /**
   * @brief deplete battery by some value -- arbitrary selected for bumping
   */
@@ -30,31 +30,32 @@ NAMESPACE_BEGIN(csci3081);
  */
 class RobotBattery {
  public:
-  explicit RobotBattery(double max_charge) : charge_(max_charge),
+  explicit RobotBattery(real_t max_charge) : charge_(max_charge),
                                              max_charge_(max_charge) {}
 
   /**
    * @brief All robots consume SOME power, even when just sitting there not moving.
    */
-  double kBASE_DEPLETION = 0.1;
+  real_t kBASE_DEPLETION = 0.1;
 
   /**
    * @brief The amount of energy consumed by the robot due to its linear speed
    * its is directly proportional to that speed, with a scaling factor.
    */
-  double kLINEAR_SCALE_FACTOR = 0.01;
+  real_t kLINEAR_SCALE_FACTOR = 0.01;
 
   /**
    * @brief The amount of energy consumed by the robot due to its angular speed
    * its is directly proportional to that speed, with a scaling factor.
    */
-  double kANGULAR_SCALE_FACTOR = 0.01;
+  real_t kANGULAR_SCALE_FACTOR = 0.01;
 
   /**
    * @brief Get the current battery level.
    */
 
-  double level(void) const { return charge_; }
+  const real_t& level(void) const { return charge_; }
+  real_t max_charge(void) const { return max_charge_; }
 
   /**
    * @brief Handle a recharge event by instantly restoring the robot's battery
@@ -73,18 +74,18 @@ class RobotBattery {
    *
    * @return The updated battery level.
    */
-  double Deplete(__unused Position old_pos,
-    __unused Position new_pos, __unused double dt);
+  real_t Deplete(__unused Position old_pos,
+    __unused Position new_pos, __unused real_t dt);
 
   /**
   * @brief This is how the battery can be informed a collision occured.
   * Deplete accordingly.
   */
-  void Accept(EventCollision * e);
+  void Accept(const EventCollision * e);
 
  private:
-  double charge_;
-  double max_charge_;
+  real_t charge_;
+  real_t max_charge_;
 };
 
 NAMESPACE_END(csci3081);
@@ -19,19 +19,50 @@ NAMESPACE_BEGIN(csci3081);
  * Member Functions
  ******************************************************************************/
 void RobotMotionBehavior::UpdatePosition(ArenaMobileEntity * const ent,
-                                       unsigned int dt) {
+                                       unsigned int dt,
+                                       BumpAllocator * scratch) {
   // Save position for debugging purposes
   Position new_pos = ent->get_pos();
   Position old_pos = ent->get_pos();
 
-  // Movement is always along the heading_angle (i.e. the hypotenuse)
-  new_pos.x += cos(ent->heading_angle()*M_PI/180.0)*ent->speed()*dt;
-  new_pos.y += sin(ent->heading_angle()*M_PI/180.0)*ent->speed()*dt;
+  // Movement is always along the heading (i.e. the hypotenuse), which is
+  // already a unit vector, so no trigonometry is needed here.
+  const Vector2& dir = ent->get_direction();
+  real_t dist = ent->get_speed() * dt;
+  new_pos.x += dir.x * dist;
+  new_pos.y += dir.y * dist;
   ent->set_pos(new_pos);
 
-  printf(
-      "Updated %s kinematics: old_pos=(%d, %d), new_pos=(%d, %d)\n",
-      ent->name().c_str(), old_pos.x, old_pos.y, new_pos.x, new_pos.y);
+  if (scratch) {
+    Log(ent->name(scratch), old_pos, new_pos);
+  } else {
+    Log(ent->name().c_str(), old_pos, new_pos);
+  }
 } /* update_position() */
 
+void RobotMotionBehavior::UpdatePosition(ArenaMobileEntity * const ent,
+                                         const Vector2& velocity,
+                                         unsigned int dt,
+                                         BumpAllocator * scratch) {
+  Position old_pos = ent->get_pos();
+  Position new_pos = old_pos;
+  new_pos.x += velocity.x * dt;
+  new_pos.y += velocity.y * dt;
+  ent->set_pos(new_pos);
+
+  if (scratch) {
+    Log(ent->name(scratch), old_pos, new_pos);
+  } else {
+    Log(ent->name().c_str(), old_pos, new_pos);
+  }
+} /* update_position() */
+
+void RobotMotionBehavior::Log(const char * name, const Position& old_pos,
+                              const Position& new_pos) {
+  printf(
+      "Updated %s kinematics: old_pos=(%f, %f), new_pos=(%f, %f)\n",
+      name, RealToDouble(old_pos.x), RealToDouble(old_pos.y),
+      RealToDouble(new_pos.x), RealToDouble(new_pos.y));
+} /* Log() */
+
 NAMESPACE_END(csci3081);
@@ -12,6 +12,8 @@
  ******************************************************************************/
 #include <Eigen/Dense>
 #include "src/common.h"
+#include "src/bump_allocator.h"
+#include "src/vector2.h"
 
 /*******************************************************************************
  * Namespaces
@@ -41,8 +43,22 @@ class RobotMotionBehavior {
    *
    * @param[in] ent The entitity to update.
    * @param[in] dt Change in time
+   * @param[in] scratch Memory for the log line, if the caller has some.
    */
-  void UpdatePosition(class ArenaMobileEntity * const ent, uint dt);
+  void UpdatePosition(class ArenaMobileEntity * const ent, uint dt,
+                      BumpAllocator * scratch = nullptr);
+
+  /**
+   * @brief As above, but by the given velocity rather than along the
+   * entity's heading at its speed, e.g. one chosen to avoid its neighbors.
+   */
+  void UpdatePosition(class ArenaMobileEntity * const ent,
+                      const Vector2& velocity, uint dt,
+                      BumpAllocator * scratch = nullptr);
+
+ private:
+  static void Log(const char * name, const Position& old_pos,
+                  const Position& new_pos);
 };
 
 NAMESPACE_END(csci3081);
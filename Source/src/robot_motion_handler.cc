@@ -14,11 +14,22 @@
  ******************************************************************************/
 NAMESPACE_BEGIN(csci3081);
 
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+// Degrees turned per left/right command, and the matching rotation, which is
+// computed once so turning never calls cos/sin. In fixed point the sine and
+// cosine use constants that are constexpr, so they are ready however the
+// objects are linked.
+static const real_t kTurnDelta = 10;
+static const real_t kTurnCos = RealCosDeg(kTurnDelta);
+static const real_t kTurnSin = RealSinDeg(kTurnDelta);
+
 /*******************************************************************************
  * Constructors/Destructor
  ******************************************************************************/
 RobotMotionHandler::RobotMotionHandler() :
-  heading_angle_(0),
+  heading_(),
   speed_(0),
   max_speed_(5) {
 }
@@ -34,16 +45,17 @@ RobotMotionHandler::RobotMotionHandler() :
  * @param[in] cmd An event_commands enum that contains commands to
  * turn in different directions.
  *
+ * Turning rotates the direction vector by kTurnDelta degrees and
+ * renormalizes it, so rounding never lets its length drift.
  */
 void RobotMotionHandler::AcceptCommand(enum event_commands cmd) {
-  double turn_delta = 10;  // shift 5 degrees in either direction on key turn
   switch (cmd) {
   case COM_TURN_LEFT:
-  heading_angle_ = heading_angle_ - turn_delta;
+  heading_.vector(heading_.vector().Rotate(kTurnCos, -kTurnSin).Normalized());
 
   break;
   case COM_TURN_RIGHT:
-  heading_angle_ = heading_angle_ + turn_delta;
+  heading_.vector(heading_.vector().Rotate(kTurnCos, kTurnSin).Normalized());
 
   break;
   case COM_SPEED_UP:
@@ -56,6 +68,8 @@ void RobotMotionHandler::AcceptCommand(enum event_commands cmd) {
     speed_ = speed_ - 1;
   }
   break;
+  case COM_NONE:
+  break;
   default:
     std::cerr << "FATAL: bad actuator command" << std::endl;
     assert(0);
@@ -63,20 +77,22 @@ void RobotMotionHandler::AcceptCommand(enum event_commands cmd) {
 } /* accept_command() */
 
 /**
-* @brief Changes the heading_angle to the angle of incidence if the
+* @brief Reflects the heading about the surface that was touched if the
 * SensorTouch object is activated(). This causes the ArenaMobileEntity
-* to change its direction when it collides with something.
+* to bounce off whatever it collided with, leaving at the angle of incidence.
+*
+* The heading is only reflected while it still points into the surface. An
+* entity that is already moving away but still overlapping (the "jitter bug")
+* keeps its heading instead of being flipped back into the obstacle.
 *
 * @param st A SensorTouch object that can be activated()
 */
-void RobotMotionHandler::UpdateVelocity(SensorTouch st) {
+void RobotMotionHandler::UpdateVelocity(const SensorTouch& st) {
   if (st.activated()) {
-    // In the event the angle is -0, switch to 180 since it's the same.
-    if (st.angle_of_contact() == -0) {
-      heading_angle_ = 180;
-    } else {
-    heading_angle_ = - st.angle_of_contact();
-  }
+    const Vector2& contact = st.contact_direction();
+    if (heading_.vector().Dot(contact) > 0) {
+      heading_.vector(heading_.vector().Reflect(contact));
+    }
   }
 }
 
@@ -12,8 +12,8 @@
  ******************************************************************************/
 #include "src/event_commands.h"
 #include "src/robot_params.h"
-#include "src/arena_mobile_entity.h"
 #include "src/sensor_touch.h"
+#include "src/vector2.h"
 
 /*******************************************************************************
  * Namespaces
@@ -36,6 +36,10 @@ NAMESPACE_BEGIN(csci3081);
  *
  * For this iteration, both wheels are always going at maximum speed, and
  * cannot be controlled independently.
+ *
+ * The heading is kept as a unit direction vector. Turning rotates it by a
+ * precomputed rotation and collisions reflect it, so no trigonometry runs per
+ * step; heading_angle() converts to degrees only when asked.
  */
 class RobotMotionHandler {
  public:
@@ -59,22 +63,25 @@ class RobotMotionHandler {
   * @param touch sensor that can be activated and contains point-of-contact.
   *
   */
-  void UpdateVelocity(SensorTouch st);
+  void UpdateVelocity(const SensorTouch& st);
 
-  double speed() { return speed_; }
-  void speed(double sp) {
+  const real_t& speed() const { return speed_; }
+  void speed(real_t sp) {
     speed_ = sp; }
 
-  double heading_angle() const { return heading_angle_;}
-  void heading_angle(double ha) { heading_angle_ = ha; }
+  double heading_angle() const { return heading_.degrees(); }
+  void heading_angle(double ha) { heading_.degrees(ha); }
+
+  const Vector2& direction() const { return heading_.vector(); }
+  void direction(const Vector2& dir) { heading_.vector(dir); }
 
-  double max_speed() { return max_speed_; }
-  void max_speed(double ms) { max_speed_ = ms; }
+  real_t max_speed() const { return max_speed_; }
+  void max_speed(real_t ms) { max_speed_ = ms; }
 
  private:
-  double heading_angle_;
-  double speed_;
-  double max_speed_;
+  Heading heading_;
+  real_t speed_;
+  real_t max_speed_;
 };
 
 NAMESPACE_END(csci3081);
@@ -0,0 +1,415 @@
+/**
+ * @file scenario.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/scenario.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constant Definitions
+ ******************************************************************************/
+// Longest text line accepted, and records read per fread() when compiled
+static const size_t kLineMax = 512;
+static const size_t kRecordBatch = 4096;
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+static bool Fail(std::string * error, const char * path, size_t line,
+                 const char * reason) {
+  if (error) {
+    *error = std::string(path) + ":" + std::to_string(line) + ": " + reason;
+  }
+  return false;
+} /* Fail() */
+
+// Advance *p past one number, or return false if there is none
+static bool NextDouble(const char ** p, double * out) {
+  char * end;
+  *out = strtod(*p, &end);
+  if (end == *p) {
+    return false;
+  }
+  *p = end;
+  return true;
+} /* NextDouble() */
+
+static bool NextLong(const char ** p, long * out) {
+  char * end;
+  *out = strtol(*p, &end, 10);
+  if (end == *p) {
+    return false;
+  }
+  *p = end;
+  return true;
+} /* NextLong() */
+
+static bool AtEnd(const char * p) {
+  while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') {
+    ++p;
+  }
+  return *p == '\0' || *p == '#';
+} /* AtEnd() */
+
+// What both formats accept, so that a scenario compiles to one that loads
+// the same
+static bool ValidArena(int64_t x_dim, int64_t y_dim) {
+  return x_dim > 0 && y_dim > 0 && x_dim <= UINT32_MAX && y_dim <= UINT32_MAX;
+} /* ValidArena() */
+
+static bool ValidEntity(double x, double y, double radius) {
+  return std::isfinite(x) && std::isfinite(y) && std::isfinite(radius) &&
+      radius >= 0;
+} /* ValidEntity() */
+
+// <x> <y> <radius> <r> <g> <b> <a>, common to every entity
+static bool ParseEntity(const char ** p, arena_entity_params * ent) {
+  double x, y;
+  long c[4];
+  if (!NextDouble(p, &x) || !NextDouble(p, &y) ||
+      !NextDouble(p, &ent->radius) || !ValidEntity(x, y, ent->radius)) {
+    return false;
+  }
+  for (int i = 0; i < 4; ++i) {
+    if (!NextLong(p, &c[i]) || c[i] < 0 || c[i] > 255) {
+      return false;
+    }
+  } /* for(i..) */
+  ent->pos = Position(x, y);
+  ent->color = Color(c[0], c[1], c[2], c[3]);
+  return true;
+} /* ParseEntity() */
+
+static bool CheckCounts(size_t n_arenas, size_t n_robots, size_t n_home_bases,
+                        size_t n_stations, const char * path, size_t line,
+                        std::string * error) {
+  if (n_arenas != 1) {
+    return Fail(error, path, line, "expected exactly one arena line");
+  }
+  if (n_robots < 1) {
+    return Fail(error, path, line, "expected at least one robot");
+  }
+  if (n_home_bases != 1) {
+    return Fail(error, path, line, "expected exactly one home_base");
+  }
+  if (n_stations < 1) {
+    return Fail(error, path, line, "expected at least one recharge_station");
+  }
+  return true;
+} /* CheckCounts() */
+
+static bool LoadText(FILE * f, const char * path, arena_params * out,
+                     std::string * error) {
+  char buf[kLineMax];
+  size_t line = 0;
+  size_t n_arenas = 0, n_robots = 0, n_home_bases = 0, n_stations = 0;
+  while (fgets(buf, sizeof(buf), f)) {
+    ++line;
+    size_t len = strlen(buf);
+    if (len == sizeof(buf) - 1 && buf[len - 1] != '\n' && !feof(f)) {
+      return Fail(error, path, line, "line too long");
+    }
+    const char * p = buf;
+    while (*p == ' ' || *p == '\t') {
+      ++p;
+    }
+    if (AtEnd(p)) {
+      continue;
+    }
+    const char * word = p;
+    while (*p && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') {
+      ++p;
+    }
+    size_t n = p - word;
+    bool ok;
+    if (n == 8 && strncmp(word, "obstacle", n) == 0) {
+      arena_entity_params o;
+      ok = ParseEntity(&p, &o);
+      out->obstacles.push_back(o);
+    } else if (n == 5 && strncmp(word, "robot", n) == 0) {
+      robot_params r;
+      long angle_delta = 0;
+      ok = ParseEntity(&p, &r) && NextDouble(&p, &r.collision_delta) &&
+          NextDouble(&p, &r.battery_max_charge) &&
+          NextLong(&p, &angle_delta) && angle_delta >= 0;
+      r.angle_delta = angle_delta;
+      if (n_robots++ == 0) {
+        out->robot = r;
+      } else {
+        out->extra_robots.push_back(r);
+      }
+    } else if (n == 16 && strncmp(word, "recharge_station", n) == 0) {
+      arena_entity_params s;
+      ok = ParseEntity(&p, &s);
+      if (n_stations++ == 0) {
+        out->recharge_station = s;
+      } else {
+        out->extra_recharge_stations.push_back(s);
+      }
+    } else if (n == 9 && strncmp(word, "home_base", n) == 0) {
+      home_base_params& h = out->home_base;
+      long seed = 0;
+      ok = ParseEntity(&p, &h) && NextDouble(&p, &h.collision_delta);
+      if (ok && !AtEnd(p)) {
+        ok = NextLong(&p, &seed) && seed >= 0;
+      }
+      h.seed = static_cast<unsigned>(seed);
+      ++n_home_bases;
+    } else if (n == 5 && strncmp(word, "arena", n) == 0) {
+      long x = 0, y = 0;
+      ok = NextLong(&p, &x) && NextLong(&p, &y) && ValidArena(x, y);
+      out->x_dim = x;
+      out->y_dim = y;
+      ++n_arenas;
+    } else {
+      return Fail(error, path, line, "unknown entity");
+    }
+    if (!ok || !AtEnd(p)) {
+      return Fail(error, path, line, "malformed fields");
+    }
+  } /* while(fgets..) */
+  if (ferror(f)) {
+    return Fail(error, path, line, "read error");
+  }
+  return CheckCounts(n_arenas, n_robots, n_home_bases, n_stations, path, line,
+                     error);
+} /* LoadText() */
+
+static void FromRecord(const scenario_record& rec, arena_entity_params * ent) {
+  ent->pos = Position(rec.x, rec.y);
+  ent->radius = rec.radius;
+  ent->color = Color(rec.r, rec.g, rec.b, rec.a);
+} /* FromRecord() */
+
+static scenario_record ToRecord(const arena_entity_params& ent) {
+  scenario_record rec;
+  memset(&rec, 0, sizeof(rec));
+  rec.x = RealToDouble(ent.pos.x);
+  rec.y = RealToDouble(ent.pos.y);
+  rec.radius = ent.radius;
+  rec.r = ent.color.r;
+  rec.g = ent.color.g;
+  rec.b = ent.color.b;
+  rec.a = ent.color.a;
+  return rec;
+} /* ToRecord() */
+
+static bool LoadBinary(FILE * f, const char * path, arena_params * out,
+                       std::string * error) {
+  scenario_header hdr;
+  if (fread(&hdr, sizeof(hdr), 1, f) != 1) {
+    return Fail(error, path, 0, "truncated header");
+  }
+  if (hdr.version != SCENARIO_VERSION) {
+    return Fail(error, path, 0, "unsupported scenario version");
+  }
+  if (!CheckCounts(1, hdr.n_robots, hdr.n_home_bases, hdr.n_recharge_stations,
+                   path, 0, error)) {
+    return false;
+  }
+  if (!ValidArena(hdr.x_dim, hdr.y_dim)) {
+    return Fail(error, path, 0, "invalid arena size");
+  }
+  // Check each count against the records left in the file before adding
+  // them up or reserving room for them, so no count can wrap the total
+  long start = ftell(f);
+  if (start < 0 || fseek(f, 0, SEEK_END) != 0) {
+    return Fail(error, path, 0, "truncated records");
+  }
+  long end = ftell(f);
+  if (end < start || fseek(f, start, SEEK_SET) != 0) {
+    return Fail(error, path, 0, "truncated records");
+  }
+  uint64_t left = static_cast<uint64_t>(end - start) /
+      sizeof(scenario_record);
+  const uint64_t counts[] = {hdr.n_robots, hdr.n_home_bases,
+                             hdr.n_recharge_stations, hdr.n_obstacles};
+  uint64_t total = 0;
+  for (uint64_t count : counts) {
+    if (count > left - total) {
+      return Fail(error, path, 0, "truncated or corrupt records");
+    }
+    total += count;
+  } /* for(count..) */
+  out->x_dim = hdr.x_dim;
+  out->y_dim = hdr.y_dim;
+  out->extra_robots.reserve(hdr.n_robots - 1);
+  out->extra_recharge_stations.reserve(hdr.n_recharge_stations - 1);
+  out->obstacles.reserve(hdr.n_obstacles);
+
+  std::vector<scenario_record> batch(kRecordBatch);
+  uint64_t index = 0;
+  while (index < total) {
+    size_t want = static_cast<size_t>(
+        std::min<uint64_t>(kRecordBatch, total - index));
+    if (fread(batch.data(), sizeof(scenario_record), want, f) != want) {
+      return Fail(error, path, 0, "truncated records");
+    }
+    for (size_t i = 0; i < want; ++i, ++index) {
+      const scenario_record& rec = batch[i];
+      if (!ValidEntity(rec.x, rec.y, rec.radius)) {
+        return Fail(error, path, 0, "invalid entity");
+      }
+      if (index < hdr.n_robots) {
+        robot_params r;
+        FromRecord(rec, &r);
+        r.collision_delta = rec.collision_delta;
+        r.battery_max_charge = rec.battery_max_charge;
+        r.angle_delta = rec.angle_delta;
+        if (index == 0) {
+          out->robot = r;
+        } else {
+          out->extra_robots.push_back(r);
+        }
+      } else if (index < hdr.n_robots + hdr.n_home_bases) {
+        FromRecord(rec, &out->home_base);
+        out->home_base.collision_delta = rec.collision_delta;
+        out->home_base.seed = rec.seed;
+      } else if (index < total - hdr.n_obstacles) {
+        arena_entity_params s;
+        FromRecord(rec, &s);
+        if (index == hdr.n_robots + hdr.n_home_bases) {
+          out->recharge_station = s;
+        } else {
+          out->extra_recharge_stations.push_back(s);
+        }
+      } else {
+        arena_entity_params o;
+        FromRecord(rec, &o);
+        out->obstacles.push_back(o);
+      }
+    } /* for(i..) */
+  } /* while(index..) */
+  return true;
+} /* LoadBinary() */
+
+bool LoadScenario(const char * path, struct arena_params * aparams,
+                  std::string * error) {
+  FILE * f = fopen(path, "rb");
+  if (!f) {
+    return Fail(error, path, 0, strerror(errno));
+  }
+  arena_params loaded;
+  char magic[4] = {0};
+  bool binary = fread(magic, 1, sizeof(magic), f) == sizeof(magic) &&
+      memcmp(magic, SCENARIO_MAGIC, sizeof(magic)) == 0;
+  rewind(f);
+  bool ok = binary ? LoadBinary(f, path, &loaded, error) :
+      LoadText(f, path, &loaded, error);
+  fclose(f);
+  if (ok) {
+    *aparams = std::move(loaded);
+  }
+  return ok;
+} /* LoadScenario() */
+
+bool SaveScenarioText(const char * path, const struct arena_params& aparams,
+                      std::string * error) {
+  FILE * f = fopen(path, "w");
+  if (!f) {
+    return Fail(error, path, 0, strerror(errno));
+  }
+  const char * entity_fmt = "%s %.17g %.17g %.17g %d %d %d %d";
+  auto entity = [&](const char * kind, const arena_entity_params& e) {
+    fprintf(f, entity_fmt, kind, RealToDouble(e.pos.x),
+            RealToDouble(e.pos.y), e.radius, e.color.r, e.color.g,
+            e.color.b, e.color.a);
+  };
+  auto robot = [&](const robot_params& r) {
+    entity("robot", r);
+    fprintf(f, " %.17g %.17g %u\n", r.collision_delta, r.battery_max_charge,
+            r.angle_delta);
+  };
+  fprintf(f, "arena %u %u\n", aparams.x_dim, aparams.y_dim);
+  robot(aparams.robot);
+  for (const robot_params& r : aparams.extra_robots) {
+    robot(r);
+  } /* for(r..) */
+  entity("home_base", aparams.home_base);
+  fprintf(f, " %.17g %u\n", aparams.home_base.collision_delta,
+          aparams.home_base.seed);
+  entity("recharge_station", aparams.recharge_station);
+  fputc('\n', f);
+  for (const arena_entity_params& s : aparams.extra_recharge_stations) {
+    entity("recharge_station", s);
+    fputc('\n', f);
+  } /* for(s..) */
+  for (const arena_entity_params& o : aparams.obstacles) {
+    entity("obstacle", o);
+    fputc('\n', f);
+  } /* for(o..) */
+  bool ok = !ferror(f);
+  if (fclose(f) != 0 || !ok) {
+    return Fail(error, path, 0, "write error");
+  }
+  return true;
+} /* SaveScenarioText() */
+
+bool SaveScenarioBinary(const char * path, const struct arena_params& aparams,
+                        std::string * error) {
+  FILE * f = fopen(path, "wb");
+  if (!f) {
+    return Fail(error, path, 0, strerror(errno));
+  }
+  scenario_header hdr;
+  memset(&hdr, 0, sizeof(hdr));
+  memcpy(hdr.magic, SCENARIO_MAGIC, sizeof(hdr.magic));
+  hdr.version = SCENARIO_VERSION;
+  hdr.x_dim = aparams.x_dim;
+  hdr.y_dim = aparams.y_dim;
+  hdr.n_robots = 1 + aparams.extra_robots.size();
+  hdr.n_home_bases = 1;
+  hdr.n_recharge_stations = 1 + aparams.extra_recharge_stations.size();
+  hdr.n_obstacles = aparams.obstacles.size();
+  fwrite(&hdr, sizeof(hdr), 1, f);
+
+  auto robot = [&](const robot_params& r) {
+    scenario_record rec = ToRecord(r);
+    rec.collision_delta = r.collision_delta;
+    rec.battery_max_charge = r.battery_max_charge;
+    rec.angle_delta = r.angle_delta;
+    fwrite(&rec, sizeof(rec), 1, f);
+  };
+  robot(aparams.robot);
+  for (const robot_params& r : aparams.extra_robots) {
+    robot(r);
+  } /* for(r..) */
+  scenario_record rec = ToRecord(aparams.home_base);
+  rec.collision_delta = aparams.home_base.collision_delta;
+  rec.seed = aparams.home_base.seed;
+  fwrite(&rec, sizeof(rec), 1, f);
+  rec = ToRecord(aparams.recharge_station);
+  fwrite(&rec, sizeof(rec), 1, f);
+  for (const arena_entity_params& s : aparams.extra_recharge_stations) {
+    rec = ToRecord(s);
+    fwrite(&rec, sizeof(rec), 1, f);
+  } /* for(s..) */
+  for (const arena_entity_params& o : aparams.obstacles) {
+    rec = ToRecord(o);
+    fwrite(&rec, sizeof(rec), 1, f);
+  } /* for(o..) */
+  bool ok = !ferror(f);
+  if (fclose(f) != 0 || !ok) {
+    return Fail(error, path, 0, "write error");
+  }
+  return true;
+} /* SaveScenarioBinary() */
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,111 @@
+/**
+ * @file scenario.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_SCENARIO_H_
+#define SRC_SCENARIO_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include <string>
+#include "src/common.h"
+#include "src/arena_params.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constant Definitions
+ ******************************************************************************/
+#define SCENARIO_MAGIC "ARSC"
+#define SCENARIO_VERSION 1
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief Start of a compiled (binary) scenario file.
+ *
+ * It is followed by n_robots, n_home_bases, n_recharge_stations and then
+ * n_obstacles scenario_records, in that order. Everything is stored in the
+ * byte order of the machine that compiled the file.
+ */
+struct scenario_header {
+  char magic[4];
+  uint32_t version;
+  uint32_t x_dim;
+  uint32_t y_dim;
+  uint64_t n_robots;
+  uint64_t n_home_bases;
+  uint64_t n_recharge_stations;
+  uint64_t n_obstacles;
+};
+
+/**
+ * @brief One entity of a compiled scenario. Fields that do not apply to the
+ * entity's kind are zero.
+ */
+struct scenario_record {
+  double x;
+  double y;
+  double radius;
+  double collision_delta;
+  double battery_max_charge;
+  uint32_t angle_delta;
+  uint32_t seed;
+  uint8_t r, g, b, a;
+  uint32_t reserved;
+};
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief Fill in arena parameters from a scenario file.
+ *
+ * Compiled files are recognized by their header; anything else is parsed as
+ * text, one entity per line:
+ *
+ *     # comment
+ *     arena <x_dim> <y_dim>
+ *     robot <x> <y> <radius> <r> <g> <b> <a> <collision_delta>
+ *           <battery_max_charge> <angle_delta>
+ *     home_base <x> <y> <radius> <r> <g> <b> <a> <collision_delta> [<seed>]
+ *     recharge_station <x> <y> <radius> <r> <g> <b> <a>
+ *     obstacle <x> <y> <radius> <r> <g> <b> <a>
+ *
+ * A scenario needs one arena line, one home base, and at least one robot and
+ * one recharge station; the first robot is the player's. Any number of
+ * obstacles may follow. Both forms are read in fixed-size pieces, so memory
+ * use beyond the resulting parameters does not grow with the file.
+ *
+ * @param[in] path The file to read.
+ * @param[out] aparams Replaced with the scenario on success.
+ * @param[out] error Set to a "path:line: reason" message on failure.
+ *
+ * @return Whether the scenario was loaded.
+ */
+bool LoadScenario(const char * path, struct arena_params * aparams,
+                  std::string * error);
+
+/**
+ * @brief Write arena parameters as a text scenario.
+ */
+bool SaveScenarioText(const char * path, const struct arena_params& aparams,
+                      std::string * error);
+
+/**
+ * @brief Write arena parameters as a compiled scenario.
+ */
+bool SaveScenarioBinary(const char * path, const struct arena_params& aparams,
+                        std::string * error);
+
+NAMESPACE_END(csci3081);
+
+#endif /* SRC_SCENARIO_H_ */
@@ -0,0 +1,75 @@
+/**
+ * @file sensor_lidar.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/sensor_lidar.h"
+#include <algorithm>
+#include <cmath>
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+SensorLidar::SensorLidar(size_t n_beams, double fov, double max_range) :
+  fov_(fov),
+  max_range_(max_range),
+  beam_cos_(n_beams),
+  beam_sin_(n_beams),
+  dx_(n_beams),
+  dy_(n_beams),
+  readings_(n_beams, max_range) {
+  // All round, the last beam would repeat the first; a cone includes both
+  // of its edges
+  double step = fov >= 360 ? fov / n_beams :
+      (n_beams > 1 ? fov / (n_beams - 1) : 0);
+  double first = fov >= 360 ? 0 : (n_beams > 1 ? -fov / 2 : 0);
+  for (size_t i = 0; i < n_beams; ++i) {
+    double rad = (first + step * i) * M_PI / 180.0;
+    beam_cos_[i] = std::cos(rad);
+    beam_sin_[i] = std::sin(rad);
+  } /* for(i..) */
+}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void SensorLidar::Scan(const Position& origin, const Vector2& heading,
+                       real_t x_dim, real_t y_dim,
+                       const struct circle_batch& targets) {
+  double hx = RealToDouble(heading.x);
+  double hy = RealToDouble(heading.y);
+  double ox = RealToDouble(origin.x);
+  double oy = RealToDouble(origin.y);
+  size_t n = readings_.size();
+  for (size_t i = 0; i < n; ++i) {
+    dx_[i] = beam_cos_[i] * hx - beam_sin_[i] * hy;
+    dy_[i] = beam_sin_[i] * hx + beam_cos_[i] * hy;
+  } /* for(i..) */
+  std::fill(readings_.begin(), readings_.end(), max_range_);
+  CastRaysAtBox(ox, oy, dx_.data(), dy_.data(), n, RealToDouble(x_dim),
+                RealToDouble(y_dim), readings_.data());
+  CastRaysAtCircles(ox, oy, dx_.data(), dy_.data(), n, targets,
+                    readings_.data());
+  activated_ = std::find_if(readings_.begin(), readings_.end(),
+                            [this](double r) { return r < max_range_; }) !=
+      readings_.end();
+} /* Scan() */
+
+void SensorLidar::Accept(const EventCollision *) {
+} /* Accept() */
+
+void SensorLidar::Reset(void) {
+  std::fill(readings_.begin(), readings_.end(), max_range_);
+  activated_ = false;
+} /* Reset() */
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,92 @@
+/**
+ * @file sensor_lidar.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_SENSOR_LIDAR_H_
+#define SRC_SENSOR_LIDAR_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <vector>
+
+#include "src/common.h"
+#include "src/event_collision.h"
+#include "src/ray_cast.h"
+#include "src/vector2.h"
+#include "src/Sensor.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Classes
+ ******************************************************************************/
+/**
+ * @brief A range sensor: a fan of beams, each reading the distance to the
+ * first thing it meets, up to max_range.
+ *
+ * With a field of view of 360 the beams are spread evenly all round, so it
+ * is a lidar; narrower, they span the cone from -fov/2 to +fov/2 around the
+ * heading, so a few beams make a proximity cone. Beam 0 is the most
+ * clockwise.
+ *
+ * The Arena takes the readings every step (see Arena::LidarSystem()), after
+ * everything has moved. They are kept in one contiguous array, so
+ * controllers can read them directly.
+ */
+class SensorLidar : public Sensor {
+ public:
+  explicit SensorLidar(size_t n_beams = 32, double fov = 360,
+                       double max_range = 100);
+
+  size_t n_beams(void) const { return readings_.size(); }
+  double fov(void) const { return fov_; }
+  double max_range(void) const { return max_range_; }
+
+  /**
+   * @brief The range read by each beam, max_range() where it met nothing.
+   */
+  const double * readings(void) const { return readings_.data(); }
+
+  /**
+   * @brief Whether any beam met something within range.
+   */
+  bool activated(void) const { return activated_; }
+
+  /**
+   * @brief Take a reading from origin, facing heading, in an arena of the
+   * given size that contains targets.
+   */
+  void Scan(const Position& origin, const Vector2& heading, real_t x_dim,
+            real_t y_dim, const struct circle_batch& targets);
+
+  /**
+   * @brief Collisions carry nothing a range sensor can use; readings come
+   * from Scan().
+   */
+  void Accept(const EventCollision * e);
+
+  /**
+   * @brief Forget the last reading: every beam reads max_range.
+   */
+  void Reset(void);
+
+ private:
+  double fov_;
+  double max_range_;
+  // Beam directions relative to the heading, and in the world for a scan
+  std::vector<double> beam_cos_;
+  std::vector<double> beam_sin_;
+  std::vector<double> dx_;
+  std::vector<double> dy_;
+  std::vector<double> readings_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif   /* SRC_SENSOR_LIDAR_H_ */
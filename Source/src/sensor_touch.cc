@@ -21,19 +21,19 @@ NAMESPACE_BEGIN(csci3081);
 SensorTouch::SensorTouch() :
   activated_(false),
   point_of_contact_(0, 0),
-  angle_of_contact_(0) {
+  contact_() {
 }
 
 /*******************************************************************************
  * Member Functions
  ******************************************************************************/
 
-void SensorTouch::Accept(EventCollision * e) {
+void SensorTouch::Accept(const EventCollision * e) {
   // Determine if the sensor should be activated or inactivated.
   if (e->collided()) {
     activated_ = true;
     point_of_contact_ = e->point_of_contact();
-    angle_of_contact_ = e->angle_of_contact();
+    contact_.vector(e->contact_direction());
   } else {
     activated_ = false;
   }
@@ -15,6 +15,7 @@
 
 #include "src/common.h"
 #include "src/event_collision.h"
+#include "src/vector2.h"
 #include "src/Sensor.h"
 
 /*******************************************************************************
@@ -33,6 +34,9 @@ class ArenaEntity;
  * around the perimeter of the robot. A collision will activate the sensor
  * at a particular point of contact, which translates to an angle of contact
  *
+ * The contact is kept as a unit direction vector (see
+ * EventCollision::contact_direction()); angle_of_contact() is only a view
+ * of it for callers that want degrees.
  */
 class SensorTouch : public Sensor {
  public:
@@ -43,17 +47,19 @@ class SensorTouch : public Sensor {
    *
    * @return activation status
    */
-  bool activated(void) { return activated_; }
+  bool activated(void) const { return activated_; }
   void activated(bool value) { activated_ = value; }
 
-  Position point_of_contact() { return point_of_contact_; }
+  Position point_of_contact() const { return point_of_contact_; }
   void point_of_contact(Position p) {
     point_of_contact_.x = p.x;
     point_of_contact_.y = p.y;
   }
 
-  double angle_of_contact(void) { return angle_of_contact_; }
-  void angle_of_contact(double aoc) { angle_of_contact_ = aoc; }
+  double angle_of_contact(void) const { return contact_.degrees(); }
+  void angle_of_contact(double aoc) { contact_.degrees(aoc); }
+  const Vector2& contact_direction(void) const { return contact_.vector(); }
+  void contact_direction(const Vector2& dir) { contact_.vector(dir); }
 
   /**
    * @brief Compute a new reading based on the collision event.
@@ -63,7 +69,7 @@ class SensorTouch : public Sensor {
    *
    */
 
-  void Accept(EventCollision * e);
+  void Accept(const EventCollision * e);
 
   /**
    * @brief Reset the proximity sensor to its newly constructed state.
@@ -73,7 +79,7 @@ class SensorTouch : public Sensor {
  private:
   bool activated_;
   Position point_of_contact_;
-  double angle_of_contact_;
+  Heading contact_;
 };
 
 NAMESPACE_END(csci3081);
@@ -0,0 +1,109 @@
+/**
+ * @file shared_memory.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/shared_memory.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+bool ShmFail(std::string * error, const char * name, const char * why) {
+  if (error) {
+    *error = std::string(name) + ": " + why;
+  }
+  return false;
+} /* ShmFail() */
+
+/**
+ * @brief Map all of the open fd, then close it.
+ */
+static void * MapWhole(int fd, const char * name, int prot, size_t min_size,
+                       const char * too_small, size_t * size,
+                       std::string * error) {
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    int why = errno;
+    close(fd);
+    ShmFail(error, name, strerror(why));
+    return nullptr;
+  }
+  *size = static_cast<size_t>(st.st_size);
+  if (*size < min_size) {
+    close(fd);
+    ShmFail(error, name, too_small);
+    return nullptr;
+  }
+  void * p = mmap(nullptr, *size, prot, MAP_SHARED, fd, 0);
+  close(fd);
+  if (p == MAP_FAILED) {
+    ShmFail(error, name, strerror(errno));
+    return nullptr;
+  }
+  return p;
+} /* MapWhole() */
+
+void * CreateShared(const char * name, size_t size, mode_t mode,
+                    std::string * error) {
+  shm_unlink(name);
+  int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, mode);
+  if (fd < 0) {
+    ShmFail(error, name, strerror(errno));
+    return nullptr;
+  }
+  if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    int why = errno;
+    close(fd);
+    shm_unlink(name);
+    ShmFail(error, name, strerror(why));
+    return nullptr;
+  }
+  void * p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (p == MAP_FAILED) {
+    int why = errno;
+    shm_unlink(name);
+    ShmFail(error, name, strerror(why));
+    return nullptr;
+  }
+  return p;
+} /* CreateShared() */
+
+void * AttachShared(const char * name, bool writable, size_t min_size,
+                    const char * too_small, size_t * size,
+                    std::string * error) {
+  int fd = shm_open(name, writable ? O_RDWR : O_RDONLY, 0);
+  if (fd < 0) {
+    ShmFail(error, name, strerror(errno));
+    return nullptr;
+  }
+  return MapWhole(fd, name, writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                  min_size, too_small, size, error);
+} /* AttachShared() */
+
+void * MapFile(const char * path, size_t min_size, const char * too_small,
+               size_t * size, std::string * error) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    ShmFail(error, path, strerror(errno));
+    return nullptr;
+  }
+  return MapWhole(fd, path, PROT_READ, min_size, too_small, size, error);
+} /* MapFile() */
+
+NAMESPACE_END(csci3081);
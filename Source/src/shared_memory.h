@@ -0,0 +1,69 @@
+/**
+ * @file shared_memory.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_SHARED_MEMORY_H_
+#define SRC_SHARED_MEMORY_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stddef.h>
+#include <sys/types.h>
+#include <string>
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief Set *error, if error is not nullptr, to "name: why", as the
+ * functions here report what went wrong with a shared memory object or
+ * file.
+ *
+ * @return false, to be returned in turn.
+ */
+bool ShmFail(std::string * error, const char * name, const char * why);
+
+/**
+ * @brief Create the POSIX shared memory object name, e.g. "/arena-0", as
+ * size bytes of zeros mapped for reading and writing. One left over by an
+ * earlier run is unlinked first, so that whoever is still attached to it
+ * keeps the old memory rather than seeing the new one being filled in.
+ *
+ * @return The mapping, to be unmapped and name unlinked by the caller; or
+ * nullptr, with *error set.
+ */
+void * CreateShared(const char * name, size_t size, mode_t mode,
+                    std::string * error);
+
+/**
+ * @brief Map the whole of the shared memory object name, made by
+ * CreateShared() in this process or another.
+ *
+ * @param[in] min_size Fewer bytes than this are reported as too_small.
+ * @param[out] size The size of the mapping.
+ *
+ * @return The mapping, to be unmapped by the caller; or nullptr, with
+ * *error set.
+ */
+void * AttachShared(const char * name, bool writable, size_t min_size,
+                    const char * too_small, size_t * size,
+                    std::string * error);
+
+/**
+ * @brief As AttachShared(), read only, for the file at path.
+ */
+void * MapFile(const char * path, size_t min_size, const char * too_small,
+               size_t * size, std::string * error);
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_SHARED_MEMORY_H_
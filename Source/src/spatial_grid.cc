@@ -0,0 +1,98 @@
+/**
+ * @file spatial_grid.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/spatial_grid.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+SpatialGrid::SpatialGrid(void) :
+  cell_(1), cols_(1), rows_(1), max_radius_(0), fixed_max_radius_(0),
+  fixed_(), moving_(), movers_(), is_mover_() {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void SpatialGrid::Build(const circle_batch& circles, double x_dim,
+                        double y_dim, double cell_size,
+                        const std::vector<uint32_t> * movers) {
+  cell_ = cell_size;
+  cols_ = std::max(1, static_cast<int>(std::ceil(x_dim / cell_size)));
+  rows_ = std::max(1, static_cast<int>(std::ceil(y_dim / cell_size)));
+  if (!movers) {
+    movers_.clear();
+    fixed_max_radius_ = Sort(circles, nullptr, circles.size(), &fixed_);
+    max_radius_ = fixed_max_radius_;
+    Sort(circles, nullptr, 0, &moving_);
+    return;
+  }
+
+  // The rest, in order, are the fixed ones
+  movers_ = *movers;
+  is_mover_.assign(circles.size(), 0);
+  for (uint32_t i : movers_) {
+    is_mover_[i] = 1;
+  } /* for(i..) */
+  std::vector<uint32_t> fixed;
+  fixed.reserve(circles.size() - movers_.size());
+  for (size_t i = 0; i < circles.size(); ++i) {
+    if (!is_mover_[i]) {
+      fixed.push_back(static_cast<uint32_t>(i));
+    }
+  } /* for(i..) */
+  fixed_max_radius_ = Sort(circles, fixed.data(), fixed.size(), &fixed_);
+  Rebin(circles);
+} /* Build() */
+
+void SpatialGrid::Rebin(const circle_batch& circles) {
+  max_radius_ = std::max(fixed_max_radius_,
+                         Sort(circles, movers_.data(), movers_.size(),
+                              &moving_));
+} /* Rebin() */
+
+double SpatialGrid::Sort(const circle_batch& circles, const uint32_t * which,
+                         size_t n, layer * out) const {
+  // Count, then turn the counts into where each cell starts
+  out->cell_start.assign(static_cast<size_t>(cols_) * rows_ + 1, 0);
+  double max_radius = 0;
+  for (size_t j = 0; j < n; ++j) {
+    uint32_t i = which ? which[j] : static_cast<uint32_t>(j);
+    uint32_t c = CellOf(circles.x[i], circles.y[i]);
+    ++out->cell_start[c + 1];
+    max_radius = std::max(max_radius, circles.r[i]);
+  } /* for(j..) */
+  for (size_t c = 1; c < out->cell_start.size(); ++c) {
+    out->cell_start[c] += out->cell_start[c - 1];
+  } /* for(c..) */
+
+  // Place each circle, counting the starts back up to the ends as we go
+  out->items.resize(n);
+  out->x.resize(n);
+  out->y.resize(n);
+  for (size_t j = 0; j < n; ++j) {
+    uint32_t i = which ? which[j] : static_cast<uint32_t>(j);
+    uint32_t c = CellOf(circles.x[i], circles.y[i]);
+    uint32_t slot = out->cell_start[c]++;
+    out->items[slot] = i;
+    out->x[slot] = circles.x[i];
+    out->y[slot] = circles.y[i];
+  } /* for(j..) */
+  for (size_t c = out->cell_start.size() - 1; c > 0; --c) {
+    out->cell_start[c] = out->cell_start[c - 1];
+  } /* for(c..) */
+  out->cell_start[0] = 0;
+  return max_radius;
+} /* Sort() */
+
+NAMESPACE_END(csci3081);
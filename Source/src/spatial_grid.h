@@ -0,0 +1,246 @@
+/**
+ * @file spatial_grid.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_SPATIAL_GRID_H_
+#define SRC_SPATIAL_GRID_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "src/common.h"
+#include "src/ray_cast.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief A uniform grid over circles that move, rebuilt from scratch whenever
+ * they have.
+ *
+ * Build() sorts the circles into their cells by a counting sort, as
+ * StaticMap does, so the circles of a row of cells are one run of memory and
+ * a rebuild is O(n) with no allocation once the grid has been built at its
+ * largest. Items are the circles' indices in the batch it was built from.
+ *
+ * Where only some of the circles move, Build() can be told which; the rest
+ * are sorted into a layer of their own once, and Rebin() sorts only the
+ * movers again.
+ */
+class SpatialGrid {
+ public:
+  SpatialGrid(void);
+
+  /**
+   * @brief Sort circles into cells of cell_size over [0, x_dim) x [0,
+   * y_dim). Circles outside go in the border cells.
+   *
+   * @param[in] movers If not nullptr, the indices of the circles that can
+   * move. The others are taken to stay put until the next Build().
+   */
+  void Build(const struct circle_batch& circles, double x_dim, double y_dim,
+             double cell_size, const std::vector<uint32_t> * movers = nullptr);
+
+  /**
+   * @brief Sort the movers given to the last Build() again, from where they
+   * are now in circles, the same batch with only the movers' centers
+   * changed.
+   */
+  void Rebin(const struct circle_batch& circles);
+
+  size_t size(void) const {
+    return fixed_.items.size() + moving_.items.size();
+  }
+
+  /**
+   * @brief Call f(item) for every circle that may overlap the box: those whose
+   * center is in a cell the box, grown by the largest radius, touches. The
+   * caller does the exact test.
+   */
+  template <typename F>
+  void ForEachInBox(double x0, double y0, double x1, double y1,
+                    F f) const {
+    if (size() == 0) {
+      return;
+    }
+    double inv = 1.0 / cell_;
+    int c0 = Clamp((x0 - max_radius_) * inv, cols_);
+    int c1 = Clamp((x1 + max_radius_) * inv, cols_);
+    int r0 = Clamp((y0 - max_radius_) * inv, rows_);
+    int r1 = Clamp((y1 + max_radius_) * inv, rows_);
+    for (const layer * l : {&fixed_, &moving_}) {
+      if (l->items.empty()) {
+        continue;
+      }
+      for (int row = r0; row <= r1; ++row) {
+        const uint32_t * start = &l->cell_start[row * cols_];
+        for (uint32_t i = start[c0]; i < start[c1 + 1]; ++i) {
+          f(l->items[i]);
+        } /* for(i..) */
+      } /* for(row..) */
+    } /* for(l..) */
+  }
+
+  /**
+   * @brief The (up to) k circles whose centers are nearest (x, y) and no
+   * further than max_distance, nearest first (ties by item).
+   *
+   * @param[out] items Room for k items.
+   * @param[out] distances Room for k; their center distances.
+   * @param[in] skip An item to leave out, e.g. the one asking; -1 for none.
+   *
+   * @return How many were found.
+   */
+  size_t Nearest(double x, double y, double max_distance, size_t k,
+                 uint32_t * items, double * distances,
+                 int64_t skip = -1) const {
+    return NearestWhere(x, y, max_distance, k, items, distances,
+                        [skip](uint32_t item) {
+        return static_cast<int64_t>(item) != skip; });
+  }
+
+  /**
+   * @brief As Nearest(), among the circles for which accept(item) is true.
+   */
+  template <typename F>
+  size_t NearestWhere(double x, double y, double max_distance, size_t k,
+                      uint32_t * items, double * distances, F accept) const {
+    if (k == 0 || size() == 0) {
+      return 0;
+    }
+    double inv = 1.0 / cell_;
+    int cx = Clamp(x * inv, cols_);
+    int cy = Clamp(y * inv, rows_);
+    double max2 = max_distance * max_distance;
+    size_t n = 0;
+
+    // Kept sorted by squared distance while searching
+    auto consider = [&](const layer& l, uint32_t slot) {
+      double dx = l.x[slot] - x;
+      double dy = l.y[slot] - y;
+      double d2 = dx * dx + dy * dy;
+      uint32_t item = l.items[slot];
+      if (d2 > max2 || (n == k && (d2 > distances[k - 1] ||
+                                   (d2 == distances[k - 1] &&
+                                    item > items[k - 1]))) ||
+          !accept(item)) {
+        return;
+      }
+      size_t j = n < k ? n++ : k - 1;
+      while (j > 0 && (distances[j - 1] > d2 ||
+                       (distances[j - 1] == d2 && items[j - 1] > item))) {
+        distances[j] = distances[j - 1];
+        items[j] = items[j - 1];
+        --j;
+      } /* while() */
+      distances[j] = d2;
+      items[j] = item;
+    };
+    auto scan = [&](int col, int row) {
+      if (col < 0 || col >= cols_ || row < 0 || row >= rows_) {
+        return;
+      }
+      size_t c = static_cast<size_t>(row) * cols_ + col;
+      for (const layer * l : {&fixed_, &moving_}) {
+        if (l->items.empty()) {
+          continue;
+        }
+        for (uint32_t i = l->cell_start[c]; i < l->cell_start[c + 1]; ++i) {
+          consider(*l, i);
+        } /* for(i..) */
+      } /* for(l..) */
+    };
+
+    // Rings of cells outward; every cell of ring r is at least (r - 1) cells
+    // from the query point
+    int max_ring = std::max(cols_, rows_);
+    for (int r = 0; r <= max_ring; ++r) {
+      if (r == 0) {
+        scan(cx, cy);
+        continue;
+      }
+      double bound = (r - 1) * cell_;
+      if (bound * bound > max2 ||
+          (n == k && bound * bound > distances[k - 1])) {
+        break;
+      }
+      for (int col = cx - r; col <= cx + r; ++col) {
+        scan(col, cy - r);
+        scan(col, cy + r);
+      } /* for(col..) */
+      for (int row = cy - r + 1; row <= cy + r - 1; ++row) {
+        scan(cx - r, row);
+        scan(cx + r, row);
+      } /* for(row..) */
+    } /* for(r..) */
+
+    for (size_t i = 0; i < n; ++i) {
+      distances[i] = std::sqrt(distances[i]);
+    } /* for(i..) */
+    return n;
+  }
+
+  /**
+   * @brief Row-major index of the cell (x, y) is in, for visiting many
+   * query points in cell order.
+   */
+  uint32_t CellOf(double x, double y) const {
+    double inv = 1.0 / cell_;
+    return static_cast<uint32_t>(Clamp(y * inv, rows_) * cols_ +
+                                 Clamp(x * inv, cols_));
+  }
+
+ private:
+  /**
+   * @brief Row-major cells; the items of cell c are items[cell_start[c] ..
+   * cell_start[c + 1]), with their centers alongside.
+   */
+  struct layer {
+    layer(void) : cell_start(), items(), x(), y() {}
+
+    std::vector<uint32_t> cell_start;
+    std::vector<uint32_t> items;
+    std::vector<double> x;
+    std::vector<double> y;
+  };
+
+  static int Clamp(double cell, int n) {
+    return static_cast<int>(std::min(std::max(std::floor(cell), 0.0),
+                                     static_cast<double>(n - 1)));
+  }
+
+  /**
+   * @brief Sort the circles numbered which[0 .. n) (all of them, in order,
+   * if which is nullptr) into out.
+   *
+   * @return The largest radius among them.
+   */
+  double Sort(const struct circle_batch& circles, const uint32_t * which,
+              size_t n, layer * out) const;
+
+  double cell_;
+  int cols_;
+  int rows_;
+  double max_radius_;
+  double fixed_max_radius_;
+  // What does not move, and what does
+  layer fixed_;
+  layer moving_;
+  std::vector<uint32_t> movers_;
+  std::vector<uint8_t> is_mover_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif /* SRC_SPATIAL_GRID_H_ */
@@ -0,0 +1,235 @@
+/**
+ * @file state_export.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/state_export.h"
+#include <string.h>
+#include <sys/mman.h>
+#include <algorithm>
+#include "src/arena.h"
+#include "src/shared_memory.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constant Definitions
+ ******************************************************************************/
+// Slots start on their own cache lines
+static const size_t kSlotAlign = 64;
+// Times a reader starts over on a frame overwritten under it
+static const int kReadTries = 8;
+
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t) &&
+              ATOMIC_LLONG_LOCK_FREE == 2,
+              "the shared counters must be plain lock-free words");
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+static size_t AlignUp(size_t n) {
+  return (n + kSlotAlign - 1) / kSlotAlign * kSlotAlign;
+} /* AlignUp() */
+
+static size_t FirstSlot(void) {
+  return AlignUp(sizeof(state_export_header));
+} /* FirstSlot() */
+
+/**
+ * @brief Where in the mapping the slot for frame starts.
+ */
+static size_t SlotOffset(const state_export_header * hdr, uint64_t frame) {
+  return FirstSlot() + (frame % hdr->n_slots) * hdr->slot_size;
+} /* SlotOffset() */
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+StateExporter::StateExporter(void) : name_(), mapping_(nullptr),
+                                     mapping_size_(0), header_(nullptr),
+                                     next_frame_(0) {}
+
+StateExporter::~StateExporter(void) { Close(); }
+
+StateReader::StateReader(void) : mapping_(nullptr), mapping_size_(0),
+                                 header_(nullptr) {}
+
+StateReader::~StateReader(void) { Detach(); }
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+bool StateExporter::Open(const char * name, uint32_t n_slots,
+                         uint32_t max_entities, double x_dim, double y_dim,
+                         std::string * error) {
+  Close();
+  if (n_slots == 0) {
+    return ShmFail(error, name, "no slots");
+  }
+  size_t slot_size = AlignUp(sizeof(state_frame_header) +
+                             max_entities * sizeof(state_entity));
+  size_t size = FirstSlot() + n_slots * slot_size;
+  // A fresh object, so readers still attached to an old one keep theirs
+  void * p = CreateShared(name, size, 0644, error);
+  if (!p) {
+    return false;
+  }
+  // The new memory is zero, so every slot's count starts even; the header
+  // is filled in before latest says there is anything to read
+  header_ = static_cast<state_export_header *>(p);
+  memcpy(header_->magic, STATE_EXPORT_MAGIC, sizeof(header_->magic));
+  header_->version = STATE_EXPORT_VERSION;
+  header_->n_slots = n_slots;
+  header_->max_entities = max_entities;
+  header_->slot_size = slot_size;
+  header_->x_dim = x_dim;
+  header_->y_dim = y_dim;
+  header_->latest.store(0, std::memory_order_release);
+  name_ = name;
+  mapping_ = p;
+  mapping_size_ = size;
+  next_frame_ = 0;
+  return true;
+} /* Open() */
+
+void StateExporter::Close(void) {
+  if (mapping_) {
+    munmap(mapping_, mapping_size_);
+    shm_unlink(name_.c_str());
+  }
+  mapping_ = nullptr;
+  mapping_size_ = 0;
+  header_ = nullptr;
+  name_.clear();
+} /* Close() */
+
+void StateExporter::Publish(const Arena& arena, uint64_t step) {
+  uint64_t frame = next_frame_++;
+  state_frame_header * slot = reinterpret_cast<state_frame_header *>(
+      static_cast<char *>(mapping_) + SlotOffset(header_, frame));
+  uint64_t seq = slot->seq.load(std::memory_order_relaxed);
+  slot->seq.store(seq + 1, std::memory_order_relaxed);
+  // Readers that see any of what follows see the count odd
+  std::atomic_thread_fence(std::memory_order_release);
+
+  const Registry& registry = arena.registry();
+  const ComponentPool<transform>& bodies = registry.transform_pool();
+  const ComponentPool<kinematics>& movers = registry.kinematics_pool();
+  const ComponentPool<renderable>& looks = registry.renderable_pool();
+  size_t n = std::min<size_t>(bodies.size(), header_->max_entities);
+  state_entity * out = reinterpret_cast<state_entity *>(slot + 1);
+  for (size_t i = 0; i < n; ++i) {
+    entity_id e = bodies.owners()[i];
+    const transform& xf = bodies.data()[i];
+    state_entity& s = out[i];
+    s.id = e;
+    s.kind = registry.kind(e);
+    s.x = RealToDouble(xf.pos.x);
+    s.y = RealToDouble(xf.pos.y);
+    s.radius = RealToDouble(xf.radius);
+    s.heading_x = s.heading_y = 0;
+    if (movers.Has(e)) {
+      const Vector2& heading = movers.Get(e).motion.direction();
+      s.heading_x = RealToDouble(heading.x);
+      s.heading_y = RealToDouble(heading.y);
+    }
+    s.r = s.g = s.b = s.a = 0;
+    if (looks.Has(e)) {
+      const Color& c = looks.Get(e).color;
+      s.r = static_cast<uint8_t>(c.r);
+      s.g = static_cast<uint8_t>(c.g);
+      s.b = static_cast<uint8_t>(c.b);
+      s.a = static_cast<uint8_t>(c.a);
+    }
+    s.reserved = 0;
+  } /* for(i..) */
+  slot->frame = frame;
+  slot->step = step;
+  slot->n_entities = static_cast<uint32_t>(n);
+  slot->n_total = static_cast<uint32_t>(bodies.size());
+  slot->game_over = arena.getGameStatus() ? 1 : 0;
+
+  slot->seq.store(seq + 2, std::memory_order_release);
+  header_->latest.store(frame + 1, std::memory_order_release);
+} /* Publish() */
+
+bool StateReader::Attach(const char * name, std::string * error) {
+  Detach();
+  size_t size = 0;
+  void * p = AttachShared(name, false, FirstSlot(), "truncated header", &size,
+                          error);
+  if (!p) {
+    return false;
+  }
+  const state_export_header * hdr =
+      static_cast<const state_export_header *>(p);
+  const char * reason = nullptr;
+  if (memcmp(hdr->magic, STATE_EXPORT_MAGIC, sizeof(hdr->magic)) != 0) {
+    reason = "not a state export";
+  } else if (hdr->version != STATE_EXPORT_VERSION) {
+    reason = "unsupported state export version";
+  } else if (hdr->n_slots == 0 || hdr->slot_size <
+             sizeof(state_frame_header) + hdr->max_entities *
+             sizeof(state_entity) ||
+             FirstSlot() + hdr->n_slots * hdr->slot_size > size) {
+    reason = "truncated or corrupt state export";
+  }
+  if (reason) {
+    munmap(p, size);
+    return ShmFail(error, name, reason);
+  }
+  mapping_ = p;
+  mapping_size_ = size;
+  header_ = hdr;
+  return true;
+} /* Attach() */
+
+void StateReader::Detach(void) {
+  if (mapping_) {
+    munmap(mapping_, mapping_size_);
+  }
+  mapping_ = nullptr;
+  mapping_size_ = 0;
+  header_ = nullptr;
+} /* Detach() */
+
+bool StateReader::ReadLatest(struct state_frame * out) const {
+  for (int attempt = 0; attempt < kReadTries; ++attempt) {
+    uint64_t latest = header_->latest.load(std::memory_order_acquire);
+    if (latest == 0) {
+      return false;
+    }
+    const state_frame_header * slot =
+        reinterpret_cast<const state_frame_header *>(
+            static_cast<const char *>(mapping_) +
+            SlotOffset(header_, latest - 1));
+    uint64_t before = slot->seq.load(std::memory_order_acquire);
+    if (before & 1) {
+      continue;
+    }
+    uint64_t frame = slot->frame;
+    uint32_t n = std::min(slot->n_entities, header_->max_entities);
+    out->step = slot->step;
+    out->n_total = slot->n_total;
+    out->game_over = slot->game_over != 0;
+    out->entities.resize(n);
+    memcpy(out->entities.data(), slot + 1, n * sizeof(state_entity));
+    // What was copied was all written before the count is read again
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot->seq.load(std::memory_order_relaxed) == before &&
+        frame == latest - 1) {
+      out->frame = frame;
+      return true;
+    }
+  } /* for(attempt..) */
+  return false;
+} /* ReadLatest() */
+
+NAMESPACE_END(csci3081);
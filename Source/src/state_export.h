@@ -0,0 +1,179 @@
+/**
+ * @file state_export.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_STATE_EXPORT_H_
+#define SRC_STATE_EXPORT_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include <atomic>
+#include <string>
+#include <vector>
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constant Definitions
+ ******************************************************************************/
+#define STATE_EXPORT_MAGIC "ARSX"
+#define STATE_EXPORT_VERSION 1
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief Start of a state export's shared memory. It is followed, from the
+ * next multiple of 64 bytes, by n_slots frames of slot_size bytes each.
+ */
+struct state_export_header {
+  char magic[4];
+  uint32_t version;
+  uint32_t n_slots;
+  uint32_t max_entities;
+  uint64_t slot_size;
+  double x_dim;
+  double y_dim;
+  // How many frames have been published; the newest is frame latest - 1,
+  // in slot (latest - 1) % n_slots
+  std::atomic<uint64_t> latest;
+};
+
+/**
+ * @brief Start of one slot, followed by n_entities state_entity records.
+ */
+struct state_frame_header {
+  // Odd while the exporter is writing the slot, bumped twice per frame
+  std::atomic<uint64_t> seq;
+  uint64_t frame;
+  // What the exporter was told, e.g. the step number
+  uint64_t step;
+  uint32_t n_entities;
+  // How many entities the arena had; more than n_entities if some did not
+  // fit in max_entities
+  uint32_t n_total;
+  uint32_t game_over;
+  uint32_t reserved;
+};
+
+/**
+ * @brief One entity of a frame. Entities that do not move have a zero
+ * heading.
+ */
+struct state_entity {
+  uint32_t id;
+  uint32_t kind;
+  double x;
+  double y;
+  double radius;
+  double heading_x;
+  double heading_y;
+  uint8_t r, g, b, a;
+  uint32_t reserved;
+};
+
+/**
+ * @brief A frame as a reader copied it out.
+ */
+struct state_frame {
+  state_frame(void) : frame(0), step(0), n_total(0), game_over(false),
+                      entities() {}
+
+  uint64_t frame;
+  uint64_t step;
+  uint32_t n_total;
+  bool game_over;
+  std::vector<state_entity> entities;
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+class Arena;
+
+/**
+ * @brief Publishes an arena's state, frame by frame, into a POSIX shared
+ * memory ring for processes that watch the simulation.
+ *
+ * Each slot of the ring is guarded by a sequence lock: the exporter makes
+ * its count odd, writes the frame and makes it even again, and a reader
+ * keeps a copy only if the count was the same even number before and
+ * after. Nothing waits on anyone: the exporter never learns of readers,
+ * any number of them can attach and detach, and a reader that falls more
+ * than a ring behind just sees newer frames.
+ *
+ * The exporter owns the name, and removes it when closed; readers still
+ * attached keep their mapping until they detach.
+ */
+class StateExporter {
+ public:
+  StateExporter(void);
+  ~StateExporter(void);
+
+  /**
+   * @brief Create the shared memory, e.g. "/arena-0". Frames hold up to
+   * max_entities entities; further ones are left out.
+   */
+  bool Open(const char * name, uint32_t n_slots, uint32_t max_entities,
+            double x_dim, double y_dim, std::string * error);
+  void Close(void);
+  bool opened(void) const { return header_ != nullptr; }
+
+  /**
+   * @brief Write the arena as it is now into the next slot.
+   */
+  void Publish(const Arena& arena, uint64_t step);
+
+ private:
+  StateExporter& operator=(const StateExporter& other) = delete;
+  StateExporter(const StateExporter& other) = delete;
+
+  std::string name_;
+  void * mapping_;
+  size_t mapping_size_;
+  state_export_header * header_;
+  uint64_t next_frame_;
+};
+
+/**
+ * @brief Reads the frames of a StateExporter from another process (or
+ * the same one).
+ */
+class StateReader {
+ public:
+  StateReader(void);
+  ~StateReader(void);
+
+  bool Attach(const char * name, std::string * error);
+  void Detach(void);
+  bool attached(void) const { return header_ != nullptr; }
+  const state_export_header * header(void) const { return header_; }
+
+  /**
+   * @brief Copy out the newest frame.
+   *
+   * @return false if none has been published yet, or the exporter kept
+   * overwriting the frame being read (try again later).
+   */
+  bool ReadLatest(struct state_frame * out) const;
+
+ private:
+  StateReader& operator=(const StateReader& other) = delete;
+  StateReader(const StateReader& other) = delete;
+
+  void * mapping_;
+  size_t mapping_size_;
+  const state_export_header * header_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_STATE_EXPORT_H_
@@ -0,0 +1,220 @@
+/**
+ * @file static_map.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/static_map.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <cmath>
+#include "src/shared_memory.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constant Definitions
+ ******************************************************************************/
+// Obstacles per grid cell aimed for when sizing the grid
+static const double kPerCell = 2.0;
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+static uint64_t Align8(uint64_t n) {
+  return (n + 7) & ~static_cast<uint64_t>(7);
+} /* Align8() */
+
+/**
+ * @brief Whether the count items of item_size bytes at offset lie within
+ * the size bytes of an image, and are aligned for their doubles, without
+ * overflowing on the way.
+ */
+static bool FitsIn(uint64_t size, uint64_t offset, uint64_t count,
+                   uint64_t item_size) {
+  return offset % 8 == 0 && offset <= size &&
+      count <= (size - offset) / item_size;
+} /* FitsIn() */
+
+/**
+ * @brief Why the size byte image starting with hdr cannot be used as a map
+ * (after its magic and version), or nullptr if it can.
+ */
+static const char * CheckImage(const static_map_header * hdr, size_t size) {
+  const char * corrupt = "truncated or corrupt map";
+  uint64_t n_cells = static_cast<uint64_t>(hdr->cols) * hdr->rows;
+  if (hdr->image_size != size || hdr->cols == 0 || hdr->rows == 0 ||
+      !std::isfinite(hdr->cell_size) || hdr->cell_size <= 0 ||
+      !std::isfinite(hdr->max_radius) || hdr->max_radius < 0 ||
+      hdr->obstacles_offset < sizeof(static_map_header) ||
+      !FitsIn(size, hdr->obstacles_offset, hdr->n_obstacles,
+              sizeof(static_obstacle)) ||
+      hdr->cell_start_offset < hdr->obstacles_offset +
+          hdr->n_obstacles * sizeof(static_obstacle) ||
+      !FitsIn(size, hdr->cell_start_offset, n_cells + 1, sizeof(uint32_t))) {
+    return corrupt;
+  }
+  // Queries run from start[c] to start[c + 1] unchecked
+  const uint32_t * start = reinterpret_cast<const uint32_t *>(
+      reinterpret_cast<const char *>(hdr) + hdr->cell_start_offset);
+  for (uint64_t c = 0; c < n_cells; ++c) {
+    if (start[c] > start[c + 1]) {
+      return corrupt;
+    }
+  } /* for(c..) */
+  return start[n_cells] <= hdr->n_obstacles ? nullptr : corrupt;
+} /* CheckImage() */
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+StaticMap::StaticMap(void) :
+    owned_(), mapping_(nullptr), mapping_size_(0), header_(nullptr),
+    obstacles_(nullptr), cell_start_(nullptr) {}
+
+StaticMap::~StaticMap(void) { Close(); }
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void StaticMap::Build(const std::vector<arena_entity_params>& obstacles,
+                      uint x_dim, uint y_dim) {
+  Close();
+  size_t n = obstacles.size();
+  double max_radius = 0;
+  for (const arena_entity_params& o : obstacles) {
+    max_radius = std::max(max_radius, o.radius);
+  } /* for(o..) */
+
+  // Cells no smaller than the largest obstacle, so a query only ever reaches
+  // one cell further out because of it
+  double extent = std::max(std::max(x_dim, y_dim), 1u);
+  double cell = n ? std::sqrt(static_cast<double>(x_dim) * y_dim * kPerCell /
+                              n) : extent;
+  cell = std::min(std::max(cell, std::max(max_radius, 1.0)), extent);
+  uint32_t cols = std::max(1u, static_cast<uint32_t>(std::ceil(x_dim / cell)));
+  uint32_t rows = std::max(1u, static_cast<uint32_t>(std::ceil(y_dim / cell)));
+  size_t n_cells = static_cast<size_t>(cols) * rows;
+
+  uint64_t obstacles_offset = Align8(sizeof(static_map_header));
+  uint64_t cell_start_offset = obstacles_offset + n * sizeof(static_obstacle);
+  uint64_t image_size = Align8(cell_start_offset +
+                               (n_cells + 1) * sizeof(uint32_t));
+  owned_.assign(image_size / sizeof(uint64_t), 0);
+  char * image = reinterpret_cast<char *>(owned_.data());
+
+  static_map_header * hdr = reinterpret_cast<static_map_header *>(image);
+  memcpy(hdr->magic, STATIC_MAP_MAGIC, sizeof(hdr->magic));
+  hdr->version = STATIC_MAP_VERSION;
+  hdr->image_size = image_size;
+  hdr->x_dim = x_dim;
+  hdr->y_dim = y_dim;
+  hdr->n_obstacles = n;
+  hdr->max_radius = max_radius;
+  hdr->cell_size = cell;
+  hdr->cols = cols;
+  hdr->rows = rows;
+  hdr->obstacles_offset = obstacles_offset;
+  hdr->cell_start_offset = cell_start_offset;
+
+  // Counting sort of the obstacles by cell
+  static_obstacle * out =
+      reinterpret_cast<static_obstacle *>(image + obstacles_offset);
+  uint32_t * start = reinterpret_cast<uint32_t *>(image + cell_start_offset);
+  std::vector<uint32_t> cell_of(n);
+  for (size_t i = 0; i < n; ++i) {
+    double x = RealToDouble(obstacles[i].pos.x);
+    double y = RealToDouble(obstacles[i].pos.y);
+    cell_of[i] = Clamp(y / cell, rows) * cols + Clamp(x / cell, cols);
+    ++start[cell_of[i] + 1];
+  } /* for(i..) */
+  for (size_t c = 0; c < n_cells; ++c) {
+    start[c + 1] += start[c];
+  } /* for(c..) */
+  std::vector<uint32_t> fill(start, start + n_cells);
+  for (size_t i = 0; i < n; ++i) {
+    const arena_entity_params& o = obstacles[i];
+    static_obstacle& s = out[fill[cell_of[i]]++];
+    s.x = RealToDouble(o.pos.x);
+    s.y = RealToDouble(o.pos.y);
+    s.radius = o.radius;
+    s.r = o.color.r;
+    s.g = o.color.g;
+    s.b = o.color.b;
+    s.a = o.color.a;
+  } /* for(i..) */
+  Attach(image);
+} /* Build() */
+
+bool StaticMap::Save(const char * path, std::string * error) const {
+  if (!loaded()) {
+    return ShmFail(error, path, "no map to save");
+  }
+  FILE * f = fopen(path, "wb");
+  if (!f) {
+    return ShmFail(error, path, strerror(errno));
+  }
+  fwrite(header_, header_->image_size, 1, f);
+  bool ok = !ferror(f);
+  if (fclose(f) != 0 || !ok) {
+    return ShmFail(error, path, "write error");
+  }
+  return true;
+} /* Save() */
+
+bool StaticMap::Open(const char * path, std::string * error) {
+  Close();
+  size_t size = 0;
+  void * p = MapFile(path, sizeof(static_map_header), "truncated header",
+                     &size, error);
+  if (!p) {
+    return false;
+  }
+  const static_map_header * hdr = static_cast<const static_map_header *>(p);
+  const char * reason = nullptr;
+  if (memcmp(hdr->magic, STATIC_MAP_MAGIC, sizeof(hdr->magic)) != 0) {
+    reason = "not a static map";
+  } else if (hdr->version != STATIC_MAP_VERSION) {
+    reason = "unsupported static map version";
+  } else {
+    reason = CheckImage(hdr, size);
+  }
+  if (reason) {
+    munmap(p, size);
+    return ShmFail(error, path, reason);
+  }
+  mapping_ = p;
+  mapping_size_ = size;
+  Attach(static_cast<const char *>(p));
+  return true;
+} /* Open() */
+
+void StaticMap::Close(void) {
+  if (mapping_) {
+    munmap(mapping_, mapping_size_);
+  }
+  mapping_ = nullptr;
+  mapping_size_ = 0;
+  owned_.clear();
+  header_ = nullptr;
+  obstacles_ = nullptr;
+  cell_start_ = nullptr;
+} /* Close() */
+
+void StaticMap::Attach(const char * image) {
+  header_ = reinterpret_cast<const static_map_header *>(image);
+  obstacles_ = reinterpret_cast<const static_obstacle *>(
+      image + header_->obstacles_offset);
+  cell_start_ = reinterpret_cast<const uint32_t *>(
+      image + header_->cell_start_offset);
+} /* Attach() */
+
+NAMESPACE_END(csci3081);
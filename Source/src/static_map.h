@@ -0,0 +1,158 @@
+/**
+ * @file static_map.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_STATIC_MAP_H_
+#define SRC_STATIC_MAP_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "src/common.h"
+#include "src/arena_entity_params.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constant Definitions
+ ******************************************************************************/
+#define STATIC_MAP_MAGIC "ARSM"
+#define STATIC_MAP_VERSION 1
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief Start of a static map image. Offsets are from the start of the
+ * image, so it can be mapped at any address.
+ */
+struct static_map_header {
+  char magic[4];
+  uint32_t version;
+  uint64_t image_size;
+  uint32_t x_dim;
+  uint32_t y_dim;
+  uint64_t n_obstacles;
+  double max_radius;
+  // Uniform grid over [0, x_dim) x [0, y_dim)
+  double cell_size;
+  uint32_t cols;
+  uint32_t rows;
+  // static_obstacle[n_obstacles], sorted by the grid cell of their centers
+  uint64_t obstacles_offset;
+  // uint32_t[cols * rows + 1]: cell c holds obstacles [start[c], start[c+1])
+  uint64_t cell_start_offset;
+};
+
+struct static_obstacle {
+  double x;
+  double y;
+  double radius;
+  uint8_t r, g, b, a;
+  uint32_t reserved;
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Obstacles that never move, together with a grid over them, laid out
+ * as a single position-independent image.
+ *
+ * Build() makes the image in memory and Save() writes it out as is, which is
+ * the offline "compile map" step. Open() maps a saved image read-only, so
+ * startup costs the same whatever the size of the map, and every process
+ * that opens the same file shares one copy of it in the page cache.
+ *
+ * The obstacles are not entities: the Arena checks its mobile entities
+ * against them through the grid, and the viewer draws them from here.
+ */
+class StaticMap {
+ public:
+  StaticMap(void);
+  ~StaticMap(void);
+
+  /**
+   * @brief Lay out obstacles and their grid in memory.
+   */
+  void Build(const std::vector<arena_entity_params>& obstacles, uint x_dim,
+             uint y_dim);
+
+  bool Save(const char * path, std::string * error) const;
+
+  /**
+   * @brief Map a saved image read-only. The header and the grid's cell
+   * table are checked, so that no query can read outside the image; the
+   * obstacles themselves are not, so that opening does not touch their
+   * pages.
+   */
+  bool Open(const char * path, std::string * error);
+
+  /**
+   * @brief Drop the image, unmapping it if it was opened.
+   */
+  void Close(void);
+
+  bool loaded(void) const { return header_ != nullptr; }
+  uint x_dim(void) const { return header_->x_dim; }
+  uint y_dim(void) const { return header_->y_dim; }
+  size_t size(void) const { return loaded() ? header_->n_obstacles : 0; }
+  const static_obstacle * obstacles(void) const { return obstacles_; }
+
+  /**
+   * @brief Call f(const static_obstacle&) for every obstacle that may
+   * overlap the box [x0, x1] x [y0, y1], i.e. those whose centers lie in
+   * grid cells within max_radius of it.
+   */
+  template <typename F>
+  void ForEachInBox(double x0, double y0, double x1, double y1,
+                    F f) const {
+    if (!loaded() || header_->n_obstacles == 0) {
+      return;
+    }
+    double pad = header_->max_radius;
+    double inv = 1.0 / header_->cell_size;
+    int c0 = Clamp((x0 - pad) * inv, header_->cols);
+    int c1 = Clamp((x1 + pad) * inv, header_->cols);
+    int r0 = Clamp((y0 - pad) * inv, header_->rows);
+    int r1 = Clamp((y1 + pad) * inv, header_->rows);
+    for (int row = r0; row <= r1; ++row) {
+      // The cells of a row are adjacent, so each row is one run
+      const uint32_t * start = &cell_start_[row * header_->cols];
+      for (uint32_t i = start[c0]; i < start[c1 + 1]; ++i) {
+        f(obstacles_[i]);
+      } /* for(i..) */
+    } /* for(row..) */
+  }
+
+ private:
+  StaticMap(const StaticMap& other) = delete;
+  StaticMap& operator=(const StaticMap& other) = delete;
+
+  static int Clamp(double cell, uint32_t n) {
+    return static_cast<int>(std::min(std::max(std::floor(cell), 0.0),
+                                     static_cast<double>(n - 1)));
+  }
+  void Attach(const char * image);
+
+  std::vector<uint64_t> owned_;   // image made by Build()
+  void * mapping_;                // image mapped by Open()
+  size_t mapping_size_;
+  const static_map_header * header_;
+  const static_obstacle * obstacles_;
+  const uint32_t * cell_start_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif /* SRC_STATIC_MAP_H_ */
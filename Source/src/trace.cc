@@ -0,0 +1,161 @@
+/**
+ * @file trace.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/trace.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <chrono>
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Static Variables
+ ******************************************************************************/
+// Cached per-thread buffer so Record() only takes the lock the first time a
+// thread traces something.
+static thread_local void * tls_trace_buffer = nullptr;
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+Tracer& Tracer::Instance(void) {
+  static Tracer tracer;
+  return tracer;
+} /* Instance() */
+
+uint64_t Tracer::NowNs(void) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+} /* NowNs() */
+
+Tracer::thread_buffer * Tracer::LocalBuffer(void) {
+  if (tls_trace_buffer) {
+    return static_cast<thread_buffer*>(tls_trace_buffer);
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  buffers_.push_back(std::unique_ptr<thread_buffer>(
+      new thread_buffer(static_cast<uint32_t>(buffers_.size() + 1))));
+  tls_trace_buffer = buffers_.back().get();
+  return buffers_.back().get();
+} /* LocalBuffer() */
+
+/**
+* @brief Store the span in the calling thread's ring buffer. Once the ring is
+* full the oldest spans are overwritten, so a long session keeps its most
+* recent history.
+*/
+void Tracer::Record(const char * name, const char * category,
+                    uint64_t begin_ticks, uint64_t end_ticks) {
+  thread_buffer * buf = LocalBuffer();
+  uint64_t count = buf->count.load(std::memory_order_relaxed);
+  struct trace_event& ev = buf->events[count % TRACE_BUFFER_CAPACITY];
+  ev.name = name;
+  ev.category = category;
+  ev.begin_ticks = begin_ticks;
+  ev.end_ticks = end_ticks;
+  buf->count.store(count + 1, std::memory_order_release);
+} /* Record() */
+
+void Tracer::ThreadName(const std::string& name) {
+  thread_buffer * buf = LocalBuffer();
+  std::lock_guard<std::mutex> lock(mutex_);
+  buf->name = name;
+} /* ThreadName() */
+
+size_t Tracer::n_events(void) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t n = 0;
+  for (auto& buf : buffers_) {
+    uint64_t count = buf->count.load(std::memory_order_acquire);
+    n += count < TRACE_BUFFER_CAPACITY ? count : TRACE_BUFFER_CAPACITY;
+  } /* for(buf..) */
+  return n;
+} /* n_events() */
+
+void Tracer::Clear(void) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& buf : buffers_) {
+    buf->count.store(0, std::memory_order_release);
+  } /* for(buf..) */
+} /* Clear() */
+
+/**
+ * @brief Write s as the contents of a JSON string, escaping quotes,
+ * backslashes and control characters.
+ */
+static void WriteJsonString(FILE * fp, const char * s) {
+  for (; *s; ++s) {
+    unsigned char c = static_cast<unsigned char>(*s);
+    if (c == '"' || c == '\\') {
+      fprintf(fp, "\\%c", c);
+    } else if (c < 0x20) {
+      fprintf(fp, "\\u%04x", c);
+    } else {
+      fputc(c, fp);
+    }
+  } /* for(s..) */
+} /* WriteJsonString() */
+
+/**
+* @brief Write every buffered span as a complete ("X") event, plus one
+* thread_name metadata event per named thread. Timestamps are microseconds
+* relative to the creation of the Tracer, as the format expects; the tick rate
+* is calibrated against the steady clock over the Tracer's lifetime.
+*/
+bool Tracer::Dump(const std::string& path) {
+  FILE * fp = fopen(path.c_str(), "w");
+  if (!fp) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  uint64_t elapsed_ticks = NowTicks() - epoch_ticks_;
+  double us_per_tick = elapsed_ticks ?
+      (NowNs() - epoch_ns_) / 1000.0 / elapsed_ticks : 0.0;
+  int pid = static_cast<int>(getpid());
+  bool first = true;
+  fprintf(fp, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+  for (auto& buf : buffers_) {
+    if (!buf->name.empty()) {
+      fprintf(fp, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,"
+              "\"tid\":%u,\"args\":{\"name\":\"", first ? "" : ",", pid,
+              buf->tid);
+      WriteJsonString(fp, buf->name.c_str());
+      fprintf(fp, "\"}}");
+      first = false;
+    }
+    uint64_t count = buf->count.load(std::memory_order_acquire);
+    uint64_t n = count < TRACE_BUFFER_CAPACITY ? count :
+        TRACE_BUFFER_CAPACITY;
+    for (uint64_t i = count - n; i < count; ++i) {
+      const struct trace_event& ev = buf->events[i % TRACE_BUFFER_CAPACITY];
+      fprintf(fp, "%s\n{\"name\":\"", first ? "" : ",");
+      WriteJsonString(fp, ev.name);
+      fprintf(fp, "\",\"cat\":\"");
+      WriteJsonString(fp, ev.category);
+      fprintf(fp, "\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,"
+              "\"tid\":%u}",
+              static_cast<int64_t>(ev.begin_ticks - epoch_ticks_) * us_per_tick,
+              (ev.end_ticks - ev.begin_ticks) * us_per_tick, pid, buf->tid);
+      first = false;
+    } /* for(i..) */
+    // Recording into the buffer while it was read may have torn what was
+    // written out
+    assert(buf->count.load(std::memory_order_relaxed) == count &&
+           "Tracer::Dump() while recording");
+  } /* for(buf..) */
+  fprintf(fp, "\n]}\n");
+  return fclose(fp) == 0;
+} /* Dump() */
+
+NAMESPACE_END(csci3081);
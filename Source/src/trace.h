@@ -0,0 +1,196 @@
+/**
+ * @file trace.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_TRACE_H_
+#define SRC_TRACE_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constant Definitions
+ ******************************************************************************/
+/**
+ * @brief Number of spans each thread can hold before the oldest ones are
+ * overwritten.
+ */
+#define TRACE_BUFFER_CAPACITY (1 << 16)
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief One completed span. Name and category must be string literals (or
+ * otherwise outlive the Tracer), since only the pointers are stored.
+ */
+struct trace_event {
+  const char * name;
+  const char * category;
+  uint64_t begin_ticks;
+  uint64_t end_ticks;
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Records begin/end spans from any thread and writes them out in the
+ * Chrome trace-event JSON format, which can be loaded in chrome://tracing or
+ * https://ui.perfetto.dev.
+ *
+ * Each thread writes into its own preallocated ring buffer, so recording a
+ * span takes no lock and does no allocation. Spans are stamped with the raw
+ * time-stamp counter where available and only converted to wall time in
+ * Dump(), which keeps a span under 50ns. Buffers are owned by the Tracer
+ * and outlive their threads.
+ *
+ * Since nothing stops a thread from recording while its buffer is read,
+ * Clear() and Dump() must only be called once every traced thread has
+ * stopped recording: it has exited, or has closed its last span and will
+ * open no more (e.g. after the viewer's main loop has returned). Dump()
+ * asserts that no span was recorded while it ran.
+ */
+class Tracer {
+ public:
+  /**
+   * @brief Get the process-wide tracer.
+   */
+  static Tracer& Instance(void);
+
+  /**
+   * @brief Current time on the steady clock, in nanoseconds.
+   */
+  static uint64_t NowNs(void);
+
+  /**
+   * @brief Current value of the cheap clock used to stamp spans.
+   */
+  static uint64_t NowTicks(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return NowNs();
+#endif
+  }
+
+  bool enabled(void) const {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+  void enabled(bool e) { enabled_.store(e, std::memory_order_relaxed); }
+
+  /**
+   * @brief Append a completed span to the calling thread's buffer.
+   */
+  void Record(const char * name, const char * category,
+              uint64_t begin_ticks, uint64_t end_ticks);
+
+  /**
+   * @brief Label the calling thread in the exported trace.
+   */
+  void ThreadName(const std::string& name);
+
+  /**
+   * @brief Number of spans currently held across all threads.
+   */
+  size_t n_events(void);
+
+  /**
+   * @brief Drop all recorded spans (thread registrations are kept). Only
+   * while no thread is recording.
+   */
+  void Clear(void);
+
+  /**
+   * @brief Write all recorded spans to a Chrome trace JSON file. Only once
+   * no thread is recording.
+   *
+   * @return false if the file could not be written.
+   */
+  bool Dump(const std::string& path);
+
+ private:
+  struct thread_buffer {
+    explicit thread_buffer(uint32_t in_tid)
+        : tid(in_tid), count(0), name(), events(TRACE_BUFFER_CAPACITY) {}
+    uint32_t tid;
+    // Spans ever recorded; stored (release) by the owning thread only, after
+    // the span it counts, so whoever loads it (acquire) sees that span
+    std::atomic<uint64_t> count;
+    std::string name;
+    std::vector<struct trace_event> events;
+  };
+
+  Tracer(void) : enabled_(false), mutex_(), buffers_(),
+                 epoch_ns_(NowNs()), epoch_ticks_(NowTicks()) {}
+  thread_buffer * LocalBuffer(void);
+
+  Tracer& operator=(const Tracer& other) = delete;
+  Tracer(const Tracer& other) = delete;
+
+  std::atomic<bool> enabled_;
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<thread_buffer>> buffers_;
+  uint64_t epoch_ns_;
+  uint64_t epoch_ticks_;
+};
+
+/**
+ * @brief RAII helper that records a span covering its own lifetime. When
+ * tracing is disabled it costs a single relaxed load.
+ */
+class TraceScope {
+ public:
+  TraceScope(const char * name, const char * category)
+      : name_(name), category_(category),
+        begin_ticks_(Tracer::Instance().enabled() ? Tracer::NowTicks() : 0) {}
+  ~TraceScope(void) {
+    if (begin_ticks_) {
+      Tracer::Instance().Record(name_, category_, begin_ticks_,
+                                Tracer::NowTicks());
+    }
+  }
+
+ private:
+  TraceScope& operator=(const TraceScope& other) = delete;
+  TraceScope(const TraceScope& other) = delete;
+
+  const char * name_;
+  const char * category_;
+  uint64_t begin_ticks_;
+};
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+/**
+ * @brief Trace the rest of the enclosing scope under the given name and
+ * category (both string literals).
+ */
+#define TRACE_SCOPE(name, category) \
+  csci3081::TraceScope TRACE_CONCAT(trace_scope_, __LINE__)(name, category)
+
+NAMESPACE_END(csci3081);
+
+#endif /* SRC_TRACE_H_ */
@@ -0,0 +1,206 @@
+/**
+ * @file vec_arena.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/vec_arena.h"
+#include <time.h>
+#include <algorithm>
+#include "src/arena_params.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief Threads to step on: as asked, but no more than there are
+ * environments to share out.
+ */
+static size_t ThreadsFor(const struct vec_arena_params& vparams) {
+  size_t n_threads = vparams.n_threads;
+  if (n_threads == 0) {
+    n_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  return std::max<size_t>(1, std::min(n_threads, vparams.n_envs));
+} /* ThreadsFor() */
+
+void ObserveRobot(const Arena& arena, entity_id robot, float * observation) {
+  const Registry& registry = arena.registry();
+  double x_dim = RealToDouble(arena.x_dim());
+  double y_dim = RealToDouble(arena.y_dim());
+  const Position& pos = registry.transform_pool().Get(robot).pos;
+  double x = RealToDouble(pos.x);
+  double y = RealToDouble(pos.y);
+  const Position& home = arena.home_base()->get_pos();
+  const Position& station =
+      registry.transform_pool().Get(arena.recharge_stations()[0]).pos;
+  const RobotMotionHandler& motion =
+      registry.kinematics_pool().Get(robot).motion;
+  const RobotBattery& cell = registry.battery_pool().Get(robot).cell;
+  double max_speed = RealToDouble(motion.max_speed());
+  double max_charge = RealToDouble(cell.max_charge());
+
+  observation[OBS_ROBOT_X] = static_cast<float>(x / x_dim);
+  observation[OBS_ROBOT_Y] = static_cast<float>(y / y_dim);
+  observation[OBS_HEADING_X] =
+      static_cast<float>(RealToDouble(motion.direction().x));
+  observation[OBS_HEADING_Y] =
+      static_cast<float>(RealToDouble(motion.direction().y));
+  observation[OBS_SPEED] = static_cast<float>(
+      max_speed > 0 ? RealToDouble(motion.speed()) / max_speed : 0);
+  observation[OBS_BATTERY] = static_cast<float>(
+      max_charge > 0 ? RealToDouble(cell.level()) / max_charge : 0);
+  observation[OBS_HOME_DX] =
+      static_cast<float>((RealToDouble(home.x) - x) / x_dim);
+  observation[OBS_HOME_DY] =
+      static_cast<float>((RealToDouble(home.y) - y) / y_dim);
+  observation[OBS_RECHARGE_DX] =
+      static_cast<float>((RealToDouble(station.x) - x) / x_dim);
+  observation[OBS_RECHARGE_DY] =
+      static_cast<float>((RealToDouble(station.y) - y) / y_dim);
+  observation[OBS_TOUCHING] =
+      registry.touch_sensor_pool().Get(robot).activated() ? 1 : 0;
+} /* ObserveRobot() */
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+VecArena::VecArena(const struct arena_params * params,
+                   const struct vec_arena_params& vparams) :
+  vparams_(vparams), max_charge_(params->robot.battery_max_charge),
+  envs_(), actions_(nullptr), observations_(nullptr), rewards_(nullptr),
+  dones_(nullptr), patch_params_(nullptr), patches_(nullptr),
+  rasterizers_(),
+  pool_(ThreadsFor(vparams)) {
+  // Each HomeBase wanders its own way, from the seed given or, for 0, the
+  // time, plus the environment's index
+  struct arena_params env_params(*params);
+  unsigned base_seed = params->home_base.seed ?
+      params->home_base.seed : static_cast<unsigned>(time(NULL));
+  envs_.reserve(vparams.n_envs);
+  for (size_t i = 0; i < vparams.n_envs; ++i) {
+    unsigned seed = base_seed + static_cast<unsigned>(i);
+    env_params.home_base.seed = seed ? seed : 1;
+    std::unique_ptr<environment> e(new environment);
+    e->arena.reset(new Arena(&env_params));
+    environment * self = e.get();
+    e->arena->event_bus().game_overs().Subscribe(
+        [self](const game_over_record * events, size_t n) {
+          for (size_t j = 0; j < n; ++j) {
+            self->won = self->won || events[j].event.won();
+          } /* for(j..) */
+        });
+    envs_.push_back(std::move(e));
+  } /* for(i..) */
+  Resnapshot();
+  vparams_.n_threads = pool_.n_threads();
+  rasterizers_.resize(pool_.n_threads());
+}
+
+VecArena::~VecArena(void) {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void VecArena::Resnapshot(void) {
+  for (std::unique_ptr<environment>& e : envs_) {
+    e->arena->Snapshot(&e->start);
+    e->battery = RealToDouble(e->arena->robot()->get_battery_level());
+    e->steps = 0;
+  } /* for(e..) */
+} /* Resnapshot() */
+
+void VecArena::Observe(float * observations) {
+  for (size_t i = 0; i < envs_.size(); ++i) {
+    ObserveEnv(*envs_[i], observations + i * OBS_SIZE);
+  } /* for(i..) */
+} /* Observe() */
+
+void VecArena::ObserveEnv(const environment& e, float * observation) const {
+  ObserveRobot(*e.arena, e.arena->robot()->id(), observation);
+} /* ObserveEnv() */
+
+void VecArena::StepEnv(environment * e, const enum event_commands * actions,
+                       float * observation, float * reward,
+                       uint8_t * done) {
+  Arena& arena = *e->arena;
+  entity_id robot = arena.robot()->id();
+  for (size_t c = 0; c < vparams_.commands_per_step; ++c) {
+    arena.event_bus().commands().Push(
+        command_record {robot, EventCommand(actions[c])});
+  } /* for(c..) */
+  e->won = false;
+  arena.AdvanceTime();
+  ++e->steps;
+
+  double battery = RealToDouble(arena.robot()->get_battery_level());
+  if (arena.getGameStatus()) {
+    *reward = e->won ? 1.0f : -1.0f;
+    *done = DONE_GAME_OVER;
+  } else {
+    *reward = static_cast<float>((battery - e->battery) / max_charge_);
+    *done = (vparams_.max_episode_steps &&
+             e->steps >= vparams_.max_episode_steps) ?
+        DONE_TIME_LIMIT : DONE_NOT;
+  }
+  if (*done != DONE_NOT) {
+    arena.Restore(e->start);
+    battery = RealToDouble(arena.robot()->get_battery_level());
+    e->steps = 0;
+  }
+  e->battery = battery;
+  ObserveEnv(*e, observation);
+} /* StepEnv() */
+
+void VecArena::StepShare(size_t t) {
+  size_t n = envs_.size();
+  size_t begin = n * t / vparams_.n_threads;
+  size_t end = n * (t + 1) / vparams_.n_threads;
+  size_t k = vparams_.commands_per_step;
+  for (size_t i = begin; i < end; ++i) {
+    StepEnv(envs_[i].get(), actions_ + i * k, observations_ + i * OBS_SIZE,
+            rewards_ + i, dones_ + i);
+  } /* for(i..) */
+} /* StepShare() */
+
+void VecArena::PatchShare(size_t t) {
+  size_t n = envs_.size();
+  size_t begin = n * t / vparams_.n_threads;
+  size_t end = n * (t + 1) / vparams_.n_threads;
+  size_t per_env = envs_[0]->arena->n_robots() *
+      patch_params_->size * patch_params_->size;
+  for (size_t i = begin; i < end; ++i) {
+    rasterizers_[t].RenderAll(*envs_[i]->arena, *patch_params_,
+                              patches_ + i * per_env);
+  } /* for(i..) */
+} /* PatchShare() */
+
+void VecArena::Step(const enum event_commands * actions,
+                    float * observations, float * rewards, uint8_t * dones) {
+  actions_ = actions;
+  observations_ = observations;
+  rewards_ = rewards;
+  dones_ = dones;
+  RunOnThreads(&VecArena::StepShare);
+} /* Step() */
+
+void VecArena::RenderPatches(const struct patch_params& params,
+                             uint8_t * out) {
+  patch_params_ = &params;
+  patches_ = out;
+  RunOnThreads(&VecArena::PatchShare);
+} /* RenderPatches() */
+
+void VecArena::RunOnThreads(void (VecArena::*job)(size_t t)) {
+  pool_.Run([this, job](size_t t) { (this->*job)(t); });
+} /* RunOnThreads() */
+
+NAMESPACE_END(csci3081);
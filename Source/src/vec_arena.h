@@ -0,0 +1,226 @@
+/**
+ * @file vec_arena.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_VEC_ARENA_H_
+#define SRC_VEC_ARENA_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include <memory>
+#include <vector>
+#include "src/arena.h"
+#include "src/common.h"
+#include "src/event_commands.h"
+#include "src/occupancy_patch.h"
+#include "src/worker_pool.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Type Definitions
+ ******************************************************************************/
+/**
+ * @brief One environment's observation, as floats at these offsets.
+ * Positions are scaled by the arena's size, the speed by the robot's top
+ * speed and the battery by its full charge, so all lie in about [-1, 1].
+ */
+enum vec_arena_observation {
+  OBS_ROBOT_X,
+  OBS_ROBOT_Y,
+  OBS_HEADING_X,
+  OBS_HEADING_Y,
+  OBS_SPEED,
+  OBS_BATTERY,
+  // From the robot to the HomeBase and to the first recharge station
+  OBS_HOME_DX,
+  OBS_HOME_DY,
+  OBS_RECHARGE_DX,
+  OBS_RECHARGE_DY,
+  // 1 if the touch sensor went off this step
+  OBS_TOUCHING,
+  OBS_SIZE
+};
+
+/**
+ * @brief Why an environment's episode ended, in VecArena::Step()'s dones.
+ */
+enum vec_arena_done {
+  DONE_NOT = 0,
+  // The robot reached the HomeBase or ran out of battery
+  DONE_GAME_OVER = 1,
+  // The episode ran max_episode_steps without the game ending
+  DONE_TIME_LIMIT = 2
+};
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+struct vec_arena_params {
+  vec_arena_params(void) : n_envs(1), commands_per_step(1),
+                           max_episode_steps(0), n_threads(0) {}
+
+  size_t n_envs;
+  // Commands each environment takes per step, applied in order
+  size_t commands_per_step;
+  // Steps after which an episode is cut short; 0 for no limit
+  size_t max_episode_steps;
+  // Threads to step on, counting the caller's; 0 for one per core
+  size_t n_threads;
+};
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief Write the observation VecArena gives of a robot, any robot of the
+ * arena rather than only the player's.
+ *
+ * @param[out] observation Room for OBS_SIZE floats.
+ */
+void ObserveRobot(const Arena& arena, entity_id robot, float * observation);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Many copies of one arena stepped together, for learning a
+ * controller for the player's robot.
+ *
+ * Each step takes a command per environment and writes each one's
+ * observation, reward and done flag into the caller's contiguous buffers.
+ * An environment whose episode ends is put back to how it started, from a
+ * snapshot taken when it was built, within the same step.
+ *
+ * The environments are split among threads that live as long as the
+ * VecArena, each always stepping the same ones; after the first episode
+ * of each, stepping allocates nothing. The arenas narrate on stdout as they
+ * always do, which is best sent to /dev/null.
+ */
+class VecArena {
+ public:
+  /**
+   * @param[in] params What every environment is built from, except that
+   * environment i's HomeBase is seeded with params->home_base.seed + i (the
+   * time + i for a seed of 0), so that no two wander alike.
+   */
+  VecArena(const struct arena_params * params,
+           const struct vec_arena_params& vparams);
+  ~VecArena(void);
+
+  size_t n_envs(void) const { return envs_.size(); }
+  size_t commands_per_step(void) const { return vparams_.commands_per_step; }
+
+  /**
+   * @brief One environment, e.g. to enable avoidance or an autopilot for
+   * the other robots. Call Resnapshot() afterwards so that resets keep it.
+   */
+  Arena& env(size_t i) { return *envs_[i]->arena; }
+
+  /**
+   * @brief Take each environment as it is now as where its episodes start,
+   * and start a new one.
+   */
+  void Resnapshot(void);
+
+  /**
+   * @brief Write each environment's observation as it is now, e.g. the
+   * first of each episode before any Step().
+   *
+   * @param[out] observations Room for n_envs() * OBS_SIZE; environment i's
+   * start at observations + i * OBS_SIZE.
+   */
+  void Observe(float * observations);
+
+  /**
+   * @brief Step every environment once.
+   *
+   * @param[in] actions n_envs() * commands_per_step() commands; environment
+   * i's start at actions + i * commands_per_step(). COM_NONE does nothing.
+   * @param[out] observations As for Observe(). For an environment that was
+   * done this step, the first of its next episode.
+   * @param[out] rewards Room for n_envs(): 1 for reaching the HomeBase, -1
+   * for running out of battery, and otherwise the change in battery as a
+   * fraction of a full charge.
+   * @param[out] dones Room for n_envs() vec_arena_done values.
+   */
+  void Step(const enum event_commands * actions, float * observations,
+            float * rewards, uint8_t * dones);
+
+  /**
+   * @brief Render the occupancy patch of every robot in every environment,
+   * on the stepping threads. Every environment must have as many robots
+   * as the first.
+   *
+   * @param[out] out Room for n_envs() * env(0).n_robots() patches;
+   * environment i's robot j's starts at
+   * out + (i * env(0).n_robots() + j) * params.size * params.size.
+   */
+  void RenderPatches(const struct patch_params& params, uint8_t * out);
+
+ private:
+  /**
+   * @brief An arena, where its episodes start, and how its current one is
+   * going. Each lives in its own allocation, so threads stepping neighbors
+   * do not share cache lines.
+   */
+  struct environment {
+    environment(void) : arena(), start(), won(false), battery(0),
+                        steps(0) {}
+
+    std::unique_ptr<Arena> arena;
+    struct arena_snapshot start;
+    // Set by the game over subscriber during the step
+    bool won;
+    // Battery level at the end of the last step
+    double battery;
+    size_t steps;
+  };
+
+  void ObserveEnv(const environment& e, float * observation) const;
+  void StepEnv(environment * e, const enum event_commands * actions,
+               float * observation, float * reward, uint8_t * done);
+
+  /**
+   * @brief Run job on every thread and wait for them all.
+   */
+  void RunOnThreads(void (VecArena::*job)(size_t t));
+
+  /**
+   * @brief Thread t's environments, [n_envs() * t / n_threads,
+   * n_envs() * (t + 1) / n_threads), stepped or rendered for the current
+   * batch.
+   */
+  void StepShare(size_t t);
+  void PatchShare(size_t t);
+
+  VecArena& operator=(const VecArena& other) = delete;
+  VecArena(const VecArena& other) = delete;
+
+  struct vec_arena_params vparams_;
+  double max_charge_;
+  std::vector<std::unique_ptr<environment>> envs_;
+
+  // The batch being run, set before RunOnThreads()
+  const enum event_commands * actions_;
+  float * observations_;
+  float * rewards_;
+  uint8_t * dones_;
+  const struct patch_params * patch_params_;
+  uint8_t * patches_;
+  // One per thread
+  std::vector<PatchRasterizer> rasterizers_;
+  // Last, so that its threads stop before what they step goes
+  WorkerPool pool_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_VEC_ARENA_H_
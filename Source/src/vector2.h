@@ -0,0 +1,114 @@
+/**
+ * @file vector2.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_VECTOR2_H_
+#define SRC_VECTOR2_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/common.h"
+#include "src/numeric.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief A 2D vector, used for headings and contact directions so that motion
+ * and collision response never need trigonometry.
+ */
+struct Vector2 {
+  Vector2(void) : x(0), y(0) {}
+  Vector2(real_t in_x, real_t in_y) : x(in_x), y(in_y) {}
+
+  Vector2 operator+(const Vector2& o) const {
+    return Vector2(x + o.x, y + o.y);
+  }
+  Vector2 operator-(const Vector2& o) const {
+    return Vector2(x - o.x, y - o.y);
+  }
+  Vector2 operator-(void) const { return Vector2(-x, -y); }
+  Vector2 operator*(real_t s) const { return Vector2(x * s, y * s); }
+  real_t Dot(const Vector2& o) const { return x * o.x + y * o.y; }
+  real_t LengthSquared(void) const { return x * x + y * y; }
+
+  /**
+   * @brief Rotate by an angle given as its precomputed cosine and sine.
+   */
+  Vector2 Rotate(real_t c, real_t s) const {
+    return Vector2(x * c - y * s, x * s + y * c);
+  }
+
+  /**
+   * @brief Mirror this vector across a surface whose unit normal is n.
+   */
+  Vector2 Reflect(const Vector2& n) const { return *this - n * (2 * Dot(n)); }
+
+  /**
+   * @brief Rescale to unit length. Zero vectors are left unchanged.
+   */
+  Vector2 Normalized(void) const {
+    real_t len2 = LengthSquared();
+    return len2 > 0 ? *this * (real_t(1) / RealSqrt(len2)) : *this;
+  }
+
+  real_t x;
+  real_t y;
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief A unit direction vector with a degree view for the UI/API boundary.
+ *
+ * Simulation code reads and writes vector() only. Angles given to the
+ * constructor or degrees() setter are remembered exactly, and an angle for a
+ * vector produced by the simulation is computed lazily (in [0, 360)) the
+ * first time something asks for it, so trigonometry only runs when a caller
+ * outside the motion pipeline actually wants degrees.
+ */
+class Heading {
+ public:
+  Heading(void) : vector_(1, 0), degrees_(0), degrees_valid_(true) {}
+  explicit Heading(double degrees) : vector_(), degrees_(0),
+                                     degrees_valid_(true) {
+    this->degrees(degrees);
+  }
+
+  const Vector2& vector(void) const { return vector_; }
+  void vector(const Vector2& v) {
+    vector_ = v;
+    degrees_valid_ = false;
+  }
+
+  double degrees(void) const {
+    if (!degrees_valid_) {
+      degrees_ = RealToDouble(RealAtan2Deg(vector_.y, vector_.x));
+      degrees_valid_ = true;
+    }
+    return degrees_;
+  }
+  void degrees(double deg) {
+    vector_ = Vector2(RealCosDeg(deg), RealSinDeg(deg));
+    degrees_ = deg;
+    degrees_valid_ = true;
+  }
+
+ private:
+  Vector2 vector_;
+  mutable double degrees_;
+  mutable bool degrees_valid_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif /* SRC_VECTOR2_H_ */
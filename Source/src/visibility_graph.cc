@@ -0,0 +1,375 @@
+/**
+ * @file visibility_graph.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/visibility_graph.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constant Definitions
+ ******************************************************************************/
+// Segments may graze an obstacle by this fraction of its radius, so that the
+// sides of its own polygon, which touch it, count as clear
+static const double kGraze = 1e-9;
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief Bucket points into a grid of cols x rows cells of the given size, as
+ * start offsets per cell and the point indices in cell order.
+ */
+static void BucketPoints(const std::vector<double>& x,
+                         const std::vector<double>& y, double cell,
+                         uint32_t cols, uint32_t rows,
+                         std::vector<uint32_t> * start,
+                         std::vector<uint32_t> * items) {
+  size_t n_cells = static_cast<size_t>(cols) * rows;
+  start->assign(n_cells + 1, 0);
+  items->resize(x.size());
+  std::vector<uint32_t> cell_of(x.size());
+  for (size_t i = 0; i < x.size(); ++i) {
+    uint32_t c = std::min(cols - 1, static_cast<uint32_t>(
+        std::max(0.0, x[i] / cell)));
+    uint32_t r = std::min(rows - 1, static_cast<uint32_t>(
+        std::max(0.0, y[i] / cell)));
+    cell_of[i] = r * cols + c;
+    ++(*start)[cell_of[i] + 1];
+  } /* for(i..) */
+  for (size_t c = 0; c < n_cells; ++c) {
+    (*start)[c + 1] += (*start)[c];
+  } /* for(c..) */
+  std::vector<uint32_t> fill(start->begin(), start->end() - 1);
+  for (size_t i = 0; i < x.size(); ++i) {
+    (*items)[fill[cell_of[i]]++] = static_cast<uint32_t>(i);
+  } /* for(i..) */
+} /* BucketPoints() */
+
+/**
+ * @brief Whether the line from corner p toward q has both neighboring corners
+ * a and b on the same side. A shortest path only ever bends round a corner
+ * like that, so other edges can be left out of the graph.
+ */
+static bool Supporting(double px, double py, double qx, double qy, double ax,
+                       double ay, double bx, double by) {
+  double dx = qx - px;
+  double dy = qy - py;
+  double side_a = dx * (ay - py) - dy * (ax - px);
+  double side_b = dx * (by - py) - dy * (bx - px);
+  return side_a * side_b >= 0;
+} /* Supporting() */
+
+static uint32_t CellCount(double extent, double cell) {
+  return std::max(1u, static_cast<uint32_t>(std::ceil(extent / cell)));
+} /* CellCount() */
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+VisibilityGraph::VisibilityGraph(void) :
+  x_dim_(0), y_dim_(0), clearance_(0), max_edge_(0), circles_(),
+  circle_cell_(1), circle_cols_(1), circle_rows_(1), circle_start_(1, 0),
+  circle_items_(), max_inflated_(0), node_x_(), node_y_(), node_cell_(1),
+  node_cols_(1), node_rows_(1), node_start_(1, 0), node_items_(),
+  edge_start_(1, 0), adjacent_(), edge_length_() {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void VisibilityGraph::Build(const struct circle_batch& obstacles, uint x_dim,
+                            uint y_dim,
+                            const struct visibility_graph_params& params) {
+  x_dim_ = x_dim;
+  y_dim_ = y_dim;
+  clearance_ = params.clearance;
+  max_edge_ = params.max_edge;
+  size_t n = obstacles.size();
+
+  circles_.Clear();
+  max_inflated_ = 0;
+  for (size_t i = 0; i < n; ++i) {
+    circles_.Push(obstacles.x[i], obstacles.y[i],
+                  obstacles.r[i] + clearance_);
+    max_inflated_ = std::max(max_inflated_, circles_.r[i]);
+  } /* for(i..) */
+  double extent = std::max(std::max(x_dim_, y_dim_), 1.0);
+  circle_cell_ = n ? std::sqrt(x_dim_ * y_dim_ / n) : extent;
+  circle_cell_ = std::max(circle_cell_, std::max(2 * max_inflated_, 1.0));
+  circle_cols_ = CellCount(x_dim_, circle_cell_);
+  circle_rows_ = CellCount(y_dim_, circle_cell_);
+  BucketPoints(circles_.x, circles_.y, circle_cell_, circle_cols_,
+               circle_rows_, &circle_start_, &circle_items_);
+
+  // Corners of the polygons around the inflated obstacles, leaving out those
+  // too near a wall or inside another obstacle
+  node_x_.clear();
+  node_y_.clear();
+  unsigned sides = std::max(3u, params.n_sides);
+  double circumscribe = 1 / std::cos(M_PI / sides) * (1 + kGraze);
+  // The corners either side of each node, for Supporting()
+  std::vector<double> corners;
+  auto corner = [&](size_t i, double k, double * x, double * y) {
+    double a = 2 * M_PI * k / sides;
+    *x = circles_.x[i] + circles_.r[i] * circumscribe * std::cos(a);
+    *y = circles_.y[i] + circles_.r[i] * circumscribe * std::sin(a);
+  };
+  for (size_t i = 0; i < n; ++i) {
+    for (unsigned k = 0; k < sides; ++k) {
+      double x, y;
+      corner(i, k, &x, &y);
+      if (x < clearance_ || x > x_dim_ - clearance_ || y < clearance_ ||
+          y > y_dim_ - clearance_ || Blocked(x, y)) {
+        continue;
+      }
+      node_x_.push_back(x);
+      node_y_.push_back(y);
+      double ax, ay, bx, by;
+      corner(i, k + sides - 1.0, &ax, &ay);
+      corner(i, k + 1.0, &bx, &by);
+      corners.insert(corners.end(), {ax, ay, bx, by});
+    } /* for(k..) */
+  } /* for(i..) */
+  node_cell_ = max_edge_ > 0 ? max_edge_ : extent;
+  node_cols_ = CellCount(x_dim_, node_cell_);
+  node_rows_ = CellCount(y_dim_, node_cell_);
+  BucketPoints(node_x_, node_y_, node_cell_, node_cols_, node_rows_,
+               &node_start_, &node_items_);
+
+  // Join every pair of nodes that see each other and that a shortest path
+  // could use
+  std::vector<std::pair<uint32_t, uint32_t> > edges;
+  for (uint32_t i = 0; i < node_x_.size(); ++i) {
+    const double * ci = &corners[4 * i];
+    ForEachNodeNear(node_x_[i], node_y_[i], [&](uint32_t j) {
+        const double * cj = &corners[4 * j];
+        if (j > i &&
+            Supporting(node_x_[i], node_y_[i], node_x_[j], node_y_[j],
+                       ci[0], ci[1], ci[2], ci[3]) &&
+            Supporting(node_x_[j], node_y_[j], node_x_[i], node_y_[i],
+                       cj[0], cj[1], cj[2], cj[3]) &&
+            Visible(node_x_[i], node_y_[i], node_x_[j], node_y_[j])) {
+          edges.push_back(std::make_pair(i, j));
+          edges.push_back(std::make_pair(j, i));
+        }
+      });
+  } /* for(i..) */
+  std::sort(edges.begin(), edges.end());
+  edge_start_.assign(node_x_.size() + 1, 0);
+  adjacent_.resize(edges.size());
+  edge_length_.resize(edges.size());
+  for (size_t e = 0; e < edges.size(); ++e) {
+    uint32_t i = edges[e].first;
+    uint32_t j = edges[e].second;
+    ++edge_start_[i + 1];
+    adjacent_[e] = j;
+    edge_length_[e] = std::hypot(node_x_[j] - node_x_[i],
+                                 node_y_[j] - node_y_[i]);
+  } /* for(e..) */
+  for (size_t i = 0; i < node_x_.size(); ++i) {
+    edge_start_[i + 1] += edge_start_[i];
+  } /* for(i..) */
+} /* Build() */
+
+template <typename F>
+void VisibilityGraph::ForEachNodeNear(double x, double y, F f) const {
+  double reach = max_edge_ > 0 ? max_edge_ : std::max(x_dim_, y_dim_);
+  int c0 = std::max(0, static_cast<int>(std::floor((x - reach) / node_cell_)));
+  int c1 = std::min(static_cast<int>(node_cols_) - 1,
+                    static_cast<int>(std::floor((x + reach) / node_cell_)));
+  int r0 = std::max(0, static_cast<int>(std::floor((y - reach) / node_cell_)));
+  int r1 = std::min(static_cast<int>(node_rows_) - 1,
+                    static_cast<int>(std::floor((y + reach) / node_cell_)));
+  for (int r = r0; r <= r1; ++r) {
+    for (int c = c0; c <= c1; ++c) {
+      uint32_t cell = r * node_cols_ + c;
+      for (uint32_t k = node_start_[cell]; k < node_start_[cell + 1]; ++k) {
+        uint32_t j = node_items_[k];
+        double dx = node_x_[j] - x;
+        double dy = node_y_[j] - y;
+        if (max_edge_ <= 0 || dx * dx + dy * dy <= max_edge_ * max_edge_) {
+          f(j);
+        }
+      } /* for(k..) */
+    } /* for(c..) */
+  } /* for(r..) */
+} /* ForEachNodeNear() */
+
+bool VisibilityGraph::Blocked(double x, double y) const {
+  int c0 = std::max(0, static_cast<int>(
+      std::floor((x - max_inflated_) / circle_cell_)));
+  int c1 = std::min(static_cast<int>(circle_cols_) - 1, static_cast<int>(
+      std::floor((x + max_inflated_) / circle_cell_)));
+  int r0 = std::max(0, static_cast<int>(
+      std::floor((y - max_inflated_) / circle_cell_)));
+  int r1 = std::min(static_cast<int>(circle_rows_) - 1, static_cast<int>(
+      std::floor((y + max_inflated_) / circle_cell_)));
+  for (int r = r0; r <= r1; ++r) {
+    for (int c = c0; c <= c1; ++c) {
+      uint32_t cell = r * circle_cols_ + c;
+      for (uint32_t k = circle_start_[cell]; k < circle_start_[cell + 1];
+           ++k) {
+        uint32_t i = circle_items_[k];
+        double dx = circles_.x[i] - x;
+        double dy = circles_.y[i] - y;
+        if (dx * dx + dy * dy < circles_.r[i] * circles_.r[i]) {
+          return true;
+        }
+      } /* for(k..) */
+    } /* for(c..) */
+  } /* for(r..) */
+  return false;
+} /* Blocked() */
+
+bool VisibilityGraph::Visible(double x0, double y0, double x1,
+                              double y1) const {
+  double pad = max_inflated_;
+  int c0 = std::max(0, static_cast<int>(
+      std::floor((std::min(x0, x1) - pad) / circle_cell_)));
+  int c1 = std::min(static_cast<int>(circle_cols_) - 1, static_cast<int>(
+      std::floor((std::max(x0, x1) + pad) / circle_cell_)));
+  int r0 = std::max(0, static_cast<int>(
+      std::floor((std::min(y0, y1) - pad) / circle_cell_)));
+  int r1 = std::min(static_cast<int>(circle_rows_) - 1, static_cast<int>(
+      std::floor((std::max(y0, y1) + pad) / circle_cell_)));
+  double sx = x1 - x0;
+  double sy = y1 - y0;
+  double len2 = sx * sx + sy * sy;
+  for (int r = r0; r <= r1; ++r) {
+    for (int c = c0; c <= c1; ++c) {
+      uint32_t cell = r * circle_cols_ + c;
+      for (uint32_t k = circle_start_[cell]; k < circle_start_[cell + 1];
+           ++k) {
+        uint32_t i = circle_items_[k];
+        double px = circles_.x[i] - x0;
+        double py = circles_.y[i] - y0;
+        double rr = circles_.r[i] * circles_.r[i] * (1 - kGraze);
+        // Closest point of the segment to the center
+        double t = len2 > 0 ? std::min(std::max((px * sx + py * sy) / len2,
+                                                0.0), 1.0) : 0;
+        double dx = px - t * sx;
+        double dy = py - t * sy;
+        if (dx * dx + dy * dy >= rr) {
+          continue;
+        }
+        double qx = circles_.x[i] - x1;
+        double qy = circles_.y[i] - y1;
+        if (px * px + py * py >= rr && qx * qx + qy * qy >= rr) {
+          return false;
+        }
+      } /* for(k..) */
+    } /* for(c..) */
+  } /* for(r..) */
+  return true;
+} /* Visible() */
+
+bool VisibilityGraph::FindPath(const Position& start, const Position& goal,
+                               struct path_query * q,
+                               std::vector<Position> * path) const {
+  path->clear();
+  double sx = RealToDouble(start.x);
+  double sy = RealToDouble(start.y);
+  double gx = RealToDouble(goal.x);
+  double gy = RealToDouble(goal.y);
+  if (Visible(sx, sy, gx, gy)) {
+    path->push_back(goal);
+    return true;
+  }
+
+  // The start and goal are two more nodes after the graph's
+  uint32_t n = static_cast<uint32_t>(node_x_.size());
+  uint32_t s_node = n;
+  uint32_t g_node = n + 1;
+  if (q->g.size() < n + 2) {
+    q->g.resize(n + 2);
+    q->parent.resize(n + 2);
+    q->seen.assign(n + 2, 0);
+    q->closed.assign(n + 2, 0);
+    q->goal_link.assign(n + 2, 0);
+    q->generation = 0;
+  }
+  if (++q->generation == 0) {
+    std::fill(q->seen.begin(), q->seen.end(), 0);
+    std::fill(q->closed.begin(), q->closed.end(), 0);
+    std::fill(q->goal_link.begin(), q->goal_link.end(), 0);
+    q->generation = 1;
+  }
+  uint32_t gen = q->generation;
+  q->start_links.clear();
+  ForEachNodeNear(sx, sy, [&](uint32_t j) {
+      if (Visible(sx, sy, node_x_[j], node_y_[j])) {
+        q->start_links.push_back(j);
+      }
+    });
+  ForEachNodeNear(gx, gy, [&](uint32_t j) {
+      if (Visible(node_x_[j], node_y_[j], gx, gy)) {
+        q->goal_link[j] = gen;
+      }
+    });
+
+  auto x_of = [&](uint32_t u) {
+    return u < n ? node_x_[u] : (u == s_node ? sx : gx); };
+  auto y_of = [&](uint32_t u) {
+    return u < n ? node_y_[u] : (u == s_node ? sy : gy); };
+  auto h = [&](uint32_t u) { return std::hypot(gx - x_of(u), gy - y_of(u)); };
+  auto relax = [&](uint32_t u, uint32_t v, double length) {
+    double g = q->g[u] + length;
+    if (q->seen[v] != gen || g < q->g[v]) {
+      q->seen[v] = gen;
+      q->g[v] = g;
+      q->parent[v] = u;
+      q->open.push_back(std::make_pair(g + h(v), v));
+      std::push_heap(q->open.begin(), q->open.end(),
+                     std::greater<std::pair<double, uint32_t> >());
+    }
+  };
+
+  q->open.clear();
+  q->seen[s_node] = gen;
+  q->g[s_node] = 0;
+  q->open.push_back(std::make_pair(h(s_node), s_node));
+  while (!q->open.empty()) {
+    std::pop_heap(q->open.begin(), q->open.end(),
+                  std::greater<std::pair<double, uint32_t> >());
+    uint32_t u = q->open.back().second;
+    q->open.pop_back();
+    if (q->closed[u] == gen) {
+      continue;
+    }
+    q->closed[u] = gen;
+    if (u == g_node) {
+      for (uint32_t v = g_node; v != s_node; v = q->parent[v]) {
+        path->push_back(Position(x_of(v), y_of(v)));
+      } /* for(v..) */
+      std::reverse(path->begin(), path->end());
+      path->back() = goal;
+      return true;
+    }
+    if (u == s_node) {
+      for (uint32_t v : q->start_links) {
+        relax(u, v, std::hypot(node_x_[v] - sx, node_y_[v] - sy));
+      } /* for(v..) */
+      continue;
+    }
+    for (uint32_t k = edge_start_[u]; k < edge_start_[u + 1]; ++k) {
+      relax(u, adjacent_[k], edge_length_[k]);
+    } /* for(k..) */
+    if (q->goal_link[u] == gen) {
+      relax(u, g_node, std::hypot(gx - node_x_[u], gy - node_y_[u]));
+    }
+  } /* while() */
+  return false;
+} /* FindPath() */
+
+NAMESPACE_END(csci3081);
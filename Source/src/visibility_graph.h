@@ -0,0 +1,146 @@
+/**
+ * @file visibility_graph.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_VISIBILITY_GRAPH_H_
+#define SRC_VISIBILITY_GRAPH_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include <utility>
+#include <vector>
+#include "src/common.h"
+#include "src/ray_cast.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+struct visibility_graph_params {
+  visibility_graph_params(void) : clearance(0), n_sides(8), max_edge(0) {}
+
+  // Added to every obstacle's radius, and kept from the walls: the radius
+  // of what follows the paths plus some margin
+  double clearance;
+  // Each inflated obstacle is circumscribed by a polygon of this many sides,
+  // whose corners are the nodes of the graph
+  unsigned n_sides;
+  // Longest edge, or 0 for no limit. Large maps need a limit: with one, the
+  // graph and each query only look at nearby nodes
+  double max_edge;
+};
+
+/**
+ * @brief What one A* search needs besides the graph. Reusing it keeps
+ * searches from allocating, and giving each thread its own lets them search
+ * one graph at once.
+ */
+struct path_query {
+  path_query(void) : g(), parent(), seen(), closed(), goal_link(),
+                     start_links(), open(), generation(0) {}
+
+  std::vector<double> g;
+  std::vector<uint32_t> parent;
+  // Stamped with generation when g/parent, closed or goal_link are set
+  std::vector<uint32_t> seen;
+  std::vector<uint32_t> closed;
+  std::vector<uint32_t> goal_link;
+  std::vector<uint32_t> start_links;
+  std::vector<std::pair<double, uint32_t> > open;
+  uint32_t generation;
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Shortest paths around circular obstacles.
+ *
+ * The obstacles are inflated by the clearance and the corners of the polygons
+ * around them are joined wherever they can see each other, keeping only the
+ * edges a shortest path can take (those that pass their corners on the
+ * outside). Build() does this once for a set of obstacles; FindPath() then
+ * only links the start and goal into the graph and runs A*. Segments are
+ * tested against the obstacles near them only, through a grid.
+ *
+ * A built graph is read-only, so one can serve every Arena made from the same
+ * obstacles, on any number of threads (one path_query each).
+ */
+class VisibilityGraph {
+ public:
+  VisibilityGraph(void);
+
+  void Build(const struct circle_batch& obstacles, uint x_dim, uint y_dim,
+             const struct visibility_graph_params& params);
+
+  size_t n_nodes(void) const { return node_x_.size(); }
+  size_t n_edges(void) const { return adjacent_.size() / 2; }
+
+  /**
+   * @brief Whether the segment keeps clear of every inflated obstacle that
+   * does not contain one of its ends. An end inside an obstacle may still
+   * leave it, so that a robot that has strayed too close can get away.
+   */
+  bool Visible(double x0, double y0, double x1, double y1) const;
+
+  /**
+   * @brief Find the shortest path from start to goal.
+   *
+   * @param[out] path The waypoints after start, ending with goal.
+   *
+   * @return false if goal cannot be reached.
+   */
+  bool FindPath(const Position& start, const Position& goal,
+                struct path_query * query, std::vector<Position> * path) const;
+
+ private:
+  /**
+   * @brief Call f(i) for every node within max_edge of (x, y); every node if
+   * there is no limit.
+   */
+  template <typename F>
+  void ForEachNodeNear(double x, double y, F f) const;
+
+  /**
+   * @brief Whether (x, y) is inside an inflated obstacle.
+   */
+  bool Blocked(double x, double y) const;
+
+  double x_dim_;
+  double y_dim_;
+  double clearance_;
+  double max_edge_;
+  // Inflated obstacles, bucketed by center into a grid for Visible()
+  struct circle_batch circles_;
+  double circle_cell_;
+  uint32_t circle_cols_;
+  uint32_t circle_rows_;
+  std::vector<uint32_t> circle_start_;
+  std::vector<uint32_t> circle_items_;
+  double max_inflated_;
+  // Nodes, bucketed the same way with cells of max_edge
+  std::vector<double> node_x_;
+  std::vector<double> node_y_;
+  double node_cell_;
+  uint32_t node_cols_;
+  uint32_t node_rows_;
+  std::vector<uint32_t> node_start_;
+  std::vector<uint32_t> node_items_;
+  // Edges: the neighbors of node i are adjacent_[edge_start_[i] ..
+  // edge_start_[i + 1]), at the matching edge_length_
+  std::vector<uint32_t> edge_start_;
+  std::vector<uint32_t> adjacent_;
+  std::vector<double> edge_length_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif /* SRC_VISIBILITY_GRAPH_H_ */
@@ -0,0 +1,89 @@
+/**
+ * @file worker_pool.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/worker_pool.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+WorkerPool::WorkerPool(size_t n_threads) :
+  workers_(), mutex_(), start_(), finished_(), call_(nullptr), job_(nullptr),
+  generation_(0), pending_(0), quit_(false) {
+  if (n_threads == 0) {
+    n_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  for (size_t t = 1; t < n_threads; ++t) {
+    workers_.emplace_back(&WorkerPool::Work, this, t);
+  } /* for(t..) */
+}
+
+WorkerPool::~WorkerPool(void) {
+  Wait();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    quit_ = true;
+  }
+  start_.notify_all();
+  for (std::thread& t : workers_) {
+    t.join();
+  } /* for(t..) */
+}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void WorkerPool::StartCall(call_fn call, const void * job) {
+  if (workers_.empty()) {
+    return;
+  }
+  {
+    // The workers read the job after taking the lock, so they see it
+    std::lock_guard<std::mutex> lock(mutex_);
+    call_ = call;
+    job_ = job;
+    pending_ = workers_.size();
+    ++generation_;
+  }
+  start_.notify_all();
+} /* StartCall() */
+
+void WorkerPool::Wait(void) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  finished_.wait(lock, [this] { return pending_ == 0; });
+} /* Wait() */
+
+void WorkerPool::Work(size_t t) {
+  uint64_t seen = 0;
+  for (;;) {
+    call_fn call;
+    const void * job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_.wait(lock, [&] { return quit_ || generation_ != seen; });
+      if (quit_) {
+        return;
+      }
+      seen = generation_;
+      call = call_;
+      job = job_;
+    }
+    call(job, t);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--pending_ == 0) {
+      finished_.notify_one();
+    }
+  } /* for(;;) */
+} /* Work() */
+
+NAMESPACE_END(csci3081);
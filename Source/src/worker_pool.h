@@ -0,0 +1,139 @@
+/**
+ * @file worker_pool.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_WORKER_POOL_H_
+#define SRC_WORKER_POOL_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Threads that live as long as the pool and run one job at a time,
+ * so that work done every step does not start and join threads every step.
+ *
+ * Thread 0 is whoever calls Run(); threads 1 to n_threads() - 1 are the
+ * pool's own. A job is any f(size_t t), called once on each thread with its
+ * number. Starting one allocates nothing. One thread owns the pool and is
+ * the only one to start jobs on it or wait for them.
+ */
+class WorkerPool {
+ public:
+  /**
+   * @param[in] n_threads Counting the caller's; 0 for one per core.
+   */
+  explicit WorkerPool(size_t n_threads);
+  ~WorkerPool(void);
+
+  size_t n_threads(void) const { return workers_.size() + 1; }
+
+  /**
+   * @brief Call job(t) for every t in [0, n_threads()), job(0) on the
+   * calling thread, and return once all are done.
+   */
+  template <typename F>
+  void Run(const F& job) {
+    Start(job);
+    job(0);
+    Wait();
+  }
+
+  /**
+   * @brief Call job(t) for every t in [1, n_threads()) on the pool's
+   * threads, and return at once. job must outlive the Wait() that follows.
+   */
+  template <typename F>
+  void Start(const F& job) {
+    StartCall(&Call<F>, &job);
+  }
+
+  /**
+   * @brief Wait for the job last started to finish; at once if there is
+   * none.
+   */
+  void Wait(void);
+
+ private:
+  typedef void (*call_fn)(const void * job, size_t t);
+
+  template <typename F>
+  static void Call(const void * job, size_t t) {
+    (*static_cast<const F *>(job))(t);
+  }
+
+  void StartCall(call_fn call, const void * job);
+
+  /**
+   * @brief What each of the pool's threads runs until destruction.
+   */
+  void Work(size_t t);
+
+  WorkerPool& operator=(const WorkerPool& other) = delete;
+  WorkerPool(const WorkerPool& other) = delete;
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable finished_;
+  // The job being run
+  call_fn call_;
+  const void * job_;
+  // Bumped for each job; workers run it once they see it change
+  uint64_t generation_;
+  // Workers yet to finish the current job
+  size_t pending_;
+  bool quit_;
+};
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief Call f(t, begin, end) over [0, n), split into ranges of at least
+ * min_per_thread across the pool's threads when that is worth it, or all on
+ * the calling thread if pool is nullptr. t is the number of the thread
+ * running the range, less than pool->n_threads(), e.g. to pick scratch by;
+ * each range has a different one.
+ */
+template <typename F>
+void ForRanges(WorkerPool * pool, size_t n, size_t min_per_thread, F f) {
+  size_t n_ranges = 1;
+  if (pool) {
+    n_ranges = std::min(pool->n_threads(), n / std::max<size_t>(
+        1, min_per_thread));
+  }
+  if (n_ranges <= 1) {
+    f(0, 0, n);
+    return;
+  }
+  size_t chunk = (n + n_ranges - 1) / n_ranges;
+  pool->Run([&](size_t t) {
+      size_t begin = t * chunk;
+      if (begin < n) {
+        f(t, begin, std::min(n, begin + chunk));
+      }
+    });
+} /* ForRanges() */
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_WORKER_POOL_H_
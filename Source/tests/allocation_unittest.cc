@@ -0,0 +1,141 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "../src/arena.h"
+#include "../src/arena_defaults.h"
+#include "../src/arena_params.h"
+#include "../src/bump_allocator.h"
+#include "../src/flow_field.h"
+#include "../src/vec_arena.h"
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+// Global operator new is replaced for the whole test binary; it only counts
+// while a test asks it to. Atomic, as the arenas and fields under test
+// allocate (or not) from their worker threads too.
+static std::atomic<bool> g_counting(false);
+static std::atomic<size_t> g_allocations(0);
+
+void * operator new(size_t size) {
+  if (g_counting.load(std::memory_order_relaxed)) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  void * p = malloc(size ? size : 1);
+  if (!p) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void * p) noexcept { free(p); }
+void operator delete(void * p, size_t) noexcept { free(p); }
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Memory handed out after a Reset() comes from the blocks already held.
+TEST(BumpAllocator, ResetReusesBlocks) {
+  csci3081::BumpAllocator scratch(64);
+  double * d = scratch.AllocateArray<double>(4);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(d) % alignof(double), 0u);
+  scratch.AllocateArray<char>(100);  // larger than a block
+  EXPECT_STREQ(scratch.Format("%s%d", "Robot", 3), "Robot3");
+  size_t cap = scratch.capacity();
+  EXPECT_GE(scratch.used(), 4 * sizeof(double) + 100);
+
+  scratch.Reset();
+  EXPECT_EQ(scratch.used(), 0u);
+  g_allocations = 0;
+  g_counting = true;
+  scratch.AllocateArray<double>(4);
+  scratch.AllocateArray<char>(100);
+  scratch.Format("%s%d", "Robot", 3);
+  g_counting = false;
+  EXPECT_EQ(g_allocations.load(), 0u);
+  EXPECT_EQ(scratch.capacity(), cap);
+}
+
+// Once warmed up, a step does not touch the global heap.
+TEST(Arena, SteadyStateStepDoesNotAllocate) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  aparams.home_base.seed = 1;
+  csci3081::Arena arena(&aparams);
+  csci3081::EventKeypress key(264);  // down key
+  arena.Accept(&key);
+  arena.AdvanceTime();
+  arena.Accept(&key);
+  arena.AdvanceTime();
+
+  g_allocations = 0;
+  g_counting = true;
+  for (int i = 0; i < 50; ++i) {
+    arena.Accept(&key);
+    arena.AdvanceTime();
+  }
+  g_counting = false;
+  EXPECT_EQ(g_allocations.load(), 0u)
+      << "FAIL: Heap allocation during a step";
+}
+
+// A flow field following its goal reuses the memory of its earlier solves,
+// the far ones on its worker included.
+TEST(FlowField, FollowingGoalDoesNotAllocate) {
+  csci3081::circle_batch obstacles;
+  obstacles.Push(100, 100, 20);
+  csci3081::flow_field_params fparams;
+  fparams.cell_size = 4;
+  fparams.window = 4;
+  csci3081::FlowField field(200, 200, obstacles, fparams);
+  double gx = 20;
+  for (; gx < 60; gx += 0.5) {
+    field.Update(gx, 180);
+  }
+  unsigned far_solves = field.far_solves();
+
+  g_allocations = 0;
+  g_counting = true;
+  for (; gx < 180; gx += 0.5) {
+    field.Update(gx, 180);
+  }
+  g_counting = false;
+  EXPECT_GT(field.far_solves(), far_solves);
+  EXPECT_EQ(g_allocations.load(), 0u)
+      << "FAIL: Heap allocation following the goal";
+}
+
+// Once each environment has been through an episode, stepping them all,
+// resets included, does not touch the global heap on any thread.
+TEST(VecArena, StepDoesNotAllocate) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  aparams.home_base.seed = 1;
+  csci3081::vec_arena_params vparams;
+  vparams.n_envs = 4;
+  vparams.max_episode_steps = 10;
+  vparams.n_threads = 2;
+  csci3081::VecArena envs(&aparams, vparams);
+  std::vector<enum csci3081::event_commands> actions(
+      vparams.n_envs, csci3081::COM_SPEED_UP);
+  std::vector<float> obs(vparams.n_envs * csci3081::OBS_SIZE);
+  std::vector<float> rewards(vparams.n_envs);
+  std::vector<uint8_t> dones(vparams.n_envs);
+  for (size_t step = 0; step < vparams.max_episode_steps; ++step) {
+    envs.Step(actions.data(), obs.data(), rewards.data(), dones.data());
+  }
+
+  g_allocations = 0;
+  g_counting = true;
+  for (int step = 0; step < 30; ++step) {
+    envs.Step(actions.data(), obs.data(), rewards.data(), dones.data());
+  }
+  g_counting = false;
+  EXPECT_EQ(g_allocations.load(), 0u)
+      << "FAIL: Heap allocation during a step";
+}
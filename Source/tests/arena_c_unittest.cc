@@ -0,0 +1,109 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <string>
+#include "../src/arena_c.h"
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+template <typename T>
+static T At(const struct arena_view& view, size_t i) {
+  return *reinterpret_cast<const T *>(
+      static_cast<const char *>(view.data) + i * view.stride);
+}
+
+static double RealAt(const struct arena_view& view, size_t i) {
+  if (view.dtype == ARENA_DTYPE_FIXED16) {
+    return At<int64_t>(view, i) / 65536.0;
+  }
+  return At<double>(view, i);
+}
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// The views point into the arena rather than at copies: taken once, they
+// show where the robot is after each step until something moves storage.
+TEST(ArenaC, ViewsFollowTheArena) {
+  char error[128];
+  arena_sim * sim = arena_create(nullptr, error, sizeof(error));
+  ASSERT_NE(sim, nullptr);
+  EXPECT_EQ(arena_api_version(), static_cast<uint32_t>(ARENA_API_VERSION));
+
+  struct arena_view ids, xs, speeds, mover_ids;
+  ASSERT_EQ(arena_get_view(sim, ARENA_BODY_ID, &ids), 0);
+  ASSERT_EQ(arena_get_view(sim, ARENA_BODY_X, &xs), 0);
+  ASSERT_EQ(arena_get_view(sim, ARENA_MOVER_SPEED, &speeds), 0);
+  ASSERT_EQ(arena_get_view(sim, ARENA_MOVER_ID, &mover_ids), 0);
+  EXPECT_EQ(arena_get_view(sim, 99, &xs), -1);
+  ASSERT_EQ(ids.count, xs.count);
+  EXPECT_EQ(ids.dtype, ARENA_DTYPE_U32);
+
+  uint32_t player = arena_player(sim);
+  EXPECT_EQ(arena_kind(sim, player), static_cast<uint32_t>(ARENA_KIND_ROBOT));
+  size_t body = 0;
+  while (At<uint32_t>(ids, body) != player) {
+    ++body;
+  }
+  size_t mover = 0;
+  while (At<uint32_t>(mover_ids, mover) != player) {
+    ++mover;
+  }
+
+  double speed = RealAt(speeds, mover);
+  EXPECT_EQ(arena_command(sim, ARENA_COM_SLOW_DOWN), 0);
+  EXPECT_EQ(arena_command(sim, 17), -1);
+  double x = RealAt(xs, body);
+  arena_step(sim, 1);
+  EXPECT_EQ(RealAt(speeds, mover), speed - 1);
+  EXPECT_NE(RealAt(xs, body), x);
+
+  // The nearest robot to the player's position, leaving it out, is another
+  uint32_t out[2];
+  double distances[2];
+  struct arena_view ys;
+  ASSERT_EQ(arena_get_view(sim, ARENA_BODY_Y, &ys), 0);
+  size_t n = arena_query_nearest(sim, RealAt(xs, body), RealAt(ys, body), 2,
+                                 ARENA_ALL_KINDS, player, out, distances);
+  ASSERT_EQ(n, 2u);
+  EXPECT_NE(out[0], player);
+  EXPECT_LE(distances[0], distances[1]);
+  arena_destroy(sim);
+}
+
+// Restoring a snapshot puts the robot back; a missing scenario says why.
+TEST(ArenaC, SnapshotAndErrors) {
+  arena_sim * sim = arena_create(nullptr, nullptr, 0);
+  ASSERT_NE(sim, nullptr);
+  arena_sim_snapshot * start = arena_snapshot(sim);
+  ASSERT_NE(start, nullptr);
+  struct arena_view levels;
+  ASSERT_EQ(arena_get_view(sim, ARENA_BATTERY_LEVEL, &levels), 0);
+  ASSERT_GT(levels.count, 0u);
+  double level = RealAt(levels, 0);
+  EXPECT_EQ(arena_step(sim, 20), 0);
+  ASSERT_EQ(arena_get_view(sim, ARENA_BATTERY_LEVEL, &levels), 0);
+  EXPECT_LT(RealAt(levels, 0), level);
+  EXPECT_EQ(arena_restore(sim, start), 0);
+  ASSERT_EQ(arena_get_view(sim, ARENA_BATTERY_LEVEL, &levels), 0);
+  EXPECT_EQ(RealAt(levels, 0), level);
+  EXPECT_EQ(arena_last_error(sim), nullptr);
+  // Ids from the caller are checked, not trusted
+  EXPECT_EQ(arena_kind(sim, ARENA_NO_ENTITY),
+            static_cast<uint32_t>(ARENA_KIND_NONE));
+  EXPECT_EQ(arena_kind(sim, 1u << 30), static_cast<uint32_t>(ARENA_KIND_NONE));
+  EXPECT_EQ(arena_command(sim, -1), -1);
+  ASSERT_NE(arena_last_error(sim), nullptr);
+  EXPECT_NE(std::string(arena_last_error(sim)).find("command"),
+            std::string::npos);
+  arena_snapshot_destroy(start);
+  arena_destroy(sim);
+
+  char error[128] = "";
+  EXPECT_EQ(arena_create("no/such/scenario.txt", error, sizeof(error)),
+            nullptr);
+  EXPECT_NE(std::string(error).find("no/such/scenario.txt"),
+            std::string::npos);
+}
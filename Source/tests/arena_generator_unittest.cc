@@ -0,0 +1,103 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <string>
+#include "../src/arena_generator.h"
+#include "../src/arena_params.h"
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+static double Dist(const Position& a, const Position& b) {
+  double dx = csci3081::RealToDouble(a.x) - csci3081::RealToDouble(b.x);
+  double dy = csci3081::RealToDouble(a.y) - csci3081::RealToDouble(b.y);
+  return std::sqrt(dx * dx + dy * dy);
+}
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Everything is at least a robot's width apart from everything else and from
+// the walls, so the robot can get anywhere.
+TEST(ArenaGenerator, Spacing) {
+  csci3081::arena_generator_params gparams;
+  gparams.n_obstacles = 2000;
+  csci3081::arena_params aparams;
+  size_t placed = 0;
+  std::string error;
+  ASSERT_TRUE(csci3081::GenerateArenaParams(&gparams, &aparams, &placed,
+                                            &error)) << error;
+  ASSERT_EQ(placed, 2000u);
+  ASSERT_EQ(aparams.obstacles.size(), 2000u);
+
+  double gap = 2 * (aparams.robot.radius + aparams.robot.collision_delta);
+  const csci3081::arena_entity_params * special[] = {
+    &aparams.robot, &aparams.home_base, &aparams.recharge_station
+  };
+  for (size_t i = 0; i < aparams.obstacles.size(); ++i) {
+    const csci3081::arena_entity_params& o = aparams.obstacles[i];
+    double x = csci3081::RealToDouble(o.pos.x);
+    double y = csci3081::RealToDouble(o.pos.y);
+    EXPECT_GE(x - o.radius, gap);
+    EXPECT_GE(y - o.radius, gap);
+    EXPECT_LE(x + o.radius + gap, aparams.x_dim);
+    EXPECT_LE(y + o.radius + gap, aparams.y_dim);
+    for (const csci3081::arena_entity_params * s : special) {
+      EXPECT_GE(Dist(o.pos, s->pos), o.radius + s->radius + gap);
+    }
+    for (size_t j = i + 1; j < aparams.obstacles.size(); ++j) {
+      ASSERT_GE(Dist(o.pos, aparams.obstacles[j].pos),
+                o.radius + aparams.obstacles[j].radius + gap)
+          << "FAIL: Obstacles " << i << " and " << j << " too close";
+    }
+  }
+}
+
+// A seed always gives the same arena.
+TEST(ArenaGenerator, Seeded) {
+  csci3081::arena_generator_params gparams;
+  gparams.n_obstacles = 500;
+  gparams.seed = 42;
+  csci3081::arena_params a, b;
+  size_t placed = 0;
+  ASSERT_TRUE(csci3081::GenerateArenaParams(&gparams, &a, &placed, nullptr));
+  ASSERT_TRUE(csci3081::GenerateArenaParams(&gparams, &b, &placed, nullptr));
+  EXPECT_EQ(a.robot.pos, b.robot.pos);
+  EXPECT_EQ(a.home_base.seed, 42u);
+  ASSERT_EQ(a.obstacles.size(), b.obstacles.size());
+  for (size_t i = 0; i < a.obstacles.size(); ++i) {
+    EXPECT_EQ(a.obstacles[i].pos, b.obstacles[i].pos);
+  }
+
+  gparams.seed = 43;
+  ASSERT_TRUE(csci3081::GenerateArenaParams(&gparams, &b, &placed, nullptr));
+  EXPECT_FALSE(a.obstacles[0].pos == b.obstacles[0].pos);
+
+  // A fixed arena that is too small is filled rather than overfilled
+  gparams.x_dim = 400;
+  gparams.y_dim = 300;
+  ASSERT_TRUE(csci3081::GenerateArenaParams(&gparams, &b, &placed, nullptr));
+  EXPECT_LT(placed, 500u);
+  EXPECT_GT(b.obstacles.size(), 0u);
+}
+
+// An arena too small to keep the robot, home base and recharge station
+// apart is refused rather than generated with them overlapping.
+TEST(ArenaGenerator, TooSmall) {
+  csci3081::arena_generator_params gparams;
+  gparams.n_obstacles = 10;
+  csci3081::arena_params aparams;
+  size_t placed = 0;
+  std::string error;
+  gparams.x_dim = 40;
+  gparams.y_dim = 40;
+  EXPECT_FALSE(csci3081::GenerateArenaParams(&gparams, &aparams, &placed,
+                                             &error));
+  EXPECT_EQ(error, "arena too small for the robot");
+  gparams.x_dim = 150;
+  gparams.y_dim = 150;
+  EXPECT_FALSE(csci3081::GenerateArenaParams(&gparams, &aparams, &placed,
+                                             &error));
+  EXPECT_NE(error.find("no room for the"), std::string::npos) << error;
+}
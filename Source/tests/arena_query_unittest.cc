@@ -0,0 +1,193 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+#include "../src/arena.h"
+#include "../src/arena_defaults.h"
+#include "../src/arena_params.h"
+
+/*******************************************************************************
+ * Test Fixture
+ ******************************************************************************/
+/**
+ * The standard arena with 100 more robots and 100 more obstacles strewn
+ * about, enough that the queries go through the grid.
+ */
+class ArenaQueryTest : public ::testing::Test {
+ protected:
+  ArenaQueryTest(void) : aparams_(), arena_(), generator_(7), unit_(0, 1) {}
+
+  virtual void SetUp(void) {
+    csci3081::DefaultArenaParams(&aparams_);
+    for (int i = 0; i < 100; ++i) {
+      csci3081::robot_params r = aparams_.robot;
+      r.radius = 5 + unit_(generator_) * 15;
+      r.pos = RandomPosition();
+      aparams_.extra_robots.push_back(r);
+      csci3081::arena_entity_params o = aparams_.obstacles[0];
+      o.radius = 5 + unit_(generator_) * 40;
+      o.pos = RandomPosition();
+      aparams_.obstacles.push_back(o);
+    }
+    arena_.reset(new csci3081::Arena(&aparams_));
+  }
+
+  Position RandomPosition(void) {
+    return Position(unit_(generator_) * aparams_.x_dim,
+                    unit_(generator_) * aparams_.y_dim);
+  }
+
+  /**
+   * Every entity of the given kinds, as (center distance, id), nearest
+   * first, found by looking at each one.
+   */
+  std::vector<std::pair<double, csci3081::entity_id> > ByDistance(
+      const Position& p, uint32_t kinds) {
+    std::vector<std::pair<double, csci3081::entity_id> > all;
+    const csci3081::ComponentPool<csci3081::transform>& bodies =
+        arena_->registry().transform_pool();
+    for (size_t i = 0; i < bodies.size(); ++i) {
+      csci3081::entity_id e = bodies.owners()[i];
+      if (kinds & csci3081::KindBit(arena_->registry().kind(e))) {
+        all.push_back(std::make_pair(
+            std::hypot(csci3081::RealToDouble(bodies.data()[i].pos.x - p.x),
+                       csci3081::RealToDouble(bodies.data()[i].pos.y - p.y)),
+            e));
+      }
+    }
+    std::sort(all.begin(), all.end());
+    return all;
+  }
+
+  csci3081::arena_params aparams_;
+  std::unique_ptr<csci3081::Arena> arena_;
+  std::minstd_rand0 generator_;
+  std::uniform_real_distribution<double> unit_;
+};
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// The k nearest, of every kind and of one, are those found by sorting them
+// all, and the one asking is left out.
+TEST_F(ArenaQueryTest, NearestMatchesScan) {
+  csci3081::entity_id out[6];
+  double distances[6];
+  uint32_t robots = csci3081::KindBit(csci3081::KIND_ROBOT);
+  for (int q = 0; q < 50; ++q) {
+    Position p = RandomPosition();
+    std::vector<std::pair<double, csci3081::entity_id> > all =
+        ByDistance(p, csci3081::kAllKinds);
+    ASSERT_EQ(arena_->QueryNearest(p, 6, csci3081::kAllKinds, out,
+                                   distances), 6u);
+    for (size_t i = 0; i < 6; ++i) {
+      EXPECT_EQ(out[i], all[i].second);
+      EXPECT_NEAR(distances[i], all[i].first, 1e-6);
+    }
+
+    all = ByDistance(p, robots);
+    ASSERT_EQ(arena_->QueryNearest(p, 6, robots, out, nullptr,
+                                   all[0].second), 6u);
+    for (size_t i = 0; i < 6; ++i) {
+      EXPECT_EQ(out[i], all[i + 1].second);
+    }
+  }
+}
+
+// Radius and box queries find exactly the entities that overlap them, and
+// say how many there are when the buffer is too small.
+TEST_F(ArenaQueryTest, RadiusAndBox) {
+  std::vector<csci3081::entity_id> out(400);
+  const csci3081::ComponentPool<csci3081::transform>& bodies =
+      arena_->registry().transform_pool();
+  for (int q = 0; q < 50; ++q) {
+    Position p = RandomPosition();
+    double radius = unit_(generator_) * 150;
+    double x0 = csci3081::RealToDouble(p.x) - radius;
+    double y0 = csci3081::RealToDouble(p.y) - radius / 2;
+    double x1 = csci3081::RealToDouble(p.x) + radius;
+    double y1 = csci3081::RealToDouble(p.y) + radius / 2;
+    std::vector<csci3081::entity_id> in_circle;
+    std::vector<csci3081::entity_id> in_box;
+    for (size_t i = 0; i < bodies.size(); ++i) {
+      double x = csci3081::RealToDouble(bodies.data()[i].pos.x);
+      double y = csci3081::RealToDouble(bodies.data()[i].pos.y);
+      double r = csci3081::RealToDouble(bodies.data()[i].radius);
+      if (std::hypot(x - csci3081::RealToDouble(p.x),
+                     y - csci3081::RealToDouble(p.y)) <= radius + r) {
+        in_circle.push_back(bodies.owners()[i]);
+      }
+      if (std::hypot(x - std::min(std::max(x, x0), x1),
+                     y - std::min(std::max(y, y0), y1)) <= r) {
+        in_box.push_back(bodies.owners()[i]);
+      }
+    }
+    std::sort(in_circle.begin(), in_circle.end());
+    std::sort(in_box.begin(), in_box.end());
+
+    size_t n = arena_->QueryRadius(p, radius, csci3081::kAllKinds, out.data(),
+                                   out.size());
+    ASSERT_EQ(n, in_circle.size());
+    std::sort(out.begin(), out.begin() + n);
+    EXPECT_TRUE(std::equal(in_circle.begin(), in_circle.end(), out.begin()));
+    if (n > 1) {
+      EXPECT_EQ(arena_->QueryRadius(p, radius, csci3081::kAllKinds,
+                                    out.data(), 1), n);
+    }
+
+    n = arena_->QueryBox(x0, y0, x1, y1, csci3081::kAllKinds, out.data(),
+                         out.size());
+    ASSERT_EQ(n, in_box.size());
+    std::sort(out.begin(), out.begin() + n);
+    EXPECT_TRUE(std::equal(in_box.begin(), in_box.end(), out.begin()));
+  }
+}
+
+// The batch queries answer each point as the single ones do, and all the
+// queries follow the entities as they move.
+TEST_F(ArenaQueryTest, BatchAndMoving) {
+  const size_t n = 64;
+  const size_t k = 4;
+  std::vector<Position> points(n);
+  std::vector<csci3081::entity_id> out(n * k);
+  std::vector<size_t> counts(n);
+  std::vector<csci3081::entity_id> one(k);
+  for (int step = 0; step < 3; ++step) {
+    for (size_t i = 0; i < n; ++i) {
+      points[i] = RandomPosition();
+    }
+    arena_->QueryNearestBatch(points.data(), n, k, csci3081::kAllKinds,
+                              nullptr, out.data(), counts.data());
+    for (size_t i = 0; i < n; ++i) {
+      ASSERT_EQ(counts[i], k);
+      std::vector<std::pair<double, csci3081::entity_id> > all =
+          ByDistance(points[i], csci3081::kAllKinds);
+      for (size_t j = 0; j < k; ++j) {
+        EXPECT_EQ(out[i * k + j], all[j].second);
+      }
+    }
+
+    arena_->QueryRadiusBatch(points.data(), n, 60, csci3081::kAllKinds,
+                             out.data(), k, counts.data());
+    for (size_t i = 0; i < n; ++i) {
+      EXPECT_EQ(counts[i], arena_->QueryRadius(points[i], 60,
+                                               csci3081::kAllKinds,
+                                               one.data(), k));
+    }
+
+    // Move the robots on
+    const std::vector<csci3081::entity_id>& robots =
+        arena_->registry().of_kind(csci3081::KIND_ROBOT);
+    for (csci3081::entity_id e : robots) {
+      csci3081::Robot(&arena_->registry(), e).set_speed(5);
+    }
+    for (int i = 0; i < 10; ++i) {
+      arena_->AdvanceTime();
+    }
+  }
+}
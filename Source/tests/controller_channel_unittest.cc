@@ -0,0 +1,137 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include "../src/arena.h"
+#include "../src/arena_defaults.h"
+#include "../src/arena_params.h"
+#include "../src/controller_channel.h"
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+static std::string ChannelName(const char * test) {
+  return "/arena-test-ctl-" + std::to_string(getpid()) + "-" + test;
+}
+
+static void ExpectSameRobot(csci3081::Arena * a, csci3081::Arena * b) {
+  EXPECT_EQ(a->robot()->get_pos().x, b->robot()->get_pos().x);
+  EXPECT_EQ(a->robot()->get_pos().y, b->robot()->get_pos().y);
+  EXPECT_EQ(a->robot()->get_heading_angle(), b->robot()->get_heading_angle());
+}
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// A controller on another thread, through its own mapping, steers the
+// player exactly as the same commands queued directly would.
+TEST(ControllerChannel, SteersLikeDirectCommands) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  csci3081::Arena arena(&aparams);
+  csci3081::Arena direct(&aparams);
+  std::string name = ChannelName("steer");
+  std::string error;
+  csci3081::ControllerHost host;
+  ASSERT_TRUE(host.Add(name.c_str(), arena.robot()->id(), &error)) << error;
+
+  // Turns left on even steps and right on odd ones, after a look at the
+  // observation it was sent
+  std::atomic<bool> done(false);
+  std::thread controller([&]() {
+      csci3081::ControllerClient client;
+      std::string why;
+      ASSERT_TRUE(client.Attach(name.c_str(), &why)) << why;
+      csci3081::controller_observation obs;
+      while (!done.load()) {
+        if (client.Receive(&obs)) {
+          EXPECT_GT(obs.observation[csci3081::OBS_BATTERY], 0.0f);
+          client.Reply(obs, obs.step % 2 ? csci3081::COM_TURN_RIGHT :
+                       csci3081::COM_TURN_LEFT);
+        }
+      } /* while() */
+    });
+
+  const uint64_t n_steps = 50;
+  for (uint64_t step = 0; step < n_steps; ++step) {
+    // A generous budget, so a descheduled controller thread still answers
+    host.Send(arena, step, 1000000000);
+    host.Collect(&arena);
+    arena.AdvanceTime();
+    direct.event_bus().commands().Push(csci3081::command_record {
+        direct.robot()->id(), csci3081::EventCommand(
+            step % 2 ? csci3081::COM_TURN_RIGHT : csci3081::COM_TURN_LEFT)});
+    direct.AdvanceTime();
+  } /* for(step..) */
+  done = true;
+  controller.join();
+
+  ExpectSameRobot(&arena, &direct);
+  const csci3081::controller_stats& stats = host.stats(0);
+  EXPECT_EQ(stats.answered, n_steps);
+  EXPECT_EQ(stats.missed, 0u);
+  EXPECT_GT(stats.round_trip_ns, 0u);
+  EXPECT_GE(stats.max_round_trip_ns * n_steps, stats.round_trip_ns);
+}
+
+// Without an answer the step still runs, on the last command; an answer
+// that comes after its step is only counted as late.
+TEST(ControllerChannel, FallsBackToLastCommand) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  csci3081::Arena arena(&aparams);
+  csci3081::Arena direct(&aparams);
+  std::string name = ChannelName("fallback");
+  std::string error;
+  csci3081::ControllerHost host;
+  ASSERT_TRUE(host.Add(name.c_str(), arena.robot()->id(), &error)) << error;
+  csci3081::ControllerClient client;
+  ASSERT_TRUE(client.Attach(name.c_str(), &error)) << error;
+
+  csci3081::controller_observation obs;
+  EXPECT_FALSE(client.Receive(&obs));
+  host.Send(arena, 0, 0);
+  ASSERT_TRUE(client.Receive(&obs));
+  EXPECT_EQ(obs.robot, arena.robot()->id());
+  ASSERT_TRUE(client.Reply(obs, csci3081::COM_TURN_LEFT));
+  host.Collect(&arena);
+  arena.AdvanceTime();
+  for (uint64_t step = 1; step < 10; ++step) {
+    host.Send(arena, step, 0);
+    host.Collect(&arena);
+    arena.AdvanceTime();
+  } /* for(step..) */
+  for (int step = 0; step < 10; ++step) {
+    direct.event_bus().commands().Push(csci3081::command_record {
+        direct.robot()->id(),
+        csci3081::EventCommand(csci3081::COM_TURN_LEFT)});
+    direct.AdvanceTime();
+  } /* for(step..) */
+  ExpectSameRobot(&arena, &direct);
+
+  // The controller only now answers step 9, and the newest observation,
+  // with nothing
+  ASSERT_TRUE(client.Receive(&obs));
+  EXPECT_EQ(obs.step, 9u);
+  ASSERT_TRUE(client.Reply(obs, csci3081::COM_NONE));
+  host.Send(arena, 10, 0);
+  host.Collect(&arena);
+  EXPECT_EQ(host.stats(0).answered, 1u);
+  EXPECT_EQ(host.stats(0).missed, 10u);
+  EXPECT_EQ(host.stats(0).late, 1u);
+  EXPECT_EQ(arena.event_bus().commands().size(), 0u);
+
+  // A controller that never reads fills its ring, and is sent no more
+  for (uint32_t i = 0; i < csci3081::kControllerRingSize; ++i) {
+    host.Send(arena, 11 + i, 0);
+    host.Collect(&arena);
+  } /* for(i..) */
+  EXPECT_EQ(host.stats(0).dropped, 1u);
+
+  EXPECT_FALSE(csci3081::ControllerClient().Attach("/arena-test-ctl-none",
+                                                   &error));
+}
@@ -0,0 +1,69 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include "../src/arena.h"
+#include "../src/arena_defaults.h"
+#include "../src/arena_params.h"
+#include "../src/distance_field.h"
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Distances match the exact ones to within a cell, walls included.
+TEST(DistanceField, MatchesExact) {
+  csci3081::DistanceField field(400, 300, 2, 50);
+  field.AddCircle(200, 150, 30);
+  field.Build();
+  for (double x = 5; x < 400; x += 13) {
+    for (double y = 5; y < 300; y += 11) {
+      double exact = std::hypot(x - 200, y - 150) - 30;
+      exact = std::min(exact, std::min(std::min(x, 400 - x),
+                                       std::min(y, 300 - y)));
+      exact = std::max(std::min(exact, 50.0), -50.0);
+      EXPECT_NEAR(field.Distance(x, y), exact, 2.0) << x << "," << y;
+    }
+  }
+  // Away from the circle, toward +x, on its right
+  csci3081::Vector2 away = field.Gradient(240, 150);
+  EXPECT_NEAR(csci3081::RealToDouble(away.x), 1, 0.05);
+  EXPECT_NEAR(csci3081::RealToDouble(away.y), 0, 0.05);
+}
+
+// Updating around a change gives exactly what rebuilding would.
+TEST(DistanceField, IncrementalMatchesRebuild) {
+  csci3081::DistanceField incremental(300, 300, 3, 30);
+  csci3081::DistanceField rebuilt(300, 300, 3, 30);
+  incremental.AddCircle(100, 100, 20);
+  incremental.Build();
+  incremental.AddCircle(130, 120, 10);
+  incremental.AddCircle(250, 250, 15);
+  incremental.RemoveCircle(100, 100, 20);
+  rebuilt.AddCircle(130, 120, 10);
+  rebuilt.AddCircle(250, 250, 15);
+  rebuilt.Build();
+  for (double x = 0; x < 300; x += 1.5) {
+    for (double y = 0; y < 300; y += 1.5) {
+      ASSERT_EQ(incremental.Distance(x, y), rebuilt.Distance(x, y));
+    }
+  }
+}
+
+TEST(DistanceField, ArenaSpawnDespawn) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  csci3081::Arena arena(&aparams);
+  arena.EnableDistanceField(4, 64);
+  Position probe(600, 600);
+  double before = csci3081::RealToDouble(arena.DistanceToObstacle(probe));
+  csci3081::entity_handle h = arena.SpawnObstacle(10, Position(620, 600),
+                                                  csci3081::Color(0, 0, 0,
+                                                                  255));
+  EXPECT_NEAR(csci3081::RealToDouble(arena.DistanceToObstacle(probe)), 10,
+              4);
+  EXPECT_LT(csci3081::RealToDouble(arena.AwayFromObstacles(probe).x), 0);
+  ASSERT_TRUE(arena.Despawn(h));
+  EXPECT_EQ(csci3081::RealToDouble(arena.DistanceToObstacle(probe)), before);
+}
@@ -0,0 +1,55 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include "../src/arena.h"
+#include "../src/arena_defaults.h"
+#include "../src/arena_params.h"
+#include "../src/event_bus.h"
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Every subscriber sees the whole batch once, and the queue keeps its storage
+// for the next round.
+TEST(EventQueue, DispatchesBatches) {
+  csci3081::EventQueue<int> q;
+  int calls = 0;
+  int sum = 0;
+  q.Subscribe([&](const int * e, size_t n) {
+      ++calls;
+      for (size_t i = 0; i < n; ++i) sum += e[i];
+    });
+  q.Subscribe([&](const int *, size_t n) { EXPECT_EQ(n, 3u); });
+  q.Push(1);
+  q.Push(2);
+  q.Push(3);
+  size_t cap = q.capacity();
+  q.Dispatch();
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(sum, 6);
+  EXPECT_EQ(q.size(), 0u);
+  EXPECT_EQ(q.capacity(), cap) << "FAIL: Pooled storage released";
+  q.Dispatch();
+  EXPECT_EQ(calls, 1) << "FAIL: Empty queue dispatched";
+}
+
+// The arena queues one collision event per mobile entity each step, and a
+// key press only takes effect on the next step.
+TEST(EventBus, ArenaStep) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  aparams.home_base.seed = 1;
+  csci3081::Arena arena(&aparams);
+  size_t collisions = 0;
+  arena.event_bus().collisions().Subscribe(
+      [&](const csci3081::collision_record *, size_t n) { collisions += n; });
+
+  double speed = csci3081::RealToDouble(arena.robot()->get_speed());
+  csci3081::EventKeypress key(264);  // down key
+  arena.Accept(&key);
+  EXPECT_EQ(csci3081::RealToDouble(arena.robot()->get_speed()), speed);
+  arena.AdvanceTime();
+  EXPECT_EQ(collisions, 2u);
+  EXPECT_EQ(csci3081::RealToDouble(arena.robot()->get_speed()), speed - 1);
+}
@@ -0,0 +1,41 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include "../src/fixed_point.h"
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+TEST(Fixed, Arithmetic) {
+  csci3081::Fixed a(2.5);
+  csci3081::Fixed b(-4);
+  EXPECT_EQ(a.raw(), 5 * csci3081::Fixed::kOne / 2);
+  EXPECT_EQ(static_cast<double>(a * b), -10.0);
+  EXPECT_EQ((b / a).raw(), -104857)
+      << "FAIL: Quotient of -1.6 not truncated to 16 fraction bits";
+  EXPECT_EQ(static_cast<int>(a + b), -2);
+  EXPECT_TRUE(b < a);
+}
+
+TEST(Fixed, SqrtAndTrigAccuracy) {
+  for (double v = 0; v < 1e6; v += 97.3) {
+    EXPECT_NEAR(static_cast<double>(csci3081::FixedSqrt(v)), std::sqrt(v),
+                1e-4);
+  }
+  for (double d = -720; d < 720; d += 0.7) {
+    double rad = d * M_PI / 180;
+    EXPECT_NEAR(static_cast<double>(csci3081::FixedSinDeg(d)), std::sin(rad),
+                1e-4);
+    EXPECT_NEAR(static_cast<double>(csci3081::FixedCosDeg(d)), std::cos(rad),
+                1e-4);
+    double expected = std::atan2(std::sin(rad), std::cos(rad)) * 180 / M_PI;
+    expected = expected < 0 ? expected + 360 : expected;
+    double got = static_cast<double>(csci3081::FixedAtan2Deg(
+        300 * std::sin(rad), 300 * std::cos(rad)));
+    double err = std::fabs(got - expected);
+    EXPECT_LT(std::min(err, 360 - err), 1e-2);
+  }
+}
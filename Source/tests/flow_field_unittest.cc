@@ -0,0 +1,142 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <cmath>
+#include "../src/arena.h"
+#include "../src/arena_defaults.h"
+#include "../src/arena_params.h"
+#include "../src/flow_field.h"
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * Walk from (x, y) along the field, a unit at a time, until it gives no
+ * direction, and return the distance from there to (gx, gy). The walk must
+ * keep clear of the circle at (ox, oy) of radius r.
+ */
+static double Walk(const csci3081::FlowField& field, double x, double y,
+                   double gx, double gy, double ox, double oy, double r) {
+  for (int i = 0; i < 2000; ++i) {
+    csci3081::Vector2 dir = field.Direction(x, y);
+    if (dir.LengthSquared() == 0) {
+      break;
+    }
+    x += csci3081::RealToDouble(dir.x);
+    y += csci3081::RealToDouble(dir.y);
+    EXPECT_GT(std::hypot(x - ox, y - oy), r);
+  }
+  return std::hypot(x - gx, y - gy);
+}
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Directions lead around an obstacle in the way to the goal, both through
+// the window around the goal and from outside it.
+TEST(FlowField, AroundObstacle) {
+  csci3081::circle_batch obstacles;
+  obstacles.Push(100, 100, 20);
+  csci3081::flow_field_params fparams;
+  fparams.cell_size = 4;
+  fparams.clearance = 5;
+  fparams.window = 4;
+  csci3081::FlowField field(200, 200, obstacles, fparams);
+  field.Update(180, 100);
+  EXPECT_EQ(field.far_solves(), 1u);
+  EXPECT_EQ(field.near_solves(), 1u);
+  EXPECT_LT(Walk(field, 20, 100, 180, 100, 100, 100, 20), 6);
+  EXPECT_LT(Walk(field, 20, 20, 180, 100, 100, 100, 20), 6);
+  EXPECT_LT(Walk(field, 176, 96, 180, 100, 100, 100, 20), 6);
+}
+
+// A goal moving across the map is followed by leading the cell it left on to
+// the next, solving the window around it now and then, and the whole map
+// less often still.
+TEST(FlowField, MovingGoal) {
+  csci3081::circle_batch obstacles;
+  obstacles.Push(100, 100, 20);
+  csci3081::flow_field_params fparams;
+  fparams.cell_size = 4;
+  fparams.clearance = 5;
+  csci3081::FlowField field(200, 200, obstacles, fparams);
+  for (double gy = 20; gy <= 180; gy += 0.5) {
+    field.Update(150, gy);
+    EXPECT_LT(Walk(field, 20, 200 - gy, 150, gy, 100, 100, 20), 6);
+  }
+  EXPECT_GT(field.far_solves(), 1u);
+  EXPECT_LT(field.far_solves(), 10u);
+  // Once every few of the 41 cells the goal entered, and at most once more
+  // per new far field
+  EXPECT_GE(field.near_solves(), 41u / 9);
+  EXPECT_LE(field.near_solves(), 41u / 9 + field.far_solves());
+}
+
+// A goal that jumps out of the window, as at the start of a new game, has
+// the whole map solved toward it at once rather than a step later.
+TEST(FlowField, JumpingGoal) {
+  csci3081::circle_batch obstacles;
+  obstacles.Push(100, 100, 20);
+  csci3081::flow_field_params fparams;
+  fparams.cell_size = 4;
+  fparams.clearance = 5;
+  fparams.window = 4;
+  csci3081::FlowField field(200, 200, obstacles, fparams);
+  field.Update(180, 100);
+  field.Update(20, 100);
+  EXPECT_EQ(field.far_solves(), 2u);
+  EXPECT_LT(Walk(field, 180, 180, 20, 100, 100, 100, 20), 6);
+}
+
+// Robots on flow field autopilot reach the HomeBase and win.
+TEST(FlowField, AutopilotWins) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  aparams.home_base.seed = 5;
+  csci3081::Arena arena(&aparams);
+  arena.EnableAutopilot(arena.robot()->id(), csci3081::AUTOPILOT_HOME_BASE,
+                        csci3081::AUTOPILOT_FLOW);
+  bool won = false;
+  arena.event_bus().game_overs().Subscribe(
+      [&won](const csci3081::game_over_record * e, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+          won = won || e[i].event.won();
+        }
+      });
+  for (int step = 0; step < 2000 && !arena.getGameStatus(); ++step) {
+    arena.AdvanceTime();
+  }
+  EXPECT_TRUE(won);
+  EXPECT_NE(arena.flow_field(csci3081::AUTOPILOT_HOME_BASE), nullptr);
+  EXPECT_EQ(arena.flow_field(csci3081::AUTOPILOT_RECHARGE_STATION), nullptr);
+}
+
+// A field passed in the arena_params is used, game after game, instead of
+// each arena building its own.
+TEST(FlowField, SharedAcrossGames) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  aparams.home_base.seed = 5;
+  csci3081::circle_batch obstacles;
+  for (const csci3081::arena_entity_params& o : aparams.obstacles) {
+    obstacles.Push(csci3081::RealToDouble(o.pos.x),
+                   csci3081::RealToDouble(o.pos.y), o.radius);
+  }
+  csci3081::flow_field_params fparams;
+  fparams.clearance = aparams.robot.radius + aparams.robot.collision_delta +
+      1;
+  csci3081::FlowField shared(aparams.x_dim, aparams.y_dim, obstacles,
+                             fparams);
+  aparams.flow_field = &shared;
+  for (int game = 0; game < 2; ++game) {
+    csci3081::Arena arena(&aparams);
+    arena.EnableAutopilot(arena.robot()->id(), csci3081::AUTOPILOT_HOME_BASE,
+                          csci3081::AUTOPILOT_FLOW);
+    for (int step = 0; step < 2000 && !arena.getGameStatus(); ++step) {
+      arena.AdvanceTime();
+    }
+    EXPECT_TRUE(arena.getGameStatus());
+    EXPECT_EQ(arena.flow_field(csci3081::AUTOPILOT_HOME_BASE), &shared);
+  }
+}
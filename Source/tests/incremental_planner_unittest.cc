@@ -0,0 +1,116 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "../src/arena.h"
+#include "../src/arena_defaults.h"
+#include "../src/arena_params.h"
+#include "../src/incremental_planner.h"
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Repaired paths are as short as those planned from scratch while the start,
+// the goal and the obstacles all move, and take fewer expansions.
+TEST(IncrementalPlanner, MatchesFullReplanning) {
+  std::minstd_rand generator(3);
+  std::uniform_real_distribution<double> unit(0, 1);
+  csci3081::circle_batch obstacles;
+  for (int i = 0; i < 60; ++i) {
+    obstacles.Push(unit(generator) * 400, unit(generator) * 300,
+                   5 + unit(generator) * 15);
+  }
+  csci3081::incremental_planner_params pparams;
+  pparams.cell_size = 4;
+  pparams.clearance = 4;
+  csci3081::IncrementalPlanner incremental(400, 300, obstacles, pparams);
+  csci3081::IncrementalPlanner full(400, 300, obstacles, pparams);
+
+  double sx = 10, sy = 10, gx = 390, gy = 290;
+  std::vector<Position> path;
+  std::vector<Position> full_path;
+  int found = 0;
+  for (int step = 0; step < 500; ++step) {
+    if (step % 50 == 25) {
+      size_t i = generator() % obstacles.size();
+      incremental.RemoveObstacle(obstacles.x[i], obstacles.y[i],
+                                 obstacles.r[i]);
+      full.RemoveObstacle(obstacles.x[i], obstacles.y[i], obstacles.r[i]);
+      obstacles.x[i] = unit(generator) * 400;
+      obstacles.y[i] = unit(generator) * 300;
+      incremental.AddObstacle(obstacles.x[i], obstacles.y[i], obstacles.r[i]);
+      full.AddObstacle(obstacles.x[i], obstacles.y[i], obstacles.r[i]);
+    }
+    gx = std::min(399.0, std::max(1.0, gx + (unit(generator) - 0.5) * 20));
+    gy = std::min(299.0, std::max(1.0, gy + (unit(generator) - 0.5) * 20));
+    bool ok = incremental.FindPath(Position(sx, sy), Position(gx, gy), &path);
+    full.Reset();
+    ASSERT_EQ(ok, full.FindPath(Position(sx, sy), Position(gx, gy),
+                                &full_path));
+    if (!ok) {
+      sx = unit(generator) * 400;
+      sy = unit(generator) * 300;
+      continue;
+    }
+    ++found;
+    ASSERT_NEAR(incremental.path_cost(), full.path_cost(), 1e-9);
+    for (const Position& p : path) {
+      EXPECT_FALSE(incremental.Blocked(csci3081::RealToDouble(p.x),
+                                       csci3081::RealToDouble(p.y)));
+    }
+    // Move the start a little way along the path
+    double dx = csci3081::RealToDouble(path[0].x) - sx;
+    double dy = csci3081::RealToDouble(path[0].y) - sy;
+    double d = std::hypot(dx, dy);
+    if (d > 0) {
+      sx += dx / d * std::min(d, 3.0);
+      sy += dy / d * std::min(d, 3.0);
+    }
+  }
+  EXPECT_GT(found, 100);
+  EXPECT_LT(incremental.expansions(), full.expansions() / 2);
+}
+
+// A goal walled in by obstacles cannot be reached, and one that is let out
+// again can.
+TEST(IncrementalPlanner, Unreachable) {
+  csci3081::circle_batch ring;
+  for (int k = 0; k < 12; ++k) {
+    double a = 2 * M_PI * k / 12;
+    ring.Push(100 + 40 * std::cos(a), 100 + 40 * std::sin(a), 12);
+  }
+  csci3081::incremental_planner_params pparams;
+  pparams.cell_size = 4;
+  csci3081::IncrementalPlanner planner(200, 200, ring, pparams);
+  std::vector<Position> path;
+  EXPECT_FALSE(planner.FindPath(Position(10, 10), Position(100, 100), &path));
+  EXPECT_TRUE(path.empty());
+  planner.RemoveObstacle(ring.x[0], ring.y[0], ring.r[0]);
+  ASSERT_TRUE(planner.FindPath(Position(10, 10), Position(100, 100), &path));
+  EXPECT_EQ(path.back(), Position(100, 100));
+  EXPECT_GT(planner.path_cost(), std::hypot(90, 90));
+}
+
+// Tracking the HomeBase, the robot reaches it and wins.
+TEST(IncrementalPlanner, AutopilotWins) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  aparams.home_base.seed = 5;
+  csci3081::Arena arena(&aparams);
+  arena.EnableAutopilot(arena.robot()->id(), csci3081::AUTOPILOT_HOME_BASE,
+                        csci3081::AUTOPILOT_TRACK);
+  bool won = false;
+  arena.event_bus().game_overs().Subscribe(
+      [&won](const csci3081::game_over_record * e, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+          won = won || e[i].event.won();
+        }
+      });
+  for (int step = 0; step < 2000 && !arena.getGameStatus(); ++step) {
+    arena.AdvanceTime();
+  }
+  EXPECT_TRUE(won);
+}
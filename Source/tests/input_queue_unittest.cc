@@ -0,0 +1,106 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../src/arena.h"
+#include "../src/arena_defaults.h"
+#include "../src/arena_params.h"
+#include "../src/input_queue.h"
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Inputs change nothing until the next step, which applies them to the
+// player's robot just as Accept() would.
+TEST(InputQueue, AppliesAtStepBoundary) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  csci3081::Arena arena(&aparams);
+  csci3081::Arena direct(&aparams);
+  csci3081::InputQueue queue;
+  arena.input_queue(&queue);
+
+  double heading = arena.robot()->get_heading_angle();
+  ASSERT_TRUE(queue.Push(csci3081::kNoEntity, csci3081::COM_TURN_LEFT));
+  ASSERT_TRUE(queue.Push(csci3081::kNoEntity, csci3081::COM_SPEED_UP));
+  EXPECT_EQ(arena.robot()->get_heading_angle(), heading);
+  arena.AdvanceTime();
+  csci3081::EventKeypress left(263);
+  csci3081::EventKeypress up(265);
+  direct.Accept(&left);
+  direct.Accept(&up);
+  direct.AdvanceTime();
+  EXPECT_EQ(arena.robot()->get_heading_angle(),
+            direct.robot()->get_heading_angle());
+  EXPECT_EQ(arena.robot()->get_pos().x, direct.robot()->get_pos().x);
+  EXPECT_EQ(arena.robot()->get_pos().y, direct.robot()->get_pos().y);
+
+  EXPECT_EQ(queue.latency().applied, 2u);
+  EXPECT_GE(queue.latency().max_ns * 2, queue.latency().total_ns);
+  arena.AdvanceTime();
+  EXPECT_EQ(queue.latency().applied, 2u);
+}
+
+// A full queue turns inputs away instead of blocking.
+TEST(InputQueue, DropsWhenFull) {
+  csci3081::InputQueue queue;
+  for (int i = 0; i < INPUT_QUEUE_CAPACITY; ++i) {
+    ASSERT_TRUE(queue.Push(0, csci3081::COM_NONE));
+  }
+  EXPECT_FALSE(queue.Push(0, csci3081::COM_NONE));
+  EXPECT_EQ(queue.dropped(), 1u);
+  EXPECT_EQ(queue.Drain([](const csci3081::input_record&) {}),
+            static_cast<size_t>(INPUT_QUEUE_CAPACITY));
+  EXPECT_TRUE(queue.Push(0, csci3081::COM_NONE));
+}
+
+// Producers racing each other and the consumer lose nothing they were not
+// told about, and each one's inputs arrive in the order it pushed them.
+TEST(InputQueue, ManyProducers) {
+  const int n_producers = 4;
+  const uint64_t n_each = 20000;
+  csci3081::InputQueue queue;
+  std::atomic<int> running(n_producers);
+  std::vector<uint64_t> pushed(n_producers, 0);
+  std::vector<std::thread> producers;
+  for (int p = 0; p < n_producers; ++p) {
+    producers.emplace_back([&, p]() {
+        for (uint64_t i = 0; i < n_each; ++i) {
+          // The stamp stands in for a sequence number here
+          if (queue.Push(csci3081::input_record {
+                  static_cast<csci3081::entity_id>(p),
+                  csci3081::COM_NONE, i + 1})) {
+            ++pushed[p];
+          }
+        }
+        --running;
+      });
+  }
+
+  std::vector<uint64_t> received(n_producers, 0);
+  std::vector<uint64_t> last(n_producers, 0);
+  bool ordered = true;
+  auto take = [&](const csci3081::input_record& r) {
+    ordered = ordered && r.input_ns > last[r.target];
+    last[r.target] = r.input_ns;
+    ++received[r.target];
+  };
+  while (running.load() > 0) {
+    queue.Drain(take);
+  }
+  for (std::thread& t : producers) {
+    t.join();
+  }
+  queue.Drain(take);
+
+  EXPECT_TRUE(ordered);
+  uint64_t total = 0;
+  for (int p = 0; p < n_producers; ++p) {
+    EXPECT_EQ(received[p], pushed[p]);
+    total += pushed[p];
+  }
+  EXPECT_EQ(total + queue.dropped(), n_producers * n_each);
+}
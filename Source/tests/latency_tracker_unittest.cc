@@ -0,0 +1,75 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include "../src/arena.h"
+#include "../src/arena_defaults.h"
+#include "../src/arena_params.h"
+#include "../src/input_queue.h"
+#include "../src/latency_tracker.h"
+#include "../src/trace.h"
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Percentiles are by nearest rank over the newest samples only.
+TEST(LatencyTracker, WindowPercentiles) {
+  csci3081::LatencyWindow window(10);
+  EXPECT_EQ(window.Percentile(50), 0u);
+  for (uint64_t i = 10; i >= 1; --i) {
+    window.Add(i);
+  }
+  EXPECT_EQ(window.Percentile(50), 5u);
+  EXPECT_EQ(window.Percentile(90), 9u);
+  EXPECT_EQ(window.Percentile(100), 10u);
+  EXPECT_EQ(window.Percentile(0), 1u);
+  for (uint64_t i = 11; i <= 20; ++i) {
+    window.Add(i);
+  }
+  EXPECT_EQ(window.size(), 10u);
+  EXPECT_EQ(window.Percentile(50), 15u);
+}
+
+// An input is timed to its step when the arena drains it, and to the
+// screen by the first frame drawn after that step has finished.
+TEST(LatencyTracker, FollowsInputsToFrame) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  csci3081::Arena arena(&aparams);
+  csci3081::InputQueue queue;
+  csci3081::InputLatencyTracker tracker;
+  FILE * log = tmpfile();
+  ASSERT_NE(log, nullptr);
+  tracker.log(log);
+  arena.input_queue(&queue);
+  queue.latency_tracker(&tracker);
+
+  uint64_t input_ns = csci3081::Tracer::NowNs() - 1000000;
+  ASSERT_TRUE(queue.Push(csci3081::input_record {
+      csci3081::kNoEntity, csci3081::COM_TURN_LEFT, input_ns}));
+  tracker.FramePresented(csci3081::Tracer::NowNs());
+  EXPECT_EQ(tracker.n_presented(), 0u);
+
+  arena.AdvanceTime();
+  ASSERT_EQ(tracker.to_step().size(), 1u);
+  EXPECT_GE(tracker.to_step().Percentile(50), 1000000u);
+  // Drawn while the step was still running, were the two on two threads
+  tracker.FramePresented(csci3081::Tracer::NowNs());
+  EXPECT_EQ(tracker.n_presented(), 0u);
+
+  tracker.StepDone();
+  uint64_t presented_ns = csci3081::Tracer::NowNs();
+  tracker.FramePresented(presented_ns);
+  EXPECT_EQ(tracker.n_presented(), 1u);
+  EXPECT_EQ(tracker.to_frame().Percentile(50), presented_ns - input_ns);
+  tracker.FramePresented(csci3081::Tracer::NowNs());
+  EXPECT_EQ(tracker.n_presented(), 1u);
+
+  rewind(log);
+  double to_step_us = 0, to_frame_us = 0;
+  ASSERT_EQ(fscanf(log, "%lf,%lf", &to_step_us, &to_frame_us), 2);
+  EXPECT_GE(to_step_us, 1000.0);
+  EXPECT_GE(to_frame_us, to_step_us);
+  fclose(log);
+}
@@ -0,0 +1,159 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "../src/arena.h"
+#include "../src/arena_defaults.h"
+#include "../src/arena_params.h"
+#include "../src/occupancy_patch.h"
+#include "../src/vec_arena.h"
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Every cell holds the bits of exactly the circles covering its center, and
+// the wall bit exactly when its center is outside, whichever way the robot
+// faces.
+TEST(PatchRasterizer, MatchesPointTests) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  std::minstd_rand0 generator(5);
+  std::uniform_real_distribution<double> unit(0, 1);
+  for (int i = 0; i < 60; ++i) {
+    csci3081::robot_params r = aparams.robot;
+    r.radius = 5 + unit(generator) * 15;
+    r.pos = Position(unit(generator) * aparams.x_dim,
+                     unit(generator) * aparams.y_dim);
+    aparams.extra_robots.push_back(r);
+    csci3081::arena_entity_params o = aparams.obstacles[0];
+    o.radius = 5 + unit(generator) * 30;
+    o.pos = Position(unit(generator) * aparams.x_dim,
+                     unit(generator) * aparams.y_dim);
+    aparams.obstacles.push_back(o);
+  }
+  csci3081::Arena arena(&aparams);
+  csci3081::Registry& registry = arena.registry();
+  const csci3081::ComponentPool<csci3081::transform>& bodies =
+      registry.transform_pool();
+
+  csci3081::patch_params params;
+  params.size = 24;
+  params.cell_size = 7;
+  csci3081::PatchRasterizer rasterizer;
+  std::vector<uint8_t> patch(params.size * params.size);
+  const std::vector<csci3081::entity_id>& robots =
+      registry.of_kind(csci3081::KIND_ROBOT);
+  for (csci3081::entity_id e : robots) {
+    csci3081::Robot robot(&registry, e);
+    robot.set_heading_angle(unit(generator) * 360);
+    rasterizer.Render(arena, e, params, patch.data());
+
+    double px = csci3081::RealToDouble(robot.get_pos().x);
+    double py = csci3081::RealToDouble(robot.get_pos().y);
+    double angle = robot.get_heading_angle() * M_PI / 180;
+    double hx = std::cos(angle);
+    double hy = std::sin(angle);
+    double center = params.size * 0.5 - 0.5;
+    for (size_t row = 0; row < params.size; ++row) {
+      for (size_t col = 0; col < params.size; ++col) {
+        double ahead = (center - row) * params.cell_size;
+        double right = (col - center) * params.cell_size;
+        double x = px + ahead * hx - right * hy;
+        double y = py + ahead * hy + right * hx;
+        uint8_t expected = 0;
+        bool borderline = false;
+        if (x < 0 || y < 0 || x > aparams.x_dim || y > aparams.y_dim) {
+          expected |= csci3081::kPatchWall;
+        }
+        borderline = std::fabs(x) < 1e-6 || std::fabs(y) < 1e-6 ||
+            std::fabs(x - aparams.x_dim) < 1e-6 ||
+            std::fabs(y - aparams.y_dim) < 1e-6;
+        for (size_t i = 0; i < bodies.size(); ++i) {
+          csci3081::entity_id other = bodies.owners()[i];
+          if (other == e) {
+            continue;
+          }
+          double d = std::hypot(
+              csci3081::RealToDouble(bodies.data()[i].pos.x) - x,
+              csci3081::RealToDouble(bodies.data()[i].pos.y) - y);
+          double r = csci3081::RealToDouble(bodies.data()[i].radius);
+          if (d <= r) {
+            expected |= csci3081::KindBit(registry.kind(other));
+          }
+          borderline = borderline || std::fabs(d - r) < 1e-6;
+        }
+        if (!borderline) {
+          ASSERT_EQ(patch[row * params.size + col], expected)
+              << "robot " << e << " row " << row << " col " << col;
+        }
+      }
+    }
+  }
+}
+
+// Row 0 is ahead of the robot and columns run from its left to its right.
+TEST(PatchRasterizer, Orientation) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  aparams.obstacles.clear();
+  aparams.robot.pos = Position(500, 400);
+  csci3081::arena_entity_params o;
+  o.radius = 10;
+  o.pos = Position(540, 400);
+  aparams.obstacles.push_back(o);
+  csci3081::Arena arena(&aparams);
+  csci3081::Robot * robot = arena.robot();
+
+  csci3081::patch_params params;
+  params.size = 16;
+  params.cell_size = 8;
+  params.kinds = csci3081::KindBit(csci3081::KIND_OBSTACLE);
+  csci3081::PatchRasterizer rasterizer;
+  std::vector<uint8_t> patch(params.size * params.size);
+  uint8_t bit = csci3081::KindBit(csci3081::KIND_OBSTACLE);
+
+  // Facing +x, the obstacle is 5 cells dead ahead
+  robot->set_heading_angle(0);
+  rasterizer.Render(arena, robot->id(), params, patch.data());
+  EXPECT_EQ(patch[2 * 16 + 7], bit);
+  EXPECT_EQ(patch[2 * 16 + 8], bit);
+  EXPECT_EQ(patch[13 * 16 + 7], 0);
+
+  // Facing +y (down the screen), +x is to the robot's left
+  robot->set_heading_angle(90);
+  rasterizer.Render(arena, robot->id(), params, patch.data());
+  EXPECT_EQ(patch[7 * 16 + 2], bit);
+  EXPECT_EQ(patch[8 * 16 + 2], bit);
+  EXPECT_EQ(patch[7 * 16 + 13], 0);
+}
+
+// VecArena lays out each environment's robots' patches one after another,
+// as RenderAll() draws them.
+TEST(PatchRasterizer, VecArenaLayout) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  csci3081::robot_params r = aparams.robot;
+  r.pos = Position(300, 300);
+  aparams.extra_robots.push_back(r);
+  csci3081::vec_arena_params vparams;
+  vparams.n_envs = 3;
+  vparams.n_threads = 2;
+  csci3081::VecArena envs(&aparams, vparams);
+  envs.env(1).robot()->set_heading_angle(45);
+  envs.env(2).robot()->set_pos(Position(100, 100));
+
+  csci3081::patch_params params;
+  const size_t per_robot = params.size * params.size;
+  std::vector<uint8_t> all(3 * 2 * per_robot);
+  envs.RenderPatches(params, all.data());
+  csci3081::PatchRasterizer rasterizer;
+  std::vector<uint8_t> one(2 * per_robot);
+  for (size_t i = 0; i < 3; ++i) {
+    rasterizer.RenderAll(envs.env(i), params, one.data());
+    EXPECT_TRUE(std::equal(one.begin(), one.end(),
+                           all.begin() + i * 2 * per_robot));
+  }
+}
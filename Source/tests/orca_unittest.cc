@@ -0,0 +1,185 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+#include "../src/arena.h"
+#include "../src/arena_defaults.h"
+#include "../src/arena_params.h"
+#include "../src/orca.h"
+#include "../src/spatial_grid.h"
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Nearest() finds what checking every circle finds, in the same order.
+TEST(SpatialGrid, NearestMatchesScan) {
+  std::minstd_rand0 generator(3);
+  std::uniform_real_distribution<double> unit(0, 1);
+  csci3081::circle_batch circles;
+  for (int i = 0; i < 500; ++i) {
+    circles.Push(unit(generator) * 400, unit(generator) * 300, 5);
+  }
+  csci3081::SpatialGrid grid;
+  grid.Build(circles, 400, 300, 32);
+  EXPECT_EQ(grid.size(), 500u);
+
+  uint32_t items[8];
+  double distances[8];
+  for (int q = 0; q < 100; ++q) {
+    double x = unit(generator) * 440 - 20;
+    double y = unit(generator) * 340 - 20;
+    std::vector<std::pair<double, uint32_t> > all;
+    for (uint32_t i = 0; i < circles.size(); ++i) {
+      double d = std::hypot(circles.x[i] - x, circles.y[i] - y);
+      if (d <= 60 && i != 7) {
+        all.push_back(std::make_pair(d, i));
+      }
+    }
+    std::sort(all.begin(), all.end());
+    size_t n = grid.Nearest(x, y, 60, 8, items, distances, 7);
+    ASSERT_EQ(n, std::min<size_t>(8, all.size()));
+    for (size_t i = 0; i < n; ++i) {
+      EXPECT_EQ(items[i], all[i].second);
+      EXPECT_NEAR(distances[i], all[i].first, 1e-9);
+    }
+  }
+}
+
+// Moving some circles and sorting only those again finds what sorting them
+// all does.
+TEST(SpatialGrid, RebinMatchesBuild) {
+  std::minstd_rand0 generator(5);
+  std::uniform_real_distribution<double> unit(0, 1);
+  csci3081::circle_batch circles;
+  std::vector<uint32_t> movers;
+  for (uint32_t i = 0; i < 300; ++i) {
+    circles.Push(unit(generator) * 400, unit(generator) * 300,
+                 i % 3 ? 5 : 20);
+    if (i % 4 == 0) {
+      movers.push_back(i);
+    }
+  }
+  csci3081::SpatialGrid moving;
+  moving.Build(circles, 400, 300, 32, &movers);
+  for (uint32_t i : movers) {
+    circles.x[i] = unit(generator) * 400;
+    circles.y[i] = unit(generator) * 300;
+  }
+  moving.Rebin(circles);
+  csci3081::SpatialGrid full;
+  full.Build(circles, 400, 300, 32);
+  EXPECT_EQ(moving.size(), full.size());
+
+  uint32_t a[8], b[8];
+  double da[8], db[8];
+  for (int q = 0; q < 100; ++q) {
+    double x = unit(generator) * 400;
+    double y = unit(generator) * 300;
+    size_t n = moving.Nearest(x, y, 80, 8, a, da);
+    ASSERT_EQ(n, full.Nearest(x, y, 80, 8, b, db));
+    for (size_t i = 0; i < n; ++i) {
+      EXPECT_EQ(a[i], b[i]);
+    }
+  }
+}
+
+// Two columns of agents walking through each other to swap sides all get
+// there without ever overlapping.
+TEST(Orca, CrossingGroups) {
+  const int n = 20;
+  const double radius = 10;
+  std::vector<double> x(n), y(n), gx(n), gy(n);
+  for (int i = 0; i < n; ++i) {
+    int side = i % 2;
+    x[i] = side ? 350 : 50;
+    y[i] = 50 + (i / 2) * 30 + side * 12;
+    gx[i] = 400 - x[i];
+    gy[i] = y[i];
+  }
+  csci3081::orca_params params;
+  csci3081::circle_batch circles;
+  csci3081::orca_bodies bodies;
+  csci3081::SpatialGrid grid;
+  std::vector<csci3081::orca_agent> agents(n);
+  std::vector<double> vx(n, 0), vy(n, 0);
+  for (int step = 0; step < 1000; ++step) {
+    circles.Clear();
+    bodies.Clear();
+    for (int i = 0; i < n; ++i) {
+      circles.Push(x[i], y[i], radius);
+      bodies.Push(vx[i], vy[i], true);
+      double dx = gx[i] - x[i];
+      double dy = gy[i] - y[i];
+      double d = std::hypot(dx, dy);
+      double s = d > 2 ? 2 / d : 1;
+      agents[i] = csci3081::orca_agent {static_cast<uint32_t>(i), dx * s,
+                                        dy * s, 2, 0, 0, 0};
+    }
+    grid.Build(circles, 400, 400, 32);
+    csci3081::SolveOrca(params, circles, bodies, grid, nullptr, &agents);
+    for (int i = 0; i < n; ++i) {
+      vx[i] = agents[i].vx;
+      vy[i] = agents[i].vy;
+      x[i] += vx[i];
+      y[i] += vy[i];
+    }
+    for (int i = 0; i < n; ++i) {
+      for (int j = i + 1; j < n; ++j) {
+        ASSERT_GT(std::hypot(x[i] - x[j], y[i] - y[j]), 2 * radius - 1e-3)
+            << "step " << step;
+      }
+    }
+  }
+  for (int i = 0; i < n; ++i) {
+    EXPECT_LT(std::hypot(gx[i] - x[i], gy[i] - y[i]), 1);
+  }
+}
+
+// Two robots driving at each other pass without colliding, and neither's
+// heading is changed by avoiding the other.
+TEST(Orca, ArenaHeadOn) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  aparams.home_base.seed = 1;
+  csci3081::robot_params r = aparams.robot;
+  r.pos = Position(100, 700);
+  aparams.extra_robots.push_back(r);
+  r.pos = Position(400, 700);
+  aparams.extra_robots.push_back(r);
+  csci3081::Arena arena(&aparams);
+  const std::vector<csci3081::entity_id>& robots =
+      arena.registry().of_kind(csci3081::KIND_ROBOT);
+  ASSERT_EQ(robots.size(), 3u);
+  csci3081::Robot a(&arena.registry(), robots[1]);
+  csci3081::Robot b(&arena.registry(), robots[2]);
+  a.set_heading_angle(0);
+  b.set_heading_angle(180);
+  a.set_speed(5);
+  b.set_speed(5);
+  arena.EnableAvoidance(a.id());
+  arena.EnableAvoidance(b.id());
+
+  int hits = 0;
+  arena.event_bus().collisions().Subscribe(
+      [&](const csci3081::collision_record * e, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+          if ((e[i].target == a.id() || e[i].target == b.id()) &&
+              e[i].event.collided()) {
+            ++hits;
+          }
+        }
+      });
+  for (int step = 0; step < 50; ++step) {
+    arena.AdvanceTime();
+  }
+  EXPECT_EQ(hits, 0);
+  EXPECT_GT(csci3081::RealToDouble(a.get_pos().x), 300);
+  EXPECT_LT(csci3081::RealToDouble(b.get_pos().x), 200);
+  EXPECT_NEAR(a.get_heading_angle(), 0, 1e-6);
+  EXPECT_NEAR(b.get_heading_angle(), 180, 1e-6);
+}
@@ -0,0 +1,53 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include "../src/perf_counters.h"
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+TEST(PerfCounterGroup, UnopenedReadsZero) {
+  csci3081::PerfCounterGroup g;
+  EXPECT_FALSE(g.available());
+  struct csci3081::perf_sample s;
+  s.value[csci3081::PERF_CYCLES] = 42;
+  g.Read(&s);
+  EXPECT_EQ(s.value[csci3081::PERF_CYCLES], 0u);
+}
+
+TEST(PerfCounterGroup, CountsWhenAvailable) {
+  csci3081::PerfCounterGroup g;
+  if (!g.Open()) {
+    return;  // No PMU access on this machine (VM, perf_event_paranoid).
+  }
+  struct csci3081::perf_sample before, after;
+  g.Read(&before);
+  volatile double x = 0;
+  for (int i = 0; i < 100000; ++i) {
+    x = x + i;
+  }
+  g.Read(&after);
+  if (g.supported(csci3081::PERF_INSTRUCTIONS)) {
+    EXPECT_GT(after.value[csci3081::PERF_INSTRUCTIONS],
+              before.value[csci3081::PERF_INSTRUCTIONS] + 100000);
+  }
+}
+
+TEST(PerfPhaseProfiler, AccumulatesSteps) {
+  csci3081::PerfPhaseProfiler p;
+  p.Open();
+  for (int step = 0; step < 3; ++step) {
+    p.BeginStep();
+    for (int phase = 0; phase < csci3081::PHASE_N_PHASES; ++phase) {
+      p.EndPhase(static_cast<enum csci3081::sim_phase>(phase));
+    }
+  }
+  EXPECT_EQ(p.n_steps(), 3u);
+  for (int phase = 0; phase < csci3081::PHASE_N_PHASES; ++phase) {
+    enum csci3081::sim_phase ph = static_cast<enum csci3081::sim_phase>(phase);
+    for (int i = 0; i < csci3081::PERF_N_COUNTERS; ++i) {
+      EXPECT_GE(p.totals(ph).value[i], p.last_step(ph).value[i]);
+    }
+  }
+}
@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include "../src/arena.h"
+#include "../src/arena_defaults.h"
+#include "../src/arena_params.h"
+#include "../src/registry.h"
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Removing a component moves the last one into its slot and keeps the
+// entity -> component mapping of the moved one intact.
+TEST(ComponentPool, SwapRemove) {
+  csci3081::ComponentPool<int> pool;
+  pool.Add(4, 40);
+  pool.Add(7, 70);
+  pool.Add(9, 90);
+  pool.Remove(4);
+  EXPECT_EQ(pool.size(), 2u);
+  EXPECT_FALSE(pool.Has(4));
+  EXPECT_EQ(pool.Find(4), nullptr);
+  EXPECT_EQ(pool.Get(7), 70);
+  EXPECT_EQ(pool.Get(9), 90);
+  EXPECT_EQ(pool.owners()[0], 9u) << "FAIL: Last component not moved in";
+  EXPECT_EQ(pool.data()[0], 90);
+  pool.Remove(4);
+  EXPECT_EQ(pool.size(), 2u) << "FAIL: Removing an absent entity";
+}
+
+// Entities of a kind are listed in creation order; only mobile ones have
+// kinematics.
+TEST(Registry, ArenaKinds) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  aparams.home_base.seed = 1;
+  csci3081::Arena arena(&aparams);
+  const csci3081::Registry& reg = arena.registry();
+
+  EXPECT_EQ(arena.obstacles().size(), aparams.obstacles.size());
+  EXPECT_EQ(arena.recharge_stations().size(), 1u);
+  EXPECT_EQ(reg.of_kind(csci3081::KIND_ROBOT).size(), 1u);
+  EXPECT_EQ(reg.n_entities(), aparams.obstacles.size() + 3);
+  EXPECT_EQ(reg.kinematics_pool().size(), 2u);
+  EXPECT_EQ(reg.transform_pool().size(), reg.n_entities());
+  EXPECT_TRUE(arena.robot()->is_mobile());
+
+  csci3081::Obstacle o(&arena.registry(), arena.obstacles()[0]);
+  EXPECT_FALSE(o.is_mobile());
+  EXPECT_EQ(o.get_radius(), aparams.obstacles[0].radius);
+  EXPECT_EQ(o.name(), "Obstacle" + std::to_string(o.id()));
+}
+
+// A destroyed entity's id is reused, and handles to the old one go stale.
+TEST(Registry, StaleHandles) {
+  csci3081::Registry reg;
+  csci3081::entity_id a = reg.Create(csci3081::KIND_OBSTACLE);
+  csci3081::entity_id b = reg.Create(csci3081::KIND_OBSTACLE);
+  reg.transform_pool().Add(a, csci3081::transform {Position(), 1});
+  csci3081::entity_handle ha = reg.handle(a);
+
+  EXPECT_TRUE(reg.Destroy(a));
+  EXPECT_FALSE(reg.Destroy(a)) << "FAIL: Destroyed twice";
+  EXPECT_FALSE(reg.Valid(ha));
+  EXPECT_FALSE(reg.transform_pool().Has(a));
+  ASSERT_EQ(reg.of_kind(csci3081::KIND_OBSTACLE).size(), 1u);
+  EXPECT_EQ(reg.of_kind(csci3081::KIND_OBSTACLE)[0], b);
+
+  csci3081::entity_id c = reg.Create(csci3081::KIND_ROBOT);
+  EXPECT_EQ(c, a) << "FAIL: Free slot not reused";
+  EXPECT_FALSE(reg.Valid(ha)) << "FAIL: Old handle names the new entity";
+  EXPECT_TRUE(reg.Valid(reg.handle(c)));
+  EXPECT_EQ(reg.n_entities(), 2u);
+}
+
+// Spawned entities take part in the step; the game's own entities cannot be
+// despawned.
+TEST(Registry, ArenaSpawnDespawn) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  aparams.home_base.seed = 1;
+  csci3081::Arena arena(&aparams);
+
+  Position pos(100, 100);
+  csci3081::entity_handle h = arena.SpawnObstacle(10, pos,
+                                                  csci3081::Color());
+  EXPECT_EQ(arena.n_obstacles(), aparams.obstacles.size() + 1);
+  csci3081::entity_handle r = arena.SpawnRobot(&aparams.robot);
+  EXPECT_EQ(arena.n_robots(), 2u);
+  arena.AdvanceTime();
+
+  EXPECT_TRUE(arena.Despawn(h));
+  EXPECT_FALSE(arena.Despawn(h)) << "FAIL: Stale handle accepted";
+  EXPECT_TRUE(arena.Despawn(r));
+  EXPECT_EQ(arena.n_obstacles(), aparams.obstacles.size());
+  EXPECT_EQ(arena.n_robots(), 1u);
+  EXPECT_FALSE(arena.Despawn(
+      arena.registry().handle(arena.robot()->id())));
+  arena.AdvanceTime();
+}
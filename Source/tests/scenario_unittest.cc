@@ -0,0 +1,157 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <cmath>
+#include <string>
+#include "../src/arena_defaults.h"
+#include "../src/arena_params.h"
+#include "../src/scenario.h"
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+static void WriteFile(const char * path, const char * text) {
+  FILE * f = fopen(path, "w");
+  ASSERT_TRUE(f != nullptr);
+  fputs(text, f);
+  fclose(f);
+}
+
+static void ExpectSameArena(const csci3081::arena_params& a,
+                            const csci3081::arena_params& b) {
+  EXPECT_EQ(a.x_dim, b.x_dim);
+  EXPECT_EQ(a.y_dim, b.y_dim);
+  EXPECT_EQ(a.robot.pos, b.robot.pos);
+  EXPECT_EQ(a.robot.battery_max_charge, b.robot.battery_max_charge);
+  EXPECT_EQ(a.robot.angle_delta, b.robot.angle_delta);
+  EXPECT_EQ(a.home_base.pos, b.home_base.pos);
+  EXPECT_EQ(a.home_base.seed, b.home_base.seed);
+  EXPECT_EQ(a.recharge_station.color.g, b.recharge_station.color.g);
+  ASSERT_EQ(a.obstacles.size(), b.obstacles.size());
+  for (size_t i = 0; i < a.obstacles.size(); ++i) {
+    EXPECT_EQ(a.obstacles[i].pos, b.obstacles[i].pos);
+    EXPECT_EQ(a.obstacles[i].radius, b.obstacles[i].radius);
+  }
+  EXPECT_EQ(a.extra_robots.size(), b.extra_robots.size());
+  EXPECT_EQ(a.extra_recharge_stations.size(),
+            b.extra_recharge_stations.size());
+}
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// The default arena survives a trip through both file forms.
+TEST(Scenario, RoundTrip) {
+  csci3081::arena_params defaults;
+  csci3081::DefaultArenaParams(&defaults);
+  defaults.home_base.seed = 7;
+  defaults.extra_robots.push_back(defaults.robot);
+  std::string error;
+
+  const char * text = "/tmp/scenario_unittest.scn";
+  ASSERT_TRUE(csci3081::SaveScenarioText(text, defaults, &error)) << error;
+  csci3081::arena_params loaded;
+  ASSERT_TRUE(csci3081::LoadScenario(text, &loaded, &error)) << error;
+  ExpectSameArena(defaults, loaded);
+
+  const char * binary = "/tmp/scenario_unittest.scnb";
+  ASSERT_TRUE(csci3081::SaveScenarioBinary(binary, loaded, &error)) << error;
+  csci3081::arena_params compiled;
+  ASSERT_TRUE(csci3081::LoadScenario(binary, &compiled, &error)) << error;
+  ExpectSameArena(defaults, compiled);
+}
+
+// Mistakes are reported with their line, and leave the parameters alone.
+TEST(Scenario, Errors) {
+  const char * path = "/tmp/scenario_unittest_bad.scn";
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  std::string error;
+
+  WriteFile(path, "arena 100 100\n# comment\nobstacle 1 2 3 255 255 255\n");
+  EXPECT_FALSE(csci3081::LoadScenario(path, &aparams, &error));
+  EXPECT_EQ(error, std::string(path) + ":3: malformed fields");
+
+  WriteFile(path, "arena 100 100\nrobot 1 2 3 0 0 0 255 1 100 10\n"
+            "home_base 5 5 3 0 0 0 255 0\n");
+  EXPECT_FALSE(csci3081::LoadScenario(path, &aparams, &error));
+  EXPECT_EQ(error, std::string(path) +
+            ":3: expected at least one recharge_station");
+
+  WriteFile(path, "wall 1 2\n");
+  EXPECT_FALSE(csci3081::LoadScenario(path, &aparams, &error));
+  EXPECT_EQ(error, std::string(path) + ":1: unknown entity");
+  EXPECT_EQ(aparams.obstacles.size(), 5u);
+}
+
+// Counts in a compiled header that the file cannot hold, even ones that
+// would wrap their sum around, are reported rather than reserved.
+TEST(Scenario, CorruptCompiledCounts) {
+  csci3081::arena_params defaults;
+  csci3081::DefaultArenaParams(&defaults);
+  std::string error;
+  const char * binary = "/tmp/scenario_unittest_corrupt.scnb";
+  ASSERT_TRUE(csci3081::SaveScenarioBinary(binary, defaults, &error)) << error;
+
+  const uint64_t bad[] = {UINT64_MAX, UINT64_MAX - 5, 1000};
+  for (uint64_t n_obstacles : bad) {
+    FILE * f = fopen(binary, "r+b");
+    ASSERT_TRUE(f != nullptr);
+    csci3081::scenario_header hdr;
+    ASSERT_EQ(fread(&hdr, sizeof(hdr), 1, f), 1u);
+    hdr.n_obstacles = n_obstacles;
+    rewind(f);
+    ASSERT_EQ(fwrite(&hdr, sizeof(hdr), 1, f), 1u);
+    fclose(f);
+
+    csci3081::arena_params loaded;
+    EXPECT_FALSE(csci3081::LoadScenario(binary, &loaded, &error));
+    EXPECT_NE(error.find("truncated or corrupt"), std::string::npos)
+        << error;
+  }
+}
+
+// Both formats refuse an empty arena and a negative or NaN radius.
+TEST(Scenario, FormatsRejectAlike) {
+  const char * text = "/tmp/scenario_unittest_invalid.scn";
+  csci3081::arena_params aparams;
+  std::string error;
+  const char * bad_text[] = {
+    "arena 0 100\n",
+    "arena 100 100\nobstacle 1 2 -3 255 255 255 255\n",
+    "arena 100 100\nobstacle 1 2 nan 255 255 255 255\n",
+  };
+  for (const char * contents : bad_text) {
+    WriteFile(text, contents);
+    EXPECT_FALSE(csci3081::LoadScenario(text, &aparams, &error)) << contents;
+    EXPECT_NE(error.find("malformed fields"), std::string::npos) << error;
+  }
+
+  csci3081::arena_params defaults;
+  csci3081::DefaultArenaParams(&defaults);
+  const char * binary = "/tmp/scenario_unittest_invalid.scnb";
+  for (int damage = 0; damage < 3; ++damage) {
+    ASSERT_TRUE(csci3081::SaveScenarioBinary(binary, defaults, &error));
+    FILE * f = fopen(binary, "r+b");
+    ASSERT_TRUE(f != nullptr);
+    csci3081::scenario_header hdr;
+    csci3081::scenario_record rec;
+    ASSERT_EQ(fread(&hdr, sizeof(hdr), 1, f), 1u);
+    ASSERT_EQ(fread(&rec, sizeof(rec), 1, f), 1u);
+    if (damage == 0) {
+      hdr.y_dim = 0;
+    } else {
+      rec.radius = damage == 1 ? -3 : std::nan("");
+    }
+    rewind(f);
+    ASSERT_EQ(fwrite(&hdr, sizeof(hdr), 1, f), 1u);
+    ASSERT_EQ(fwrite(&rec, sizeof(rec), 1, f), 1u);
+    fclose(f);
+    EXPECT_FALSE(csci3081::LoadScenario(binary, &aparams, &error))
+        << "damage " << damage;
+    EXPECT_NE(error.find(damage ? "invalid entity" : "invalid arena size"),
+              std::string::npos) << error;
+  }
+}
@@ -0,0 +1,122 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include "../src/arena.h"
+#include "../src/arena_defaults.h"
+#include "../src/arena_params.h"
+#include "../src/ray_cast.h"
+#include "../src/sensor_lidar.h"
+#include "../src/static_map.h"
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+TEST(RayCast, CirclesAndBox) {
+  double dx[4] = {1, 0, -1, 0};
+  double dy[4] = {0, 1, 0, -1};
+  double t[4];
+  for (int i = 0; i < 4; ++i) {
+    t[i] = std::numeric_limits<double>::infinity();
+  }
+  csci3081::circle_batch circles;
+  circles.Push(30, 10, 5);   // straight ahead along +x
+  circles.Push(10, 40, 10);  // along +y
+  circles.Push(10, -40, 10);
+  circles.Push(-20, 30, 3);  // off every ray
+  csci3081::CastRaysAtCircles(10, 10, dx, dy, 4, circles, t);
+  EXPECT_DOUBLE_EQ(t[0], 15);
+  EXPECT_DOUBLE_EQ(t[1], 20);
+  EXPECT_TRUE(std::isinf(t[2]));
+  EXPECT_DOUBLE_EQ(t[3], 40);
+
+  csci3081::CastRaysAtBox(10, 10, dx, dy, 4, 100, 25, t);
+  EXPECT_DOUBLE_EQ(t[0], 15);
+  EXPECT_DOUBLE_EQ(t[1], 15);
+  EXPECT_DOUBLE_EQ(t[2], 10);
+  EXPECT_DOUBLE_EQ(t[3], 10);
+
+  // From inside a circle every ray reads 0
+  circles.Push(10, 10, 1);
+  csci3081::CastRaysAtCircles(10, 10, dx, dy, 4, circles, t);
+  EXPECT_EQ(t[0] + t[1] + t[2] + t[3], 0);
+}
+
+// Rays cast together, two at a time where they can be, read exactly what
+// each reads cast alone; an odd count leaves one to the loop.
+TEST(RayCast, TogetherMatchesAlone) {
+  const size_t n = 7;
+  double dx[n], dy[n], together[n];
+  csci3081::circle_batch circles;
+  for (size_t i = 0; i < n; ++i) {
+    double angle = 0.3 + 0.9 * i;
+    dx[i] = std::cos(angle);
+    dy[i] = std::sin(angle);
+    together[i] = 200;
+    circles.Push(50 + 40 * std::cos(1.7 * i), 50 + 40 * std::sin(1.1 * i),
+                 3 + i);
+  }
+  csci3081::CastRaysAtCircles(50, 50, dx, dy, n, circles, together);
+  bool hit = false;
+  for (size_t i = 0; i < n; ++i) {
+    double alone = 200;
+    csci3081::CastRaysAtCircles(50, 50, dx + i, dy + i, 1, circles, &alone);
+    EXPECT_EQ(together[i], alone) << i;
+    hit = hit || alone < 200;
+  }
+  EXPECT_TRUE(hit);
+}
+
+TEST(SensorLidar, Beams) {
+  csci3081::SensorLidar ring(4, 360, 50);
+  csci3081::SensorLidar cone(3, 90, 50);
+  csci3081::circle_batch none;
+  ring.Scan(Position(20, 20), csci3081::Vector2(1, 0), 1000, 1000, none);
+  cone.Scan(Position(20, 20), csci3081::Vector2(1, 0), 1000, 1000, none);
+  // Ahead, left (+y), behind, right; only the walls behind and right reach
+  EXPECT_DOUBLE_EQ(ring.readings()[0], 50);
+  EXPECT_NEAR(ring.readings()[1], 50, 1e-9);
+  EXPECT_NEAR(ring.readings()[2], 20, 1e-9);
+  EXPECT_NEAR(ring.readings()[3], 20, 1e-9);
+  EXPECT_TRUE(ring.activated());
+  // -45, 0 and +45 degrees: none reaches a wall within 50
+  EXPECT_NEAR(cone.readings()[0], 20 * std::sqrt(2.0), 1e-9);
+  EXPECT_DOUBLE_EQ(cone.readings()[1], 50);
+  EXPECT_DOUBLE_EQ(cone.readings()[2], 50);
+  cone.Reset();
+  EXPECT_FALSE(cone.activated());
+}
+
+// The arena reads obstacle entities and static map obstacles alike.
+TEST(SensorLidar, ArenaReadsObstacles) {
+  csci3081::arena_params entities;
+  csci3081::DefaultArenaParams(&entities);
+  entities.home_base.seed = 5;
+  csci3081::StaticMap map;
+  map.Build(entities.obstacles, entities.x_dim, entities.y_dim);
+  csci3081::arena_params mapped = entities;
+  mapped.obstacles.clear();
+  mapped.static_map = &map;
+
+  csci3081::Arena a(&entities);
+  csci3081::Arena b(&mapped);
+  csci3081::SensorLidar proto(64, 360, 400);
+  a.EnableLidar(a.robot()->id(), proto);
+  b.EnableLidar(b.robot()->id(), proto);
+  bool saw_something = false;
+  for (int step = 0; step < 200 && !a.getGameStatus(); ++step) {
+    a.AdvanceTime();
+    b.AdvanceTime();
+    const csci3081::SensorLidar& la = a.registry().lidar_pool().Get(
+        a.robot()->id());
+    const csci3081::SensorLidar& lb = b.registry().lidar_pool().Get(
+        b.robot()->id());
+    for (size_t i = 0; i < la.n_beams(); ++i) {
+      ASSERT_DOUBLE_EQ(la.readings()[i], lb.readings()[i]) << step;
+      saw_something = saw_something || la.readings()[i] < 400;
+    }
+  }
+  EXPECT_TRUE(saw_something);
+}
@@ -0,0 +1,111 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/arena.h"
+#include "../src/arena_defaults.h"
+#include "../src/arena_params.h"
+#include "../src/state_export.h"
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+static std::string ExportName(const char * test) {
+  return "/arena-test-" + std::to_string(getpid()) + "-" + test;
+}
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// A reader sees nothing until the first frame, then the newest frame, with
+// the arena's entities as they were when it was published.
+TEST(StateExport, PublishAndRead) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  csci3081::Arena arena(&aparams);
+  std::string name = ExportName("basic");
+  std::string error;
+  csci3081::StateExporter exporter;
+  ASSERT_TRUE(exporter.Open(name.c_str(), 4, 64, aparams.x_dim,
+                            aparams.y_dim, &error)) << error;
+  csci3081::StateReader reader;
+  ASSERT_TRUE(reader.Attach(name.c_str(), &error)) << error;
+  EXPECT_EQ(reader.header()->max_entities, 64u);
+
+  csci3081::state_frame frame;
+  EXPECT_FALSE(reader.ReadLatest(&frame));
+  for (uint64_t step = 0; step < 10; ++step) {
+    arena.AdvanceTime();
+    exporter.Publish(arena, step * 10);
+  }
+  ASSERT_TRUE(reader.ReadLatest(&frame));
+  EXPECT_EQ(frame.frame, 9u);
+  EXPECT_EQ(frame.step, 90u);
+  const csci3081::ComponentPool<csci3081::transform>& bodies =
+      arena.registry().transform_pool();
+  ASSERT_EQ(frame.entities.size(), bodies.size());
+  EXPECT_EQ(frame.n_total, bodies.size());
+  for (size_t i = 0; i < bodies.size(); ++i) {
+    EXPECT_EQ(frame.entities[i].id, bodies.owners()[i]);
+    EXPECT_EQ(frame.entities[i].x,
+              csci3081::RealToDouble(bodies.data()[i].pos.x));
+  }
+
+  // Detaching and attaching again, even after the exporter is gone, is fine
+  reader.Detach();
+  ASSERT_TRUE(reader.Attach(name.c_str(), &error));
+  exporter.Close();
+  EXPECT_TRUE(reader.ReadLatest(&frame));
+  EXPECT_FALSE(csci3081::StateReader().Attach(name.c_str(), &error));
+}
+
+// Readers racing a fast exporter only ever keep whole frames.
+TEST(StateExport, ReadersGetConsistentFrames) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  csci3081::Arena arena(&aparams);
+  std::string name = ExportName("race");
+  std::string error;
+  csci3081::StateExporter exporter;
+  ASSERT_TRUE(exporter.Open(name.c_str(), 2, 64, aparams.x_dim,
+                            aparams.y_dim, &error)) << error;
+
+  // Every entity of frame f is stamped with f, so a torn copy shows
+  const uint64_t n_frames = 20000;
+  std::atomic<bool> done(false);
+  auto read = [&](int * good) {
+    csci3081::StateReader reader;
+    std::string why;
+    ASSERT_TRUE(reader.Attach(name.c_str(), &why)) << why;
+    csci3081::state_frame frame;
+    while (!done.load()) {
+      if (!reader.ReadLatest(&frame)) {
+        continue;
+      }
+      for (const csci3081::state_entity& e : frame.entities) {
+        ASSERT_EQ(e.radius, static_cast<double>(frame.frame));
+      }
+      ++*good;
+    }
+  };
+  int good[2] = {0, 0};
+  std::thread a(read, &good[0]);
+  std::thread b(read, &good[1]);
+  csci3081::ComponentPool<csci3081::transform>& bodies =
+      arena.registry().transform_pool();
+  for (uint64_t f = 0; f < n_frames; ++f) {
+    for (size_t i = 0; i < bodies.size(); ++i) {
+      bodies.data()[i].radius = static_cast<double>(f);
+    }
+    exporter.Publish(arena, f);
+  }
+  done = true;
+  a.join();
+  b.join();
+  EXPECT_GT(good[0] + good[1], 0);
+}
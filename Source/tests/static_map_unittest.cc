@@ -0,0 +1,137 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <cmath>
+#include <set>
+#include <string>
+#include <vector>
+#include "../src/arena.h"
+#include "../src/arena_defaults.h"
+#include "../src/arena_generator.h"
+#include "../src/arena_params.h"
+#include "../src/static_map.h"
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// A saved map opens to the same obstacles, and a box query returns at least
+// every obstacle that overlaps the box.
+TEST(StaticMap, RoundTripAndQuery) {
+  csci3081::arena_generator_params gparams;
+  gparams.n_obstacles = 2000;
+  gparams.seed = 3;
+  csci3081::arena_params aparams;
+  size_t placed = 0;
+  ASSERT_TRUE(csci3081::GenerateArenaParams(&gparams, &aparams, &placed,
+                                            nullptr));
+
+  csci3081::StaticMap built;
+  built.Build(aparams.obstacles, aparams.x_dim, aparams.y_dim);
+  std::string error;
+  const char * path = "/tmp/static_map_unittest.map";
+  ASSERT_TRUE(built.Save(path, &error)) << error;
+  csci3081::StaticMap map;
+  ASSERT_TRUE(map.Open(path, &error)) << error;
+  ASSERT_EQ(map.size(), aparams.obstacles.size());
+  EXPECT_EQ(map.x_dim(), aparams.x_dim);
+  EXPECT_EQ(map.y_dim(), aparams.y_dim);
+
+  for (int q = 0; q < 20; ++q) {
+    double x0 = (q * 37) % aparams.x_dim;
+    double y0 = (q * 53) % aparams.y_dim;
+    double x1 = x0 + 10 + q * 3;
+    double y1 = y0 + 10 + q * 2;
+    std::set<std::pair<double, double> > found;
+    map.ForEachInBox(x0, y0, x1, y1, [&](const csci3081::static_obstacle& o) {
+        found.insert(std::make_pair(o.x, o.y)); });
+    for (const csci3081::arena_entity_params& o : aparams.obstacles) {
+      double x = csci3081::RealToDouble(o.pos.x);
+      double y = csci3081::RealToDouble(o.pos.y);
+      if (x + o.radius >= x0 && x - o.radius <= x1 &&
+          y + o.radius >= y0 && y - o.radius <= y1) {
+        EXPECT_EQ(found.count(std::make_pair(x, y)), 1u);
+      }
+    }
+  }
+}
+
+TEST(StaticMap, Errors) {
+  const char * path = "/tmp/static_map_unittest_bad.map";
+  FILE * f = fopen(path, "wb");
+  ASSERT_TRUE(f != nullptr);
+  char junk[128] = "not a map";
+  fwrite(junk, sizeof(junk), 1, f);
+  fclose(f);
+  csci3081::StaticMap map;
+  std::string error;
+  EXPECT_FALSE(map.Open(path, &error));
+  EXPECT_EQ(error, std::string(path) + ": not a static map");
+  EXPECT_FALSE(map.loaded());
+  EXPECT_FALSE(map.Open("/tmp/static_map_unittest_missing.map", &error));
+}
+
+// A map whose header or cell table has been tampered with is refused
+// rather than read out of bounds.
+TEST(StaticMap, CorruptTables) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  csci3081::StaticMap built;
+  built.Build(aparams.obstacles, aparams.x_dim, aparams.y_dim);
+  std::string error;
+  const char * path = "/tmp/static_map_unittest_corrupt.map";
+  ASSERT_TRUE(built.Save(path, &error)) << error;
+  FILE * f = fopen(path, "rb");
+  ASSERT_TRUE(f != nullptr);
+  fseek(f, 0, SEEK_END);
+  std::vector<char> good(ftell(f));
+  rewind(f);
+  ASSERT_EQ(fread(good.data(), good.size(), 1, f), 1u);
+  fclose(f);
+
+  for (int damage = 0; damage < 5; ++damage) {
+    std::vector<char> image = good;
+    csci3081::static_map_header * hdr =
+        reinterpret_cast<csci3081::static_map_header *>(image.data());
+    uint32_t * start = reinterpret_cast<uint32_t *>(
+        image.data() + hdr->cell_start_offset);
+    size_t n_cells = static_cast<size_t>(hdr->cols) * hdr->rows;
+    switch (damage) {
+      case 0: hdr->cell_size = 0; break;
+      case 1: hdr->cell_size = std::nan(""); break;
+      // Wraps obstacles_offset + n_obstacles * sizeof(static_obstacle)
+      case 2: hdr->n_obstacles = ~static_cast<uint64_t>(0) / 8; break;
+      case 3: start[n_cells / 2] = start[n_cells] + 1; break;
+      default: start[n_cells] = static_cast<uint32_t>(hdr->n_obstacles + 1);
+    }
+    f = fopen(path, "wb");
+    ASSERT_TRUE(f != nullptr);
+    fwrite(image.data(), image.size(), 1, f);
+    fclose(f);
+    csci3081::StaticMap map;
+    EXPECT_FALSE(map.Open(path, &error)) << "damage " << damage;
+    EXPECT_EQ(error, std::string(path) + ": truncated or corrupt map");
+  }
+}
+
+// The robot bounces off mapped obstacles just as off obstacle entities.
+TEST(StaticMap, ArenaCollides) {
+  csci3081::arena_params entities;
+  csci3081::DefaultArenaParams(&entities);
+  entities.home_base.seed = 5;
+  csci3081::StaticMap map;
+  map.Build(entities.obstacles, entities.x_dim, entities.y_dim);
+  csci3081::arena_params mapped = entities;
+  mapped.obstacles.clear();
+  mapped.static_map = &map;
+
+  csci3081::Arena a(&entities);
+  csci3081::Arena b(&mapped);
+  EXPECT_EQ(b.n_obstacles(), 0u);
+  for (int step = 0; step < 2000 && !a.getGameStatus(); ++step) {
+    a.AdvanceTime();
+    b.AdvanceTime();
+    ASSERT_EQ(a.robot()->get_pos(), b.robot()->get_pos()) << step;
+  }
+}
@@ -0,0 +1,79 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "../src/trace.h"
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+TEST(Tracer, DisabledRecordsNothing) {
+  csci3081::Tracer& t = csci3081::Tracer::Instance();
+  t.enabled(false);
+  t.Clear();
+  {
+    TRACE_SCOPE("Disabled", "test");
+  }
+  EXPECT_EQ(t.n_events(), 0u) << "FAIL: Span recorded while disabled";
+}
+
+TEST(Tracer, DumpChromeJson) {
+  csci3081::Tracer& t = csci3081::Tracer::Instance();
+  t.enabled(true);
+  t.Clear();
+  t.ThreadName("main");
+  {
+    TRACE_SCOPE("Outer", "test");
+    TRACE_SCOPE("Inner", "test");
+  }
+  std::thread worker([]() {
+      TRACE_SCOPE("Worker", "io");
+    });
+  worker.join();
+  t.enabled(false);
+  EXPECT_EQ(t.n_events(), 3u) << "FAIL: Missing spans";
+
+  std::string path = "/tmp/tracer_unittest.json";
+  ASSERT_TRUE(t.Dump(path));
+  std::ifstream in(path);
+  std::stringstream ss;
+  ss << in.rdbuf();
+  std::string json = ss.str();
+  EXPECT_NE(json.find("\"traceEvents\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"Outer\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"Worker\",\"cat\":\"io\""), std::string::npos);
+  EXPECT_NE(json.find("\"thread_name\""), std::string::npos);
+}
+
+// Quotes, backslashes and control characters in names are escaped, so the
+// file stays valid JSON.
+TEST(Tracer, DumpEscapesNames) {
+  csci3081::Tracer& t = csci3081::Tracer::Instance();
+  t.Clear();
+  t.ThreadName("sim \"1\"\\\n");
+  t.Record("say \"hi\"", "a\\b", 1, 2);
+  std::string path = "/tmp/tracer_unittest.json";
+  ASSERT_TRUE(t.Dump(path));
+  t.ThreadName("main");
+  std::ifstream in(path);
+  std::stringstream ss;
+  ss << in.rdbuf();
+  std::string json = ss.str();
+  EXPECT_NE(json.find("\"name\":\"sim \\\"1\\\"\\\\\\u000a\""),
+            std::string::npos) << json;
+  EXPECT_NE(json.find("\"name\":\"say \\\"hi\\\"\",\"cat\":\"a\\\\b\""),
+            std::string::npos) << json;
+}
+
+TEST(Tracer, RingBufferKeepsNewest) {
+  csci3081::Tracer& t = csci3081::Tracer::Instance();
+  t.Clear();
+  for (int i = 0; i < TRACE_BUFFER_CAPACITY + 10; ++i) {
+    t.Record("Span", "test", 1, 2);
+  }
+  EXPECT_EQ(t.n_events(), static_cast<size_t>(TRACE_BUFFER_CAPACITY));
+}
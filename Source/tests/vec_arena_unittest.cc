@@ -0,0 +1,167 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "../src/arena.h"
+#include "../src/arena_defaults.h"
+#include "../src/arena_params.h"
+#include "../src/vec_arena.h"
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Each environment steps exactly as a lone arena given the same commands,
+// however many threads share them.
+TEST(VecArena, MatchesLoneArena) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  // HomeBases that wander as the lone arenas' do, and not into the robot
+  // within the steps run
+  aparams.home_base.seed = 20;
+  csci3081::vec_arena_params vparams;
+  vparams.n_envs = 5;
+  vparams.commands_per_step = 2;
+  vparams.n_threads = 3;
+  csci3081::VecArena envs(&aparams, vparams);
+  std::vector<std::unique_ptr<csci3081::Arena> > lone;
+  csci3081::arena_params lone_params = aparams;
+  for (size_t i = 0; i < vparams.n_envs; ++i) {
+    lone_params.home_base.seed = aparams.home_base.seed + i;
+    lone.emplace_back(new csci3081::Arena(&lone_params));
+  }
+
+  const size_t n = vparams.n_envs;
+  std::vector<enum csci3081::event_commands> actions(n * 2);
+  std::vector<float> obs(n * csci3081::OBS_SIZE);
+  std::vector<float> rewards(n);
+  std::vector<uint8_t> dones(n);
+  for (int step = 0; step < 40; ++step) {
+    for (size_t i = 0; i < n * 2; ++i) {
+      actions[i] = static_cast<enum csci3081::event_commands>(
+          (step * 7 + i * 3) % (csci3081::COM_NONE + 1));
+    }
+    envs.Step(actions.data(), obs.data(), rewards.data(), dones.data());
+    for (size_t i = 0; i < n; ++i) {
+      ASSERT_EQ(dones[i], csci3081::DONE_NOT);
+      csci3081::Robot * robot = lone[i]->robot();
+      robot->EventCmd(actions[i * 2]);
+      robot->EventCmd(actions[i * 2 + 1]);
+      lone[i]->AdvanceTime();
+      const float * o = &obs[i * csci3081::OBS_SIZE];
+      EXPECT_FLOAT_EQ(o[csci3081::OBS_ROBOT_X],
+                      csci3081::RealToDouble(robot->get_pos().x) /
+                      aparams.x_dim);
+      EXPECT_FLOAT_EQ(o[csci3081::OBS_ROBOT_Y],
+                      csci3081::RealToDouble(robot->get_pos().y) /
+                      aparams.y_dim);
+      EXPECT_FLOAT_EQ(o[csci3081::OBS_BATTERY],
+                      csci3081::RealToDouble(robot->get_battery_level()) /
+                      aparams.robot.battery_max_charge);
+    }
+  }
+}
+
+// Environments built from one seed still have HomeBases of their own.
+TEST(VecArena, SeedsEachHomeBase) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  aparams.home_base.seed = 7;
+  csci3081::vec_arena_params vparams;
+  vparams.n_envs = 2;
+  csci3081::VecArena envs(&aparams, vparams);
+  for (int step = 0; step < 20; ++step) {
+    envs.env(0).AdvanceTime();
+    envs.env(1).AdvanceTime();
+  }
+  const Position& a = envs.env(0).home_base()->get_pos();
+  const Position& b = envs.env(1).home_base()->get_pos();
+  EXPECT_TRUE(a.x != b.x || a.y != b.y);
+}
+
+// An environment whose robot runs out of battery is done with a reward of
+// -1, and starts over within the same step.
+TEST(VecArena, ResetsFinishedEpisodes) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  aparams.robot.battery_max_charge = 2;
+  csci3081::vec_arena_params vparams;
+  vparams.n_envs = 4;
+  vparams.n_threads = 2;
+  csci3081::VecArena envs(&aparams, vparams);
+  const size_t n = vparams.n_envs;
+  std::vector<float> first(n * csci3081::OBS_SIZE);
+  envs.Observe(first.data());
+
+  std::vector<enum csci3081::event_commands> actions(n, csci3081::COM_NONE);
+  std::vector<float> obs(n * csci3081::OBS_SIZE);
+  std::vector<float> rewards(n);
+  std::vector<uint8_t> dones(n);
+  int game_overs = 0;
+  for (int step = 0; step < 60; ++step) {
+    envs.Step(actions.data(), obs.data(), rewards.data(), dones.data());
+    for (size_t i = 0; i < n; ++i) {
+      if (dones[i] == csci3081::DONE_NOT) {
+        EXPECT_LT(rewards[i], 0);
+        continue;
+      }
+      ASSERT_EQ(dones[i], csci3081::DONE_GAME_OVER);
+      EXPECT_EQ(rewards[i], -1);
+      ++game_overs;
+      for (size_t j = 0; j < csci3081::OBS_SIZE; ++j) {
+        EXPECT_EQ(obs[i * csci3081::OBS_SIZE + j],
+                  first[i * csci3081::OBS_SIZE + j]);
+      }
+    }
+  }
+  EXPECT_GT(game_overs, 4);
+}
+
+// Episodes that go on past the step limit are cut short there.
+TEST(VecArena, TimeLimit) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  csci3081::vec_arena_params vparams;
+  vparams.n_envs = 3;
+  vparams.max_episode_steps = 5;
+  csci3081::VecArena envs(&aparams, vparams);
+  std::vector<enum csci3081::event_commands> actions(3, csci3081::COM_NONE);
+  std::vector<float> obs(3 * csci3081::OBS_SIZE);
+  std::vector<float> rewards(3);
+  std::vector<uint8_t> dones(3);
+  for (int step = 0; step < 20; ++step) {
+    envs.Step(actions.data(), obs.data(), rewards.data(), dones.data());
+    for (size_t i = 0; i < 3; ++i) {
+      EXPECT_EQ(dones[i], step % 5 == 4 ? csci3081::DONE_TIME_LIMIT :
+                csci3081::DONE_NOT);
+    }
+  }
+}
+
+// Reaching the HomeBase is done with a reward of 1.
+TEST(VecArena, WinRewards) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  // Already touching the robot
+  aparams.home_base.pos = aparams.robot.pos;
+  aparams.home_base.pos.x = aparams.home_base.pos.x +
+      aparams.robot.radius + aparams.home_base.radius - 2;
+  aparams.home_base.seed = 1;
+  csci3081::vec_arena_params vparams;
+  vparams.n_envs = 2;
+  csci3081::VecArena envs(&aparams, vparams);
+  std::vector<enum csci3081::event_commands> actions(2, csci3081::COM_NONE);
+  std::vector<float> obs(2 * csci3081::OBS_SIZE);
+  std::vector<float> rewards(2);
+  std::vector<uint8_t> dones(2);
+  bool won = false;
+  for (int step = 0; step < 3 && !won; ++step) {
+    envs.Step(actions.data(), obs.data(), rewards.data(), dones.data());
+    if (dones[0] == csci3081::DONE_GAME_OVER) {
+      EXPECT_EQ(rewards[0], 1);
+      won = true;
+    }
+  }
+  EXPECT_TRUE(won);
+}
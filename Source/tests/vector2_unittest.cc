@@ -0,0 +1,55 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <cmath>
+#include "../src/vector2.h"
+#include "../src/robot_motion_handler.h"
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+TEST(Vector2, Reflect) {
+  csci3081::Vector2 d(1, -1);
+  csci3081::Vector2 r = d.Reflect(csci3081::Vector2(0, 1));
+  EXPECT_DOUBLE_EQ(r.x, 1);
+  EXPECT_DOUBLE_EQ(r.y, 1);
+}
+
+TEST(Heading, DegreesAtBoundary) {
+  csci3081::Heading h(100);
+  EXPECT_EQ(h.degrees(), 100) << "FAIL: Angle not kept exactly";
+  h.vector(csci3081::Vector2(0, -1));
+  EXPECT_NEAR(h.degrees(), 270, 1e-9) << "FAIL: Angle not wrapped to [0, 360)";
+}
+
+// Turning by the precomputed rotation matches the old degree arithmetic and
+// stays unit length over many turns.
+TEST(RobotMotionHandler, TurnsWithoutDrift) {
+  csci3081::RobotMotionHandler rmh;
+  rmh.heading_angle(0);
+  for (int i = 0; i < 3600; ++i) {
+    rmh.AcceptCommand(csci3081::COM_TURN_RIGHT);
+  }
+  EXPECT_NEAR(rmh.direction().LengthSquared(), 1.0, 1e-12);
+  EXPECT_NEAR(rmh.direction().x, 1.0, 1e-9);
+  rmh.AcceptCommand(csci3081::COM_TURN_RIGHT);
+  EXPECT_NEAR(rmh.heading_angle(), 10, 1e-6);
+}
+
+// An entity that is already moving away from the surface it touched keeps
+// its heading instead of being turned back into it.
+TEST(RobotMotionHandler, NoReflectWhenLeaving) {
+  csci3081::RobotMotionHandler rmh;
+  csci3081::SensorTouch st;
+  st.activated(true);
+  // Touching a wall on the right
+  st.contact_direction(csci3081::Vector2(1, 0));
+  rmh.heading_angle(180);
+  rmh.UpdateVelocity(st);
+  EXPECT_EQ(rmh.heading_angle(), 180);
+
+  rmh.heading_angle(45);
+  rmh.UpdateVelocity(st);
+  EXPECT_NEAR(rmh.heading_angle(), 135, 1e-9);
+}
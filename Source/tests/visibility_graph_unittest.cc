@@ -0,0 +1,124 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "../src/arena.h"
+#include "../src/arena_defaults.h"
+#include "../src/arena_generator.h"
+#include "../src/arena_params.h"
+#include "../src/visibility_graph.h"
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+static double PathLength(const Position& start,
+                         const std::vector<Position>& path) {
+  double length = 0;
+  Position from = start;
+  for (const Position& to : path) {
+    length += std::hypot(csci3081::RealToDouble(to.x - from.x),
+                         csci3081::RealToDouble(to.y - from.y));
+    from = to;
+  }
+  return length;
+}
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// The path goes around an obstacle in the way, keeping the clearance.
+TEST(VisibilityGraph, AroundObstacle) {
+  csci3081::circle_batch obstacles;
+  obstacles.Push(100, 100, 20);
+  csci3081::visibility_graph_params vparams;
+  vparams.clearance = 5;
+  csci3081::VisibilityGraph graph;
+  graph.Build(obstacles, 200, 200, vparams);
+  EXPECT_EQ(graph.n_nodes(), 8u);
+
+  csci3081::path_query query;
+  std::vector<Position> path;
+  Position start(20, 100);
+  Position goal(180, 100);
+  ASSERT_TRUE(graph.FindPath(start, goal, &query, &path));
+  ASSERT_GE(path.size(), 2u);
+  EXPECT_EQ(path.back(), goal);
+  double length = PathLength(start, path);
+  EXPECT_GT(length, 160);
+  EXPECT_LT(length, 160 + 2 * 25);
+  Position from = start;
+  for (const Position& to : path) {
+    EXPECT_TRUE(graph.Visible(csci3081::RealToDouble(from.x),
+                              csci3081::RealToDouble(from.y),
+                              csci3081::RealToDouble(to.x),
+                              csci3081::RealToDouble(to.y)));
+    from = to;
+  }
+
+  // In plain sight, the path is the goal itself
+  ASSERT_TRUE(graph.FindPath(Position(20, 20), Position(180, 20), &query,
+                             &path));
+  EXPECT_EQ(path.size(), 1u);
+}
+
+// A goal walled in by obstacles cannot be reached, and large maps with a
+// limited edge length still find paths across.
+TEST(VisibilityGraph, UnreachableAndLarge) {
+  csci3081::circle_batch ring;
+  for (int k = 0; k < 12; ++k) {
+    double a = 2 * M_PI * k / 12;
+    ring.Push(100 + 40 * std::cos(a), 100 + 40 * std::sin(a), 12);
+  }
+  csci3081::VisibilityGraph graph;
+  graph.Build(ring, 200, 200, csci3081::visibility_graph_params());
+  csci3081::path_query query;
+  std::vector<Position> path;
+  EXPECT_FALSE(graph.FindPath(Position(10, 10), Position(100, 100), &query,
+                              &path));
+
+  csci3081::arena_generator_params gparams;
+  gparams.n_obstacles = 2000;
+  csci3081::arena_params aparams;
+  size_t placed = 0;
+  ASSERT_TRUE(csci3081::GenerateArenaParams(&gparams, &aparams, &placed,
+                                            nullptr));
+  csci3081::circle_batch obstacles;
+  for (const csci3081::arena_entity_params& o : aparams.obstacles) {
+    obstacles.Push(csci3081::RealToDouble(o.pos.x),
+                   csci3081::RealToDouble(o.pos.y), o.radius);
+  }
+  csci3081::visibility_graph_params vparams;
+  // As the Arena would for the default robot, with edges reaching past the
+  // generator's spacing
+  vparams.clearance = 23;
+  vparams.max_edge = 150;
+  graph.Build(obstacles, aparams.x_dim, aparams.y_dim, vparams);
+  Position start = aparams.robot.pos;
+  Position goal = aparams.home_base.pos;
+  ASSERT_TRUE(graph.FindPath(start, goal, &query, &path));
+  EXPECT_GE(PathLength(start, path),
+            std::hypot(csci3081::RealToDouble(goal.x - start.x),
+                       csci3081::RealToDouble(goal.y - start.y)));
+}
+
+// On autopilot the robot reaches the HomeBase and wins.
+TEST(VisibilityGraph, AutopilotWins) {
+  csci3081::arena_params aparams;
+  csci3081::DefaultArenaParams(&aparams);
+  aparams.home_base.seed = 5;
+  csci3081::Arena arena(&aparams);
+  arena.EnableAutopilot(arena.robot()->id(), csci3081::AUTOPILOT_HOME_BASE);
+  bool won = false;
+  arena.event_bus().game_overs().Subscribe(
+      [&won](const csci3081::game_over_record * e, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+          won = won || e[i].event.won();
+        }
+      });
+  for (int step = 0; step < 2000 && !arena.getGameStatus(); ++step) {
+    arena.AdvanceTime();
+  }
+  EXPECT_TRUE(won);
+}
@@ -0,0 +1,67 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include "../src/worker_pool.h"
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Run() calls the job once on every thread, the caller's as thread 0, and
+// the same threads serve job after job.
+TEST(WorkerPool, RunsOnEveryThread) {
+  csci3081::WorkerPool pool(3);
+  ASSERT_EQ(pool.n_threads(), 3u);
+  std::vector<int> calls(3, 0);
+  std::thread::id caller;
+  for (int round = 0; round < 100; ++round) {
+    pool.Run([&](size_t t) {
+        ++calls[t];
+        if (t == 0) {
+          caller = std::this_thread::get_id();
+        }
+      });
+  }
+  EXPECT_EQ(calls, std::vector<int>(3, 100));
+  EXPECT_EQ(caller, std::this_thread::get_id());
+
+  // Start() leaves the caller free until Wait()
+  std::atomic<int> started(0);
+  auto job = [&started](size_t t) { started += static_cast<int>(t); };
+  pool.Start(job);
+  pool.Wait();
+  EXPECT_EQ(started.load(), 1 + 2);
+}
+
+// Every index is covered exactly once, with or without a pool, and short
+// ranges are not split.
+TEST(WorkerPool, ForRanges) {
+  csci3081::WorkerPool pool(4);
+  for (size_t n : {0u, 1u, 7u, 1000u}) {
+    std::vector<int> seen(n, 0);
+    std::atomic<int> ranges(0);
+    std::vector<int> threads(pool.n_threads(), 0);
+    csci3081::ForRanges(&pool, n, 100, [&](size_t t, size_t begin,
+                                           size_t end) {
+        ++ranges;
+        ++threads[t];
+        for (size_t i = begin; i < end; ++i) {
+          ++seen[i];
+        }
+      });
+    EXPECT_EQ(seen, std::vector<int>(n, 1)) << n;
+    EXPECT_EQ(ranges.load(), n >= 200 ? 4 : 1) << n;
+    EXPECT_LE(*std::max_element(threads.begin(), threads.end()), 1) << n;
+  }
+  std::vector<int> seen(10, 0);
+  csci3081::ForRanges(nullptr, 10, 1, [&](size_t, size_t begin,
+                                          size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        ++seen[i];
+      }
+    });
+  EXPECT_EQ(seen, std::vector<int>(10, 1));
+}